@@ -35,9 +35,15 @@ void board_init(void)
 }
 
 #ifdef MODULE_MTD
+#ifdef MODULE_MTD_NATIVE_MMAP
+#define MTD_NATIVE_DRIVER   (&native_flash_mmap_driver)
+#else
+#define MTD_NATIVE_DRIVER   (&native_flash_driver)
+#endif
+
 static mtd_native_dev_t mtd0_dev = {
     .dev = {
-        .driver = &native_flash_driver,
+        .driver = MTD_NATIVE_DRIVER,
         .sector_count = MTD_SECTOR_NUM,
         .pages_per_sector = MTD_SECTOR_SIZE / MTD_PAGE_SIZE,
         .page_size = MTD_PAGE_SIZE,
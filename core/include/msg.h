@@ -232,6 +232,25 @@ int msg_send(msg_t *m, kernel_pid_t target_pid);
 int msg_try_send(msg_t *m, kernel_pid_t target_pid);
 
 
+/**
+ * @brief Send multiple messages to a thread at once (non-blocking).
+ *
+ * All messages are delivered with interrupts disabled only once and with a
+ * single scheduling decision. If the receiver is waiting, it gets the first
+ * message directly, the others are appended to its message queue, as long as
+ * there is space. Messages that don't fit are not sent. The order of the
+ * messages is preserved. May be called from an ISR.
+ *
+ * @param[in] arr           Array of messages to send, must not be NULL.
+ *                          msg_t::sender_pid of each sent message is set.
+ * @param[in] num           Number of messages in @p arr.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  Number of sent messages, these are the first ones of @p arr.
+ * @return  -1, on error (invalid PID)
+ */
+int msg_try_send_bulk(msg_t *arr, unsigned num, kernel_pid_t target_pid);
+
 /**
  * @brief Send a message to the current thread.
  * @details Will work only if the thread has a message queue.
@@ -296,6 +315,22 @@ static inline int msg_sent_by_int(const msg_t *m)
  */
 int msg_receive(msg_t *m);
 
+/**
+ * @brief Receive multiple messages at once.
+ *
+ * Blocks until at least one message was received. Then takes as many
+ * further messages as available (queued or from blocked senders), up to
+ * @p max, with interrupts disabled only once and with a single scheduling
+ * decision for all woken senders.
+ *
+ * @param[out] arr  Pointer to preallocated array of @p max ``msg_t``
+ *                  structures, must not be NULL.
+ * @param[in] max   Maximum number of messages to receive, must be > 0.
+ *
+ * @return  Number of received messages, always > 0.
+ */
+int msg_receive_bulk(msg_t *arr, unsigned max);
+
 /**
  * @brief Try to receive a message.
  *
@@ -11,6 +11,31 @@
  * @defgroup    core_sync_mutex Mutex
  * @ingroup     core_sync
  * @brief       Mutex for thread synchronization
+ *
+ * Locking an unlocked mutex and unlocking a mutex nobody waits for only
+ * take an atomic compare-and-swap on platforms that have one. Interrupts are
+ * only disabled if the mutex is contended.
+ *
+ * Priority inheritance
+ * ====================
+ *
+ * With the pseudomodule `core_mutex_priority_inheritance` a thread that
+ * blocks on a mutex raises the priority of the thread holding it to its own,
+ * if that is higher. When the holder unlocks the mutex, it gets back the
+ * priority it had before a waiter of this mutex raised it. This prevents a medium priority
+ * thread from delaying a high priority thread indefinitely by preempting a
+ * low priority thread holding a mutex the high priority thread waits for.
+ *
+ * With priority inheritance, only locking has a compare-and-swap fast path.
+ * Unlocking has to clear the owner together with the lock word, so it always
+ * disables interrupts.
+ *
+ * The inheritance is not transitive: if the holder itself waits for another
+ * mutex, the holder of that mutex is not raised. Nested mutexes must be
+ * unlocked in reverse order of locking. A mutex locked with
+ * @ref MUTEX_INIT_LOCKED or locked in one thread and unlocked in another
+ * has no owner to raise until a thread locked it.
+ *
  * @{
  *
  * @file
@@ -25,6 +50,9 @@
 #include <stddef.h>
 
 #include "list.h"
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#include "kernel_types.h"
+#endif
 
 #ifdef __cplusplus
  extern "C" {
@@ -40,18 +68,40 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(DOXYGEN) || defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE)
+    /**
+     * @brief   The thread holding the mutex, KERNEL_PID_UNDEF if unknown.
+     *          **Must never be changed by the user.**
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Priority of the owner before a waiter raised it, UINT8_MAX
+     *          if none did. **Must never be changed by the user.**
+     * @internal
+     */
+    uint8_t owner_original_priority;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, 0 }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, 0 }
+#else
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -72,6 +122,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
@@ -156,6 +156,37 @@ int ringbuffer_peek_one(const ringbuffer_t *__restrict rb);
  */
 unsigned ringbuffer_peek(const ringbuffer_t *__restrict rb, char *buf, unsigned n);
 
+/**
+ * @brief           Get the oldest elements of the ringbuffer without copying them.
+ * @details         As the elements may wrap around the end of the buffer, only the
+ *                  part up to the end is returned. Remove the elements that were
+ *                  processed with ringbuffer_remove() and call again for the rest.
+ * @param[in]       rb    Ringbuffer to operate on.
+ * @param[out]      data  Start of the oldest elements in the buffer.
+ * @returns         Number of elements that can be read contiguously from @p data.
+ */
+unsigned ringbuffer_get_contig(const ringbuffer_t *__restrict rb, char **data);
+
+/**
+ * @brief           Get free space in the ringbuffer to write elements to directly.
+ * @details         Only the free space up to the end of the buffer is returned.
+ *                  Make the written elements available with ringbuffer_add_commit()
+ *                  and call again for the rest.
+ * @param[in]       rb    Ringbuffer to operate on.
+ * @param[out]      data  Start of the free space in the buffer.
+ * @returns         Number of elements that can be written contiguously to @p data.
+ */
+unsigned ringbuffer_add_contig(const ringbuffer_t *__restrict rb, char **data);
+
+/**
+ * @brief           Add elements written to the space returned by ringbuffer_add_contig().
+ * @pre             @p n is not larger than the value returned by the last call to
+ *                  ringbuffer_add_contig().
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[in]       n     Number of elements written.
+ */
+void ringbuffer_add_commit(ringbuffer_t *__restrict rb, unsigned n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -162,6 +162,21 @@ void sched_set_status(thread_t *process, thread_status_t status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief   Change the priority of a thread
+ *
+ * Moves the thread to the runqueue of its new priority if it is runnable
+ * and yields if another thread should run now. Used e.g. by mutexes with
+ * priority inheritance. May be called from ISRs.
+ *
+ * @note    A thread waiting in a priority sorted list, e.g. for a mutex or
+ *          a message, keeps its position in that list.
+ *
+ * @param[in]   thread      thread to change the priority of
+ * @param[in]   priority    new priority, less than SCHED_PRIO_LEVELS
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief   Call context switching at thread exit
  */
@@ -210,6 +225,14 @@ NORETURN void sched_task_exit(void);
  *  @param[in] callback The callback functions the will be called
  */
 void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t));
+
+/**
+ *  @brief  Register a callback that will be called whenever a thread is put
+ *          on a runqueue
+ *
+ *  @param[in] callback The callback function, gets the pid of the thread
+ */
+void sched_register_ready_cb(void (*callback)(kernel_pid_t));
 #endif /* MODULE_SCHED_CB */
 
 #ifdef __cplusplus
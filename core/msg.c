@@ -171,6 +171,68 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
     return 1;
 }
 
+int msg_try_send_bulk(msg_t *arr, unsigned num, kernel_pid_t target_pid)
+{
+#ifdef DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_try_send_bulk(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    int in_isr = irq_is_in();
+    kernel_pid_t sender_pid = in_isr ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+    unsigned n = 0;
+    int woken = 0;
+
+    if (target == NULL) {
+        DEBUG("msg_try_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    /* a waiting receiver takes the first message directly */
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        arr[0].sender_pid = sender_pid;
+        *((msg_t *) target->wait_data) = arr[0];
+        sched_set_status(target, STATUS_PENDING);
+        woken = 1;
+        n++;
+    }
+
+    /* the rest is queued, as far as there is space */
+    for (; n < num; n++) {
+        int idx = cib_put(&(target->msg_queue));
+        if (idx < 0) {
+            DEBUG("msg_try_send_bulk(): message queue is full (or there is none)\n");
+            break;
+        }
+        arr[n].sender_pid = sender_pid;
+        target->msg_array[idx] = arr[n];
+    }
+
+#if MODULE_CORE_THREAD_FLAGS
+    if ((n > 0) && !woken) {
+        target->flags |= THREAD_FLAG_MSG_WAITING;
+        thread_flags_wake(target);
+    }
+#endif
+
+    irq_restore(state);
+
+    /* one scheduling decision for all messages */
+    if (woken) {
+        if (in_isr) {
+            sched_context_switch_request = 1;
+        }
+        else {
+            thread_yield_higher();
+        }
+    }
+    return n;
+}
+
 int msg_send_to_self(msg_t *m)
 {
     unsigned state = irq_disable();
@@ -373,6 +435,68 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+int msg_receive_bulk(msg_t *arr, unsigned max)
+{
+    assert(max > 0);
+
+    /* the first message is received as usual, this may block */
+    _msg_receive(&arr[0], 1);
+
+    unsigned n = 1;
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t*) sched_active_thread;
+    int has_queue = thread_has_msg_queue(me);
+
+    while (n < max) {
+        list_node_t *next;
+        int queue_index = has_queue ? cib_get(&(me->msg_queue)) : -1;
+
+        if (queue_index >= 0) {
+            arr[n++] = me->msg_array[queue_index];
+            continue;
+        }
+        /* queue is empty, blocked senders are next in order */
+        if ((next = list_remove_head(&me->msg_waiters)) == NULL) {
+            break;
+        }
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+        arr[n++] = *((msg_t*) sender->wait_data);
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < sender_prio) {
+                sender_prio = sender->priority;
+            }
+        }
+    }
+
+    /* refill the freed queue space from blocked senders, so they keep their
+     * order in front of later senders */
+    while (has_queue && me->msg_waiters.next) {
+        int queue_index = cib_put(&(me->msg_queue));
+        if (queue_index < 0) {
+            break;
+        }
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+        me->msg_array[queue_index] = *((msg_t*) sender->wait_data);
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < sender_prio) {
+                sender_prio = sender->priority;
+            }
+        }
+    }
+
+    irq_restore(state);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return n;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
@@ -32,8 +32,113 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* Only use the compare-and-swap fast path where it is a real instruction,
+ * elsewhere the library emulates it by disabling interrupts anyway */
+#if defined(__GCC_ATOMIC_POINTER_LOCK_FREE) && (__GCC_ATOMIC_POINTER_LOCK_FREE == 2)
+#define MUTEX_FAST_PATH     (1)
+#else
+#define MUTEX_FAST_PATH     (0)
+#endif
+
+static inline int _cas(mutex_t *mutex, list_node_t *expected,
+                       list_node_t *desired)
+{
+#if MUTEX_FAST_PATH
+    return __atomic_compare_exchange_n(&mutex->queue.next, &expected, desired,
+                                       0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#else
+    (void)mutex;
+    (void)expected;
+    (void)desired;
+    return 0;
+#endif
+}
+
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+/* value of mutex_t::owner_original_priority while no waiter raised the owner */
+#define PRIO_NOT_RAISED     (UINT8_MAX)
+
+/* Only threads on this core race for the owner, so keeping the compiler
+ * from reordering the accesses to it is enough */
+static inline void _store_owner(mutex_t *mutex, kernel_pid_t pid)
+{
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    mutex->owner = pid;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+static void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    /* a contender preempting us may raise us as soon as the owner is set */
+    mutex->owner_original_priority = PRIO_NOT_RAISED;
+    _store_owner(mutex, thread->pid);
+}
+
+/* must be called with interrupts disabled */
+static void _inherit_priority(mutex_t *mutex, uint8_t priority)
+{
+    if (mutex->owner == KERNEL_PID_UNDEF) {
+        return;
+    }
+    thread_t *owner = (thread_t *)thread_get(mutex->owner);
+    if (owner && (owner->priority > priority)) {
+        if (mutex->owner_original_priority == PRIO_NOT_RAISED) {
+            mutex->owner_original_priority = owner->priority;
+        }
+        DEBUG("PID[%" PRIkernel_pid "]: raising owner %" PRIkernel_pid
+              " to prio %" PRIu8 "\n", sched_active_pid, owner->pid, priority);
+        sched_change_priority(owner, priority);
+    }
+}
+
+/* must be called with interrupts disabled, returns the owner to restore if
+ * a waiter raised it through this mutex */
+static thread_t *_release_owner(mutex_t *mutex, uint8_t *priority)
+{
+    thread_t *owner = NULL;
+    if ((mutex->owner != KERNEL_PID_UNDEF) &&
+        (mutex->owner_original_priority != PRIO_NOT_RAISED)) {
+        owner = (thread_t *)thread_get(mutex->owner);
+        *priority = mutex->owner_original_priority;
+    }
+    mutex->owner = KERNEL_PID_UNDEF;
+    return owner;
+}
+
+static void _restore_priority(thread_t *owner, uint8_t priority)
+{
+    if (owner && (owner->priority != priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: restoring %" PRIkernel_pid
+              " to prio %" PRIu8 "\n", sched_active_pid, owner->pid, priority);
+        sched_change_priority(owner, priority);
+    }
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
+    if (_cas(mutex, NULL, MUTEX_LOCKED)) {
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        thread_t *me = (thread_t*)sched_active_thread;
+        _set_owner(mutex, me);
+        /* threads that blocked before we set the owner couldn't raise us */
+        if (__atomic_load_n(&mutex->queue.next, __ATOMIC_SEQ_CST)
+            != MUTEX_LOCKED) {
+            unsigned irqstate = irq_disable();
+            list_node_t *first = mutex->queue.next;
+            if ((first != NULL) && (first != MUTEX_LOCKED)) {
+                thread_t *waiter = container_of((clist_node_t*)first,
+                                                thread_t, rq_entry);
+                _inherit_priority(mutex, waiter->priority);
+            }
+            irq_restore(irqstate);
+        }
+#endif
+        DEBUG("PID[%" PRIkernel_pid "]: mutex_wait fast path.\n",
+              sched_active_pid);
+        return 1;
+    }
+
     unsigned irqstate = irq_disable();
 
     DEBUG("PID[%" PRIkernel_pid "]: Mutex in use.\n", sched_active_pid);
@@ -41,6 +146,9 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        _set_owner(mutex, (thread_t*)sched_active_thread);
+#endif
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -50,6 +158,10 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         thread_t *me = (thread_t*)sched_active_thread;
         DEBUG("PID[%" PRIkernel_pid "]: Adding node to mutex queue: prio: %"
               PRIu32 "\n", sched_active_pid, (uint32_t)me->priority);
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        /* raise the owner while we are still running, so this can't yield */
+        _inherit_priority(mutex, me->priority);
+#endif
         sched_set_status(me, STATUS_MUTEX_BLOCKED);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = (list_node_t*)&me->rq_entry;
@@ -72,6 +184,14 @@ int _mutex_lock(mutex_t *mutex, int blocking)
 
 void mutex_unlock(mutex_t *mutex)
 {
+#ifndef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    /* with priority inheritance, the owner must be cleared together with the
+     * queue, or a thread starting to wait in between couldn't raise it */
+    if (_cas(mutex, MUTEX_LOCKED, NULL)) {
+        return;
+    }
+#endif
+
     unsigned irqstate = irq_disable();
 
     DEBUG("mutex_unlock(): queue.next: %p pid: %" PRIkernel_pid "\n",
@@ -83,10 +203,18 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    uint8_t owner_priority = 0;
+    thread_t *owner = _release_owner(mutex, &owner_priority);
+#endif
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        _restore_priority(owner, owner_priority);
+#endif
         return;
     }
 
@@ -101,9 +229,17 @@ void mutex_unlock(mutex_t *mutex)
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
     }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    /* the remaining waiters don't have a higher priority than the new owner,
+     * the queue is sorted */
+    _set_owner(mutex, process);
+#endif
 
     uint16_t process_priority = process->priority;
     irq_restore(irqstate);
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    _restore_priority(owner, owner_priority);
+#endif
     sched_switch(process_priority);
 }
 
@@ -113,7 +249,14 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
           "taking a nap\n", sched_active_pid, (void *)mutex->queue.next);
     unsigned irqstate = irq_disable();
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    uint8_t owner_priority = 0;
+    thread_t *owner = NULL;
+#endif
     if (mutex->queue.next) {
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        owner = _release_owner(mutex, &owner_priority);
+#endif
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -126,11 +269,17 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+            _set_owner(mutex, process);
+#endif
         }
     }
 
     DEBUG("PID[%" PRIkernel_pid "]: going to sleep.\n", sched_active_pid);
     sched_set_status((thread_t*)sched_active_thread, STATUS_SLEEPING);
     irq_restore(irqstate);
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    _restore_priority(owner, owner_priority);
+#endif
     thread_yield_higher();
 }
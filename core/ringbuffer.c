@@ -18,6 +18,7 @@
 
 #include "ringbuffer.h"
 
+#include <assert.h>
 #include <string.h>
 
 /**
@@ -52,16 +53,42 @@ static char get_head(ringbuffer_t *restrict rb)
     return result;
 }
 
+/**
+ * @brief           Get the position after the newest element.
+ * @param[in]       rb   Ringbuffer to operate on.
+ * @returns         The position the next element is written to.
+ */
+static unsigned get_tail(const ringbuffer_t *restrict rb)
+{
+    unsigned pos = rb->start + rb->avail;
+    if (pos >= rb->size) {
+        pos -= rb->size;
+    }
+    return pos;
+}
+
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
+    if (n > rb->size - rb->avail) {
+        n = rb->size - rb->avail;
+    }
+    if (n == 1) {
+        /* not worth a call to memcpy() */
+        add_tail(rb, *buf);
+    }
+    else if (n > 0) {
+        unsigned pos = get_tail(rb);
+        unsigned bytes_till_end = rb->size - pos;
+        if (bytes_till_end >= n) {
+            memcpy(rb->buf + pos, buf, n);
         }
-        add_tail(rb, buf[i]);
+        else {
+            memcpy(rb->buf + pos, buf, bytes_till_end);
+            memcpy(rb->buf, buf + bytes_till_end, n - bytes_till_end);
+        }
+        rb->avail += n;
     }
-    return i;
+    return n;
 }
 
 int ringbuffer_add_one(ringbuffer_t *restrict rb, char c)
@@ -121,7 +148,7 @@ unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
         rb->avail -= n;
 
         /* compensate underflow */
-        if (rb->start > rb->size) {
+        if (rb->start >= rb->size) {
             rb->start -= rb->size;
         }
     }
@@ -140,3 +167,25 @@ unsigned ringbuffer_peek(const ringbuffer_t *restrict rb_, char *buf, unsigned n
     ringbuffer_t rb = *rb_;
     return ringbuffer_get(&rb, buf, n);
 }
+
+unsigned ringbuffer_get_contig(const ringbuffer_t *restrict rb, char **data)
+{
+    unsigned bytes_till_end = rb->size - rb->start;
+    *data = rb->buf + rb->start;
+    return (rb->avail < bytes_till_end) ? rb->avail : bytes_till_end;
+}
+
+unsigned ringbuffer_add_contig(const ringbuffer_t *restrict rb, char **data)
+{
+    unsigned pos = get_tail(rb);
+    unsigned bytes_till_end = rb->size - pos;
+    unsigned space = rb->size - rb->avail;
+    *data = rb->buf + pos;
+    return (space < bytes_till_end) ? space : bytes_till_end;
+}
+
+void ringbuffer_add_commit(ringbuffer_t *restrict rb, unsigned n)
+{
+    assert(n <= ringbuffer_get_free(rb));
+    rb->avail += n;
+}
@@ -19,6 +19,7 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdint.h>
 
 #include "sched.h"
@@ -72,6 +73,7 @@ const uint8_t _tcb_name_offset = offsetof(thread_t, name);
 
 #ifdef MODULE_SCHED_CB
 static void (*sched_cb) (kernel_pid_t active_thread, kernel_pid_t next_thread) = NULL;
+static void (*sched_ready_cb) (kernel_pid_t pid) = NULL;
 #endif
 
 int __attribute__((used)) sched_run(void)
@@ -143,6 +145,11 @@ void sched_set_status(thread_t *process, thread_status_t status)
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHED_CB
+            if (sched_ready_cb) {
+                sched_ready_cb(process->pid);
+            }
+#endif
         }
     }
     else {
@@ -185,6 +192,58 @@ void sched_switch(uint16_t other_prio)
     }
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(priority < SCHED_PRIO_LEVELS);
+
+    unsigned irqstate = irq_disable();
+
+    if (thread->priority == priority) {
+        irq_restore(irqstate);
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid " %" PRIu8 " -> %"
+          PRIu8 "\n", thread->pid, thread->priority, priority);
+
+    int is_active = (thread == (thread_t *)sched_active_thread);
+    int lowered = (priority > thread->priority);
+    int on_runqueue = (thread->status >= STATUS_ON_RUNQUEUE);
+    if (on_runqueue) {
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+        /* the active thread has to stay at the head of its runqueue */
+        if (is_active) {
+            clist_lpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        else {
+            clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        runqueue_bitcache |= 1 << priority;
+    }
+    thread->priority = priority;
+
+    irq_restore(irqstate);
+
+    /* lowering the active thread or raising another runnable one may make
+     * a different thread the one to run */
+    if (is_active) {
+        if (lowered && on_runqueue) {
+            if (irq_is_in()) {
+                sched_context_switch_request = 1;
+            }
+            else {
+                thread_yield_higher();
+            }
+        }
+    }
+    else if (on_runqueue) {
+        sched_switch(priority);
+    }
+}
+
 NORETURN void sched_task_exit(void)
 {
     DEBUG("sched_task_exit: ending thread %" PRIkernel_pid "...\n", sched_active_thread->pid);
@@ -204,4 +263,9 @@ void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t))
 {
     sched_cb = callback;
 }
+
+void sched_register_ready_cb(void (*callback)(kernel_pid_t))
+{
+    sched_ready_cb = callback;
+}
 #endif
@@ -232,37 +232,47 @@ static void _isr(candev_t *candev)
     }
 
     DEBUG("candev_native _isr: CAN SIGIO interrupt received, sock = %i\n", dev->sock);
-    nbytes = real_read(dev->sock, &rcv_frame, sizeof(struct can_frame));
 
-    if (nbytes < 0) {   /* SIGIO signal was probably due to an error with the socket */
-        DEBUG("candev_native _isr: read: error during read\n");
-        return;
-    }
+    /* SIGIO is only raised when the socket becomes readable, so all frames
+     * which arrived meanwhile must be read now. The socket is non-blocking,
+     * so read() fails once it is empty. */
+    for (unsigned i = 0; i < CANDEV_LINUX_MAX_RX_PER_ISR; i++) {
+        nbytes = real_read(dev->sock, &rcv_frame, sizeof(struct can_frame));
 
-    if (nbytes < (int)sizeof(struct can_frame)) {
-        DEBUG("candev_native _isr: read: incomplete CAN frame\n");
-        return;
-    }
+        if (nbytes < 0) {   /* socket empty, or SIGIO was due to an error with the socket */
+            DEBUG("candev_native _isr: read: no more frames\n");
+            return;
+        }
 
-    if (rcv_frame.can_id & CAN_ERR_FLAG) {
-        DEBUG("candev_native _isr: error frame\n");
-        candev_event_t evt = _can_error_to_can_evt(rcv_frame);
-        if ((evt != CANDEV_EVENT_NOEVENT) && (dev->candev.event_callback)) {
-            dev->candev.event_callback(&dev->candev, evt, NULL);
+        if (nbytes < (int)sizeof(struct can_frame)) {
+            DEBUG("candev_native _isr: read: incomplete CAN frame\n");
+            continue;
         }
-        return;
-    }
 
-    if (rcv_frame.can_id & CAN_RTR_FLAG) {
-        DEBUG("candev_native _isr: rtr frame\n");
-        return;
+        if (rcv_frame.can_id & CAN_ERR_FLAG) {
+            DEBUG("candev_native _isr: error frame\n");
+            candev_event_t evt = _can_error_to_can_evt(rcv_frame);
+            if ((evt != CANDEV_EVENT_NOEVENT) && (dev->candev.event_callback)) {
+                dev->candev.event_callback(&dev->candev, evt, NULL);
+            }
+            continue;
+        }
+
+        if (rcv_frame.can_id & CAN_RTR_FLAG) {
+            DEBUG("candev_native _isr: rtr frame\n");
+            continue;
+        }
+
+        if (dev->candev.event_callback) {
+            DEBUG("candev_native _isr: calling event callback\n");
+            dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_INDICATION, &rcv_frame);
+        }
     }
 
+    /* frames left, come back after the other messages of the device thread */
     if (dev->candev.event_callback) {
-        DEBUG("candev_native _isr: calling event callback\n");
-        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_INDICATION, &rcv_frame);
+        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_ISR, NULL);
     }
-
 }
 
 static int _set_bittiming(candev_linux_t *dev, struct can_bittiming *bittiming)
@@ -24,19 +24,36 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
 #include "mtd.h"
 
 /** mtd native descriptor */
 typedef struct mtd_native_dev {
     mtd_dev_t dev;      /**< mtd generic device */
     const char *fname;  /**< filename to use for memory emulation */
+    uint8_t *mem;       /**< mapped image, only used by
+                             @ref native_flash_mmap_driver */
 } mtd_native_dev_t;
 
 /**
  * @brief Native mtd flash driver
+ *
+ * Opens the backing file on every access.
  */
 extern const mtd_desc_t native_flash_driver;
 
+/**
+ * @brief Native mtd flash driver using a memory-mapped backing file
+ *
+ * The backing file is mapped once on init, all accesses go to the mapping.
+ * Powering the device down with @ref MTD_POWER_DOWN syncs the mapping to the
+ * file, which also happens implicitly when the process exits.
+ *
+ * Selected for `mtd0` by the `mtd_native_mmap` pseudomodule.
+ */
+extern const mtd_desc_t native_flash_mmap_driver;
+
 #ifdef __cplusplus
 }
 #endif
@@ -73,6 +73,10 @@ extern void _native_sig_leave_handler(void);
 
 void _native_syscall_leave(void);
 void _native_syscall_enter(void);
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+void native_ctx_set_sigmask(ucontext_t *ctx);
+int native_isr_exit_sigpend(void);
+#endif
 void _native_init_syscalls(void);
 
 /**
@@ -131,6 +135,9 @@ extern int (*real_fclose)(FILE *stream);
 extern int (*real_fseek)(FILE *stream, long offset, int whence);
 extern int (*real_fputc)(int c, FILE *stream);
 extern int (*real_fgetc)(FILE *stream);
+extern long (*real_ftell)(FILE *stream);
+extern int (*real_fflush)(FILE *stream);
+extern int (*real_fileno)(FILE *stream);
 extern mode_t (*real_umask)(mode_t cmask);
 extern ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
 
@@ -27,6 +27,7 @@ extern "C" {
 #include <stdint.h>
 #include "net/netdev.h"
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef __MACH__
@@ -35,6 +36,17 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames read from the tap per device interrupt
+ *
+ * The driver reads frames until the tap has no more frames or this budget is
+ * used up. In the latter case the remaining frames are handled on the next
+ * interrupt which is raised right away.
+ */
+#ifndef NETDEV_TAP_RX_BUDGET
+#define NETDEV_TAP_RX_BUDGET            (16U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +56,10 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    uint16_t rx_len;                    /**< length of the frame in rx_buf,
+                                             0 if there is none */
+    uint8_t rx_buf[ETHERNET_FRAME_LEN]; /**< frame currently handed to the
+                                             upper layer */
 } netdev_tap_t;
 
 /**
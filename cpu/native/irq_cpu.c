@@ -38,6 +38,10 @@
 #include "cpu.h"
 #include "periph/pm.h"
 
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+#include "schedstatistics.h"
+#endif
+
 #include "native_internal.h"
 
 #define ENABLE_DEBUG (0)
@@ -143,6 +147,81 @@ void native_print_signals(void)
     }
 }
 
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+/**
+ * apply the set of enabled signals to the process
+ *
+ * With deferred masking the process signal mask only changes when an
+ * interrupt handler gets (un)registered.
+ */
+static void _native_apply_sig_set(void)
+{
+    native_isr_context.uc_sigmask = _native_sig_set;
+    if (sigprocmask(SIG_SETMASK, &_native_sig_set, NULL) == -1) {
+        err(EXIT_FAILURE, "_native_apply_sig_set: sigprocmask");
+    }
+}
+
+void native_ctx_set_sigmask(ucontext_t *ctx)
+{
+    ctx->uc_sigmask = _native_sig_set;
+}
+
+/**
+ * block signals for leaving the ISR, check for signals queued meanwhile
+ *
+ * The signals stay blocked until setcontext() installs the mask of the
+ * resumed context, so none can be queued after the check and wait for the
+ * next irq_enable().
+ */
+int native_isr_exit_sigpend(void)
+{
+    if (sigprocmask(SIG_SETMASK, &_native_sig_set_dint, NULL) == -1) {
+        err(EXIT_FAILURE, "native_isr_exit_sigpend: sigprocmask");
+    }
+
+    return _native_sigpend;
+}
+
+/**
+ * mask interrupts in user space: signals arriving now are queued by
+ * native_isr_entry() and replayed by irq_enable()
+ */
+unsigned irq_disable(void)
+{
+    unsigned int prev_state = native_interrupts_enabled;
+
+    native_interrupts_enabled = 0;
+    __asm__ volatile ("" : : : "memory");
+
+    return prev_state;
+}
+
+/**
+ * unmask interrupts, run handlers of signals queued in the meantime
+ */
+unsigned irq_enable(void)
+{
+    unsigned int prev_state;
+
+    if (_native_in_isr == 1) {
+#ifdef DEVELHELP
+        real_write(STDERR_FILENO, "irq_enable + _native_in_isr\n", 27);
+#else
+        DEBUG("irq_enable + _native_in_isr\n");
+#endif
+    }
+
+    __asm__ volatile ("" : : : "memory");
+    /* _native_syscall_leave() replays pending signals */
+    _native_syscall_enter();
+    prev_state = native_interrupts_enabled;
+    native_interrupts_enabled = 1;
+    _native_syscall_leave();
+
+    return prev_state;
+}
+#else /* MODULE_NATIVE_IRQ_DEFERRED */
 /**
  * block signals
  */
@@ -205,6 +284,7 @@ unsigned irq_enable(void)
 
     return prev_state;
 }
+#endif /* MODULE_NATIVE_IRQ_DEFERRED */
 
 void irq_restore(unsigned state)
 {
@@ -254,9 +334,13 @@ void native_irq_handler(void)
 {
     DEBUG("\n\n\t\tnative_irq_handler\n\n");
 
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+    schedstat_isr_enter();
+#endif
     while (_native_sigpend > 0) {
         int sig = _native_popsig();
-        _native_sigpend--;
+        /* signals may be queued concurrently, so decrement atomically */
+        __atomic_fetch_sub(&_native_sigpend, 1, __ATOMIC_SEQ_CST);
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
@@ -270,13 +354,22 @@ void native_irq_handler(void)
         }
     }
 
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+    schedstat_isr_exit();
+#endif
+
     DEBUG("native_irq_handler: return\n");
     cpu_switch_context_exit();
 }
 
 void isr_set_sigmask(ucontext_t *ctx)
 {
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+    /* signals stay unblocked, native_isr_entry() queues them while in ISR */
+    (void)ctx;
+#else
     ctx->uc_sigmask = _native_sig_set_dint;
+#endif
     native_interrupts_enabled = 0;
 }
 
@@ -380,6 +473,12 @@ void set_signal_handler(int sig, bool add)
         err(EXIT_FAILURE, "set_signal_handler: sigdelset");
     }
 
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+    _native_syscall_enter();
+    _native_apply_sig_set();
+    _native_syscall_leave();
+#endif
+
     memset(&sa, 0, sizeof(sa));
 
     /* Disable other signal during execution of the handler for this signal. */
@@ -541,6 +640,9 @@ void native_interrupt_init(void)
         err(EXIT_FAILURE, "native_interrupt_init: sigaction");
     }
 
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+    _native_apply_sig_set();
+#endif
 
     puts("RIOT native interrupts/signals initialized.");
 }
@@ -19,6 +19,8 @@
 #include <assert.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
 
 #include "mtd.h"
 #include "mtd_native.h"
@@ -149,4 +151,145 @@ const mtd_desc_t native_flash_driver = {
     .init = _init,
 };
 
+static int _init_mmap(mtd_dev_t *dev)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+
+    DEBUG("mtd_native: mmap init, filename=%s\n", _dev->fname);
+
+    if (_dev->mem) {
+        /* already mapped */
+        return 0;
+    }
+
+    FILE *f = real_fopen(_dev->fname, "r+");
+    if (!f) {
+        DEBUG("mtd_native: init: creating file %s\n", _dev->fname);
+        f = real_fopen(_dev->fname, "w+");
+        if (!f) {
+            return -EIO;
+        }
+    }
+
+    /* pad the image with erased bytes, mapping beyond EOF raises SIGBUS */
+    real_fseek(f, 0, SEEK_END);
+    for (long i = real_ftell(f); (i >= 0) && ((size_t)i < size); i++) {
+        real_fputc(0xff, f);
+    }
+    real_fflush(f);
+
+    void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     real_fileno(f), 0);
+    /* the mapping stays valid after the file is closed */
+    real_fclose(f);
+
+    if (mem == MAP_FAILED) {
+        DEBUG("mtd_native: init: mmap failed\n");
+        return -EIO;
+    }
+    _dev->mem = mem;
+
+    return 0;
+}
+
+static int _read_mmap(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+
+    DEBUG("mtd_native: read from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
+
+    if (addr + size > mtd_size) {
+        return -EOVERFLOW;
+    }
+
+    memcpy(buff, _dev->mem + addr, size);
+
+    return size;
+}
+
+static int _write_mmap(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                       uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+    const uint8_t *src = buff;
+    uint8_t *dst = _dev->mem + addr;
+
+    DEBUG("mtd_native: write from 0x%" PRIx32 " count %" PRIu32 "\n", addr, size);
+
+    if (addr + size > mtd_size) {
+        return -EOVERFLOW;
+    }
+    if (((addr % dev->page_size) + size) > dev->page_size) {
+        return -EOVERFLOW;
+    }
+
+    /* NOR flash can only clear bits, so AND the new data into the image:
+     * byte-wise up to the first word boundary, then word-wise */
+    uint32_t len = size;
+    while (len && ((uintptr_t)dst % sizeof(uintptr_t))) {
+        *dst++ &= *src++;
+        len--;
+    }
+    while (len >= sizeof(uintptr_t)) {
+        uintptr_t word;
+        memcpy(&word, src, sizeof(word));
+        *(uintptr_t *)dst &= word;
+        dst += sizeof(uintptr_t);
+        src += sizeof(uintptr_t);
+        len -= sizeof(uintptr_t);
+    }
+    while (len--) {
+        *dst++ &= *src++;
+    }
+
+    return size;
+}
+
+static int _erase_mmap(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+    size_t sector_size = dev->pages_per_sector * dev->page_size;
+
+    DEBUG("mtd_native: erase from sector %" PRIu32 " count %" PRIu32 "\n", addr, size);
+
+    if (addr + size > mtd_size) {
+        return -EOVERFLOW;
+    }
+    if (((addr % sector_size) != 0) || ((size % sector_size) != 0)) {
+        return -EOVERFLOW;
+    }
+
+    memset(_dev->mem + addr, 0xff, size);
+
+    return 0;
+}
+
+static int _power_mmap(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+
+    /* The kernel writes a shared mapping back to the file when the process
+     * exits, powering down only forces the write-back to happen now. */
+    if ((power == MTD_POWER_DOWN) && _dev->mem) {
+        if (msync(_dev->mem, mtd_size, MS_SYNC) < 0) {
+            return -EIO;
+        }
+    }
+
+    return 0;
+}
+
+const mtd_desc_t native_flash_mmap_driver = {
+    .read = _read_mmap,
+    .power = _power_mmap,
+    .write = _write_mmap,
+    .erase = _erase_mmap,
+    .init = _init_mmap,
+};
+
 /** @} */
@@ -137,6 +137,25 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_sta
     return (char *) p;
 }
 
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+/**
+ * run the handlers of signals queued while in ISR, on a fresh ISR stack
+ *
+ * native_isr_context unblocks the signals again.
+ */
+static void _native_isr_restart(void)
+{
+    native_isr_context.uc_stack.ss_sp = __isr_stack;
+    native_isr_context.uc_stack.ss_size = sizeof(__isr_stack);
+    native_isr_context.uc_stack.ss_flags = 0;
+    makecontext(&native_isr_context, native_irq_handler, 0);
+    if (setcontext(&native_isr_context) == -1) {
+        err(EXIT_FAILURE, "_native_isr_restart: setcontext");
+    }
+    errx(EXIT_FAILURE, "_native_isr_restart: this should have never been reached!!");
+}
+#endif
+
 void isr_cpu_switch_context_exit(void)
 {
     ucontext_t *ctx;
@@ -149,8 +168,17 @@ void isr_cpu_switch_context_exit(void)
     DEBUG("isr_cpu_switch_context_exit: calling setcontext(%" PRIkernel_pid ")\n\n", sched_active_pid);
     ctx = (ucontext_t *)(sched_active_thread->sp);
 
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+    if (native_isr_exit_sigpend() > 0) {
+        DEBUG("isr_cpu_switch_context_exit: handling signals queued in ISR\n");
+        _native_isr_restart();
+    }
+#endif
     native_interrupts_enabled = 1;
     _native_mod_ctx_leave_sigh(ctx);
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+    native_ctx_set_sigmask(ctx);
+#endif
 
     if (setcontext(ctx) == -1) {
         err(EXIT_FAILURE, "isr_cpu_switch_context_exit: setcontext");
@@ -198,8 +226,17 @@ void isr_thread_yield(void)
     ucontext_t *ctx = (ucontext_t *)(sched_active_thread->sp);
     DEBUG("isr_thread_yield: switching to(%" PRIkernel_pid ")\n\n", sched_active_pid);
 
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+    if (native_isr_exit_sigpend() > 0) {
+        DEBUG("isr_thread_yield: handling signals queued in ISR\n");
+        _native_isr_restart();
+    }
+#endif
     native_interrupts_enabled = 1;
     _native_mod_ctx_leave_sigh(ctx);
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+    native_ctx_set_sigmask(ctx);
+#endif
 
     if (setcontext(ctx) == -1) {
         err(EXIT_FAILURE, "isr_thread_yield: setcontext");
@@ -94,16 +94,60 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
-static inline void _isr(netdev_t *netdev)
+static void _continue_reading(netdev_tap_t *dev);
+
+static inline bool _is_addr_broadcast(const uint8_t *addr);
+static inline bool _is_addr_multicast(const uint8_t *addr);
+
+static bool _is_for_me(netdev_tap_t *dev, const uint8_t *frame)
 {
-    if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
-    }
+    const ethernet_hdr_t *hdr = (const ethernet_hdr_t *)frame;
+
+    return dev->promiscous || _is_addr_multicast(hdr->dst) ||
+           _is_addr_broadcast(hdr->dst) ||
+           (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) == 0);
+}
+
+static void _isr(netdev_t *netdev)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+
+    if (!netdev->event_callback) {
 #if DEVELHELP
-    else {
         puts("netdev_tap: _isr(): no event_callback set.");
-    }
 #endif
+        return;
+    }
+
+    /* Read all frames queued at the tap: each read returns exactly one
+     * frame and thus its true size, which the upper layer asks for before
+     * allocating its buffer. Once the tap is drained, the next frame raises
+     * a new SIGIO, so no select() is needed per frame. */
+    for (unsigned i = 0; i < NETDEV_TAP_RX_BUDGET; i++) {
+        ssize_t nread = real_read(dev->tap_fd, dev->rx_buf,
+                                  sizeof(dev->rx_buf));
+
+        if (nread <= 0) {
+            if ((nread < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                err(EXIT_FAILURE, "netdev_tap: read");
+            }
+            native_async_read_continue(dev->tap_fd);
+            return;
+        }
+        DEBUG("netdev_tap: read %d bytes\n", (int)nread);
+        if (((size_t)nread < sizeof(ethernet_hdr_t)) ||
+            !_is_for_me(dev, dev->rx_buf)) {
+            DEBUG("netdev_tap: frame not for me => dropped\n");
+            continue;
+        }
+        dev->rx_len = nread;
+        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        /* the frame is gone whether the upper layer took it or not */
+        dev->rx_len = 0;
+    }
+
+    /* budget used up, let others run before reading on */
+    _continue_reading(dev);
 }
 
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
@@ -165,13 +209,13 @@ static const netdev_driver_t netdev_driver_tap = {
 };
 
 /* driver implementation */
-static inline bool _is_addr_broadcast(uint8_t *addr)
+static inline bool _is_addr_broadcast(const uint8_t *addr)
 {
     return ((addr[0] == 0xff) && (addr[1] == 0xff) && (addr[2] == 0xff) &&
             (addr[3] == 0xff) && (addr[4] == 0xff) && (addr[5] == 0xff));
 }
 
-static inline bool _is_addr_multicast(uint8_t *addr)
+static inline bool _is_addr_multicast(const uint8_t *addr)
 {
     /* source: http://ieee802.org/secmail/pdfocSP2xXA6d.pdf */
     return (addr[0] & 0x01);
@@ -207,70 +251,31 @@ static void _continue_reading(netdev_tap_t *dev)
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    int size = dev->rx_len;
     (void)info;
 
+    if (size == 0) {
+        DEBUG("netdev_tap: no frame pending\n");
+        return -1;
+    }
+
     if (!buf) {
         if (len > 0) {
             /* no memory available in pktbuf, discarding the frame */
             DEBUG("netdev_tap: discarding the frame\n");
-
-            /* repeating `real_read` for small size on tap device results in
-             * freeze for some reason. Using a large buffer for now. */
-            /*
-            uint8_t buf[4];
-            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
-            }
-            */
-
-            static uint8_t nullbuf[ETHERNET_FRAME_LEN];
-
-            real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
-
-            _continue_reading(dev);
+            dev->rx_len = 0;
         }
-
-        /* no way of figuring out packet size without racey buffering,
-         * so we return the maximum possible size */
-        return ETHERNET_FRAME_LEN;
+        return size;
     }
 
-    int nread = real_read(dev->tap_fd, buf, len);
-    DEBUG("netdev_tap: read %d bytes\n", nread);
-
-    if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
-            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
-                  "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
-
-            native_async_read_continue(dev->tap_fd);
-
-            return 0;
-        }
-
-        _continue_reading(dev);
-
-        return nread;
-    }
-    else if (nread == -1) {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-        }
-        else {
-            err(EXIT_FAILURE, "netdev_tap: read");
-        }
-    }
-    else if (nread == 0) {
-        DEBUG("_native_handle_tap_input: ignoring null-event\n");
-    }
-    else {
-        errx(EXIT_FAILURE, "internal error _rx_event");
+    dev->rx_len = 0;
+    if (len < (size_t)size) {
+        DEBUG("netdev_tap: buffer too small, dropping the frame\n");
+        return -ENOBUFS;
     }
+    memcpy(buf, dev->rx_buf, size);
 
-    return -1;
+    return size;
 }
 
 static int _send(netdev_t *netdev, const iolist_t *iolist)
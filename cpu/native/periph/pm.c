@@ -18,6 +18,7 @@
  */
 
 #include <err.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -32,7 +33,26 @@
 void pm_set_lowest(void)
 {
     _native_in_syscall++; /* no switching here */
+#ifdef MODULE_NATIVE_IRQ_DEFERRED
+    sigset_t mask, old_mask;
+
+    /* signals queued while interrupts were masked in user space are only
+     * handled after the next one, unless the check of _native_sigpend and
+     * the wait are atomic: block all signals and let sigsuspend() unblock
+     * them with the wait */
+    sigfillset(&mask);
+    if (sigprocmask(SIG_BLOCK, &mask, &old_mask) == -1) {
+        err(EXIT_FAILURE, "pm_set_lowest: sigprocmask");
+    }
+    if (_native_sigpend == 0) {
+        sigsuspend(&old_mask);
+    }
+    if (sigprocmask(SIG_SETMASK, &old_mask, NULL) == -1) {
+        err(EXIT_FAILURE, "pm_set_lowest: sigprocmask");
+    }
+#else
     real_pause();
+#endif
     _native_in_syscall--;
 
     if (_native_sigpend > 0) {
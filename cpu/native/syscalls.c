@@ -96,6 +96,9 @@ int (*real_fclose)(FILE *stream);
 int (*real_fseek)(FILE *stream, long offset, int whence);
 int (*real_fputc)(int c, FILE *stream);
 int (*real_fgetc)(FILE *stream);
+long (*real_ftell)(FILE *stream);
+int (*real_fflush)(FILE *stream);
+int (*real_fileno)(FILE *stream);
 mode_t (*real_umask)(mode_t cmask);
 ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
 
@@ -488,6 +491,9 @@ void _native_init_syscalls(void)
     *(void **)(&real_fseek) = dlsym(RTLD_NEXT, "fseek");
     *(void **)(&real_fputc) = dlsym(RTLD_NEXT, "fputc");
     *(void **)(&real_fgetc) = dlsym(RTLD_NEXT, "fgetc");
+    *(void **)(&real_ftell) = dlsym(RTLD_NEXT, "ftell");
+    *(void **)(&real_fflush) = dlsym(RTLD_NEXT, "fflush");
+    *(void **)(&real_fileno) = dlsym(RTLD_NEXT, "fileno");
 #ifdef __MACH__
 #else
     *(void **)(&real_clock_gettime) = dlsym(RTLD_NEXT, "clock_gettime");
@@ -152,7 +152,7 @@ void auto_init(void)
     extern void openthread_bootstrap(void);
     openthread_bootstrap();
 #endif
-#ifdef MODULE_GCOAP
+#if defined(MODULE_GCOAP) && !defined(MODULE_GCOAP_EVENT)
     DEBUG("Auto init gcoap module.\n");
     gcoap_init();
 #endif
@@ -19,7 +19,9 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 
+#include "irq.h"
 #include "thread.h"
 #include "can/device.h"
 #include "can/common.h"
@@ -37,6 +39,21 @@
 #define CAN_DEVICE_MSG_QUEUE_SIZE 64
 #endif
 
+#ifndef CAN_DEVICE_RX_BATCH_SIZE
+#define CAN_DEVICE_RX_BATCH_SIZE 8
+#endif
+
+/**
+ * Frames received while the driver's isr() runs, dispatched all at once
+ */
+typedef struct {
+    can_pkt_t *pkts[CAN_DEVICE_RX_BATCH_SIZE];  /**< received packets */
+    unsigned num;                               /**< number of packets */
+    bool active;                                /**< isr() is running */
+} rx_batch_t;
+
+static rx_batch_t _rx_batch[CAN_DLL_NUMOF];
+
 #ifdef MODULE_CAN_PM
 #define CAN_DEVICE_PM_DEFAULT_RX_TIMEOUT (10 * US_PER_SEC)
 #define CAN_DEVICE_PM_DEFAULT_TX_TIMEOUT (2 * US_PER_SEC)
@@ -47,11 +64,48 @@ static void pm_reset(candev_dev_t *candev_dev, uint32_t value);
 static int power_up(candev_dev_t *candev_dev);
 static int power_down(candev_dev_t *candev_dev);
 
+static void _rx_batch_flush(rx_batch_t *batch)
+{
+    if (batch->num) {
+        DEBUG("can device: dispatching %u frames\n", batch->num);
+        can_dll_dispatch_rx_pkts(batch->pkts, batch->num);
+        batch->num = 0;
+    }
+}
+
+static rx_batch_t *_rx_batch_get(candev_dev_t *candev_dev)
+{
+    /* only the frames indicated by isr() in the device thread are batched,
+     * a driver may still indicate frames from interrupt context */
+    if ((candev_dev->ifnum < 0) || irq_is_in() ||
+        !_rx_batch[candev_dev->ifnum].active) {
+        return NULL;
+    }
+    return &_rx_batch[candev_dev->ifnum];
+}
+
+static void _isr(candev_dev_t *candev_dev)
+{
+    candev_t *dev = candev_dev->dev;
+    rx_batch_t *batch = NULL;
+
+    if (candev_dev->ifnum >= 0) {
+        batch = &_rx_batch[candev_dev->ifnum];
+        batch->active = true;
+    }
+    dev->driver->isr(dev);
+    if (batch) {
+        batch->active = false;
+        _rx_batch_flush(batch);
+    }
+}
+
 static void _can_event(candev_t *dev, candev_event_t event, void *arg)
 {
     msg_t msg;
     struct can_frame *frame;
     can_pkt_t *pkt;
+    rx_batch_t *batch;
     candev_dev_t *candev_dev = dev->isr_arg;
 
     DEBUG("_can_event: dev=%p, params=%p\n", (void*)dev, (void*)candev_dev);
@@ -92,7 +146,20 @@ static void _can_event(candev_t *dev, candev_event_t event, void *arg)
 #endif
         /* received frame in arg */
         frame = (struct can_frame *) arg;
-        can_dll_dispatch_rx_frame(frame, candev_dev->pid);
+        batch = _rx_batch_get(candev_dev);
+        if (!batch) {
+            can_dll_dispatch_rx_frame(frame, candev_dev->pid);
+            break;
+        }
+        /* the frame is only valid during the callback, copy it now */
+        batch->pkts[batch->num] = can_pkt_alloc_rx(candev_dev->ifnum, frame);
+        if (!batch->pkts[batch->num]) {
+            DEBUG("_can_event: out of packets, frame lost\n");
+            break;
+        }
+        if (++batch->num == CAN_DEVICE_RX_BATCH_SIZE) {
+            _rx_batch_flush(batch);
+        }
         break;
     case CANDEV_EVENT_RX_ERROR:
         DEBUG("_can_event: CANDEV_EVENT_RX_ERROR\n");
@@ -242,7 +309,7 @@ static void *_can_device_thread(void *args)
         switch (msg.type) {
         case CAN_MSG_EVENT:
             DEBUG("can device: CAN_MSG_EVENT received\n");
-            dev->driver->isr(dev);
+            _isr(candev_dev);
             break;
         case CAN_MSG_ABORT_FRAME:
             DEBUG("can device: CAN_MSG_ABORT_FRAME received\n");
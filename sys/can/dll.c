@@ -357,6 +357,11 @@ int can_dll_dispatch_rx_frame(struct can_frame *frame, kernel_pid_t pid)
     return can_router_dispatch_rx_indic(pkt);
 }
 
+int can_dll_dispatch_rx_pkts(can_pkt_t **pkts, unsigned num)
+{
+    return can_router_dispatch_rx_indic_batch(pkts, num);
+}
+
 static int _remove_entry_from_list(can_reg_entry_t **list, can_reg_entry_t *entry)
 {
     assert(list);
@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 #include <errno.h>
+#include <string.h>
 
 #include "kernel_defines.h"
 
@@ -41,6 +42,33 @@
 #include <inttypes.h>
 #endif
 
+#ifndef CAN_ROUTER_MAX_FILTER
+#define CAN_ROUTER_MAX_FILTER   64
+#endif
+
+/**
+ * Number of hash buckets shared by the indexed filters of all interfaces,
+ * must be a power of 2
+ */
+#ifndef CAN_ROUTER_HASH_SIZE
+#define CAN_ROUTER_HASH_SIZE    32
+#endif
+
+/**
+ * Number of distinct masks per interface whose filters are indexed, filters
+ * with further masks are kept in the (linearly searched) list of the interface
+ */
+#ifndef CAN_ROUTER_MASK_GROUPS
+#define CAN_ROUTER_MASK_GROUPS  4
+#endif
+
+#if (CAN_ROUTER_HASH_SIZE == 0) || \
+    ((CAN_ROUTER_HASH_SIZE & (CAN_ROUTER_HASH_SIZE - 1)) != 0)
+#error "CAN_ROUTER_HASH_SIZE must be a power of 2"
+#endif
+
+#define NO_GROUP                UINT8_MAX
+
 /**
  * This is a can_id element
  */
@@ -49,16 +77,32 @@ typedef struct filter_el {
     canid_t can_id;          /**< CAN ID of the element */
     canid_t mask;            /**< Mask of the element */
     void *data;              /**< Private data */
+    uint8_t group;           /**< Mask group of the element or NO_GROUP */
 } filter_el_t;
 
 /**
- * This table contains @p CAN_ROUTER_APP_MAX lists of CAN IDs per interface
+ * A mask used by indexed filters of an interface
+ */
+typedef struct {
+    canid_t mask;            /**< Mask of the group */
+    uint16_t refs;           /**< Number of filters in the group, 0 if unused */
+} mask_group_t;
+
+/**
+ * This table contains a list of the filters that are not indexed per interface
  */
 static can_reg_entry_t *table[CAN_DLL_NUMOF];
 
-#ifndef CAN_ROUTER_MAX_FILTER
-#define CAN_ROUTER_MAX_FILTER   64
-#endif
+/**
+ * Indexed filters hashed by interface, mask and CAN ID
+ *
+ * A frame matches the filters of a group in the bucket of
+ * (frame.can_id & group.mask), so a frame is dispatched with one bucket
+ * lookup per group instead of comparing it against every filter.
+ * Exact filters are simply the group with the mask 0xFFFFFFFF.
+ */
+static can_reg_entry_t *_buckets[CAN_ROUTER_HASH_SIZE];
+static mask_group_t _groups[CAN_DLL_NUMOF][CAN_ROUTER_MASK_GROUPS];
 
 static filter_el_t _filter_buf[CAN_ROUTER_MAX_FILTER];
 static memarray_t _filter_array;
@@ -67,7 +111,7 @@ static mutex_t lock = MUTEX_INIT;
 static filter_el_t *_alloc_filter_el(canid_t can_id, canid_t mask, void *data);
 static void _free_filter_el(filter_el_t *el);
 static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el);
-static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data);
+static filter_el_t *_find_filter_el(unsigned int ifnum, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data);
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask);
 
 #if ENABLE_DEBUG
@@ -76,6 +120,21 @@ static void _print_filters(void)
     for (int i = 0; i < (int)CAN_DLL_NUMOF; i++) {
         DEBUG("--- Ifnum: %d ---\n", i);
         can_reg_entry_t *entry;
+        for (unsigned g = 0; g < CAN_ROUTER_MASK_GROUPS; g++) {
+            if (_groups[i][g].refs) {
+                DEBUG("Group %u: mask=0x%" PRIx32 ", filters=%u\n", g,
+                      _groups[i][g].mask, _groups[i][g].refs);
+            }
+        }
+        for (unsigned b = 0; b < CAN_ROUTER_HASH_SIZE; b++) {
+            LL_FOREACH(_buckets[b], entry) {
+                filter_el_t *el = container_of(entry, filter_el_t, entry);
+                if (entry->ifnum == i) {
+                    DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p, bucket=%u\n",
+                          el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data, b);
+                }
+            }
+        }
         LL_FOREACH(table[i], entry) {
             filter_el_t *el = container_of(entry, filter_el_t, entry);
             DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
@@ -92,6 +151,9 @@ static void _print_filters(void)
 void can_router_init(void)
 {
     mutex_init(&lock);
+    memset(table, 0, sizeof(table));
+    memset(_buckets, 0, sizeof(_buckets));
+    memset(_groups, 0, sizeof(_groups));
     memarray_init(&_filter_array, _filter_buf, sizeof(filter_el_t), CAN_ROUTER_MAX_FILTER);
 }
 
@@ -107,6 +169,7 @@ static filter_el_t *_alloc_filter_el(canid_t can_id, canid_t mask, void *data)
     el->can_id = can_id;
     el->mask = mask;
     el->data = data;
+    el->group = NO_GROUP;
     el->entry.next = NULL;
     DEBUG("_alloc_canid_el: el allocated with can_id=0x%" PRIx32 ", mask=0x%" PRIx32
           ", data=%p\n", can_id, mask, data);
@@ -167,40 +230,104 @@ static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el)
 #define ENTRY_MATCHES(e1, e2)  ((e1)->target.pid == (e2)->target.pid)
 #endif
 
-static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data)
+static unsigned _bucket(unsigned int ifnum, canid_t can_id, canid_t mask)
 {
-    filter_el_t *el = container_of(list, filter_el_t, entry);
-    if (!el) {
-        return el;
+    /* Fibonacci hashing, spreads consecutive IDs over all buckets */
+    uint32_t hash = (can_id ^ mask) * 0x9E3779B1UL;
+
+    return ((hash >> 16) + ifnum) & (CAN_ROUTER_HASH_SIZE - 1);
+}
+
+static int _find_group(unsigned int ifnum, canid_t mask)
+{
+    for (unsigned g = 0; g < CAN_ROUTER_MASK_GROUPS; g++) {
+        if (_groups[ifnum][g].refs && (_groups[ifnum][g].mask == mask)) {
+            return g;
+        }
+    }
+    return -1;
+}
+
+static int _alloc_group(unsigned int ifnum, canid_t mask)
+{
+    int group = _find_group(ifnum, mask);
+
+    if (group >= 0) {
+        return group;
+    }
+    for (unsigned g = 0; g < CAN_ROUTER_MASK_GROUPS; g++) {
+        if (!_groups[ifnum][g].refs) {
+            _groups[ifnum][g].mask = mask;
+            return g;
+        }
+    }
+    DEBUG("_alloc_group: no free mask group, mask=0x%" PRIx32 " not indexed\n", mask);
+    return -1;
+}
+
+static void _insert_filter_el(unsigned int ifnum, filter_el_t *el)
+{
+    int group = _alloc_group(ifnum, el->mask);
+
+    if (group < 0) {
+        _insert_to_list(&table[ifnum], el);
+        return;
+    }
+    el->group = group;
+    _groups[ifnum][group].refs++;
+    LL_PREPEND(_buckets[_bucket(ifnum, el->can_id, el->mask)], &el->entry);
+}
+
+static void _remove_filter_el(unsigned int ifnum, filter_el_t *el)
+{
+    if (el->group == NO_GROUP) {
+        LL_DELETE(table[ifnum], &el->entry);
+        return;
     }
-    do {
-        if ((el->can_id == can_id) && (el->mask == mask) && (el->data == data) &&
-                ENTRY_MATCHES(&el->entry, entry)) {
-            DEBUG("_find_filter_el: found el=%p, can_id=%" PRIx32 ", mask=%" PRIx32 ", data=%p\n",
+    _groups[ifnum][el->group].refs--;
+    LL_DELETE(_buckets[_bucket(ifnum, el->can_id, el->mask)], &el->entry);
+}
+
+static filter_el_t *_find_in_list(can_reg_entry_t *list, unsigned int ifnum,
+                                  can_reg_entry_t *entry, canid_t can_id,
+                                  canid_t mask, void *data)
+{
+    can_reg_entry_t *e;
+
+    LL_FOREACH(list, e) {
+        filter_el_t *el = container_of(e, filter_el_t, entry);
+        if (((unsigned int)e->ifnum == ifnum) && (el->can_id == can_id) &&
+                (el->mask == mask) &&
+                (!entry || ((el->data == data) && ENTRY_MATCHES(e, entry)))) {
+            DEBUG("_find_in_list: found el=%p, can_id=%" PRIx32 ", mask=%" PRIx32 ", data=%p\n",
                   (void *)el, el->can_id, el->mask, el->data);
             return el;
         }
-        el = container_of(el->entry.next, filter_el_t, entry);
-    }  while (el);
-
+    }
     return NULL;
 }
 
-static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
+/* A filter is either in the bucket of its group or, if there was no free
+ * group when it was registered, in the list of its interface */
+static filter_el_t *_find_filter_el(unsigned int ifnum, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data)
 {
-    filter_el_t *el = container_of(table[ifnum], filter_el_t, entry);
+    filter_el_t *el = NULL;
+
+    if (_find_group(ifnum, mask) >= 0) {
+        el = _find_in_list(_buckets[_bucket(ifnum, can_id, mask)], ifnum,
+                           entry, can_id, mask, data);
+    }
     if (!el) {
-        DEBUG("_filter_is_used: empty list\n");
-        return 0;
+        el = _find_in_list(table[ifnum], ifnum, entry, can_id, mask, data);
+    }
+    return el;
+}
+
+static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
+{
+    if (_find_filter_el(ifnum, NULL, can_id, mask, NULL)) {
+        return 1;
     }
-    do {
-        if ((el->can_id == can_id) && (el->mask == mask)) {
-            DEBUG("_filter_is_used: found el=%p, can_id=%" PRIx32 ", mask=%" PRIx32 ", data=%p\n",
-                  (void *)el, el->can_id, el->mask, el->data);
-            return 1;
-        }
-        el = container_of(el->entry.next, filter_el_t, entry);
-    }  while (el);
 
     DEBUG("_filter_is_used: filter not found\n");
 
@@ -247,7 +374,7 @@ int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, vo
     filter->entry.target.pid = entry->target.pid;
 #endif
     filter->entry.ifnum = entry->ifnum;
-    _insert_to_list(&table[entry->ifnum], filter);
+    _insert_filter_el(entry->ifnum, filter);
     mutex_unlock(&lock);
 
     PRINT_FILTERS();
@@ -273,12 +400,12 @@ int can_router_unregister(can_reg_entry_t *entry, canid_t can_id,
 #endif
 
     mutex_lock(&lock);
-    el = _find_filter_el(table[entry->ifnum], entry, can_id, mask, param);
+    el = _find_filter_el(entry->ifnum, entry, can_id, mask, param);
     if (!el) {
         mutex_unlock(&lock);
         return -EINVAL;
     }
-    LL_DELETE(table[entry->ifnum], &el->entry);
+    _remove_filter_el(entry->ifnum, el);
     _free_filter_el(el);
     ret = _filter_is_used(entry->ifnum, can_id, mask);
     mutex_unlock(&lock);
@@ -305,6 +432,73 @@ static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 #endif
 }
 
+/* send pkt to the user of a matching filter, returns 1 if the user got it */
+static int _dispatch_to(can_pkt_t *pkt, filter_el_t *el)
+{
+    msg_t msg;
+
+    DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
+          (void *)el, (void *)el->data);
+    DEBUG("can_router_dispatch_rx_indic: rx_ind to pid: %"
+          PRIkernel_pid "\n", el->entry.target.pid);
+    msg.type = CAN_MSG_RX_INDICATION;
+    atomic_fetch_add(&pkt->ref_count, 1);
+    msg.content.ptr = can_pkt_alloc_rx_data(&pkt->frame, sizeof(pkt->frame), el->data);
+    if (!msg.content.ptr || (_send_msg(&msg, &el->entry) <= 0)) {
+        can_pkt_free_rx_data(msg.content.ptr);
+        atomic_fetch_sub(&pkt->ref_count, 1);
+        DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
+              "pid=%" PRIkernel_pid "\n", el->entry.target.pid);
+        return 0;
+    }
+    return 1;
+}
+
+/* Must be called with lock held. Returns the number of users the pkt was
+ * sent to, @p res is set to -EBUSY if a user could not receive it */
+static unsigned _dispatch(can_pkt_t *pkt, int *res)
+{
+    unsigned int ifnum = pkt->entry.ifnum;
+    canid_t can_id = pkt->frame.can_id;
+    can_reg_entry_t *entry;
+    unsigned sent = 0;
+
+    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
+          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
+
+    for (unsigned g = 0; g < CAN_ROUTER_MASK_GROUPS; g++) {
+        mask_group_t *group = &_groups[ifnum][g];
+        if (!group->refs) {
+            continue;
+        }
+        canid_t key = can_id & group->mask;
+        LL_FOREACH(_buckets[_bucket(ifnum, key, group->mask)], entry) {
+            filter_el_t *el = container_of(entry, filter_el_t, entry);
+            if (((unsigned int)entry->ifnum == ifnum) &&
+                    (el->group == g) && (el->can_id == key)) {
+                if (!_dispatch_to(pkt, el)) {
+                    *res = -EBUSY;
+                    return sent;
+                }
+                sent++;
+            }
+        }
+    }
+    LL_FOREACH(table[ifnum], entry) {
+        filter_el_t *el = container_of(entry, filter_el_t, entry);
+        if ((can_id & el->mask) == el->can_id) {
+            if (!_dispatch_to(pkt, el)) {
+                *res = -EBUSY;
+                return sent;
+            }
+            sent++;
+        }
+    }
+    DEBUG("can_router_dispatch_rx: msg send to %u threads\n", sent);
+
+    return sent;
+}
+
 /* send received pkt to all interested users */
 int can_router_dispatch_rx_indic(can_pkt_t *pkt)
 {
@@ -314,45 +508,35 @@ int can_router_dispatch_rx_indic(can_pkt_t *pkt)
     }
 
     int res = 0;
-    msg_t msg;
-    msg.type = CAN_MSG_RX_INDICATION;
-#if ENABLE_DEBUG
-    int msg_cnt = 0;
-#endif
-    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
-          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
 
     mutex_lock(&lock);
-    can_reg_entry_t *entry = NULL;
-    filter_el_t *el;
-    LL_FOREACH(table[pkt->entry.ifnum], entry) {
-        el = container_of(entry, filter_el_t, entry);
-        if ((pkt->frame.can_id & el->mask) == el->can_id) {
-            DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
-                  (void *)el, (void *)el->data);
-            DEBUG("can_router_dispatch_rx_indic: rx_ind to pid: %"
-                  PRIkernel_pid "\n", entry->target.pid);
-            atomic_fetch_add(&pkt->ref_count, 1);
-            msg.content.ptr = can_pkt_alloc_rx_data(&pkt->frame, sizeof(pkt->frame), el->data);
-#if ENABLE_DEBUG
-            msg_cnt++;
-#endif
-            if (!msg.content.ptr || (_send_msg(&msg, entry) <= 0)) {
-                can_pkt_free_rx_data(msg.content.ptr);
-                atomic_fetch_sub(&pkt->ref_count, 1);
-                DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
-                      "pid=%" PRIkernel_pid "\n", entry->target.pid);
-                res = -EBUSY;
-                break;
-            }
+    unsigned sent = _dispatch(pkt, &res);
+    mutex_unlock(&lock);
+
+    /* once sent, the pkt is freed by its users, possibly already */
+    if (!sent) {
+        can_pkt_free(pkt);
+    }
+
+    return res;
+}
+
+int can_router_dispatch_rx_indic_batch(can_pkt_t **pkts, unsigned num)
+{
+    int res = 0;
+
+    mutex_lock(&lock);
+    for (unsigned i = 0; i < num; i++) {
+        if (pkts[i] && _dispatch(pkts[i], &res)) {
+            pkts[i] = NULL;
         }
     }
     mutex_unlock(&lock);
-#if ENABLE_DEBUG
-    DEBUG("can_router_dispatch_rx: msg send to %d threads\n", msg_cnt);
-#endif
-    if (atomic_load(&pkt->ref_count) == 0) {
-        can_pkt_free(pkt);
+
+    for (unsigned i = 0; i < num; i++) {
+        if (pkts[i]) {
+            can_pkt_free(pkts[i]);
+        }
     }
 
     return res;
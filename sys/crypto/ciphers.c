@@ -44,6 +44,46 @@ int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 }
 
 
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t blocks)
+{
+    uint8_t block_size = cipher->interface->block_size;
+
+    if (cipher->interface->encrypt_blocks != NULL) {
+        return cipher->interface->encrypt_blocks(&cipher->context, input,
+                                                 output, blocks);
+    }
+    for (size_t i = 0; i < blocks; i++) {
+        int res = cipher_encrypt(cipher, input + (i * block_size),
+                                 output + (i * block_size));
+        if (res != 1) {
+            return res;
+        }
+    }
+    return 1;
+}
+
+
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t blocks)
+{
+    uint8_t block_size = cipher->interface->block_size;
+
+    if (cipher->interface->decrypt_blocks != NULL) {
+        return cipher->interface->decrypt_blocks(&cipher->context, input,
+                                                 output, blocks);
+    }
+    for (size_t i = 0; i < blocks; i++) {
+        int res = cipher_decrypt(cipher, input + (i * block_size),
+                                 output + (i * block_size));
+        if (res != 1) {
+            return res;
+        }
+    }
+    return 1;
+}
+
+
 int cipher_get_block_size(const cipher_t* cipher)
 {
     return cipher->interface->block_size;
@@ -67,15 +67,18 @@ int cipher_decrypt_cbc(cipher_t* cipher, uint8_t iv[16],
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
+    /* the blocks decrypt independently, only the XOR needs the previous
+     * ciphertext block */
+    if (cipher_decrypt_blocks(cipher, input, output,
+                              length / block_size) != 1) {
+        return CIPHER_ERR_DEC_FAILED;
+    }
+
     input_block_last = iv;
     do {
         input_block = input + offset;
         uint8_t *output_block = output + offset;
 
-        if (cipher_decrypt(cipher, input_block, output_block) != 1) {
-            return CIPHER_ERR_DEC_FAILED;
-        }
-
         /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
         for (uint8_t i = 0; i < block_size; ++i) {
             output_block[i] ^= input_block_last[i];
@@ -21,9 +21,10 @@
 #include <string.h>
 #include "debug.h"
 #include "crypto/helper.h"
-#include "crypto/modes/ctr.h"
 #include "crypto/modes/ccm.h"
 
+#define CCM_BLOCK_SIZE      (16U)
+
 static inline int min(int a, int b)
 {
     if (a < b) {
@@ -34,244 +35,320 @@ static inline int min(int a, int b)
     }
 }
 
-int ccm_compute_cbc_mac(cipher_t* cipher, const uint8_t iv[16],
-                        const uint8_t* input, size_t length, uint8_t* mac)
+/* Check if 'value' can be stored in 'num_bytes' */
+static inline int _fits_in_nbytes(size_t value, uint8_t num_bytes)
 {
-    uint8_t offset, block_size, mac_enc[16] = {0};
-
-    block_size = cipher_get_block_size(cipher);
-    memmove(mac, iv, 16);
-    offset = 0;
-    do {
-        uint8_t block_size_input = (length - offset > block_size) ?
-                                   block_size : length - offset;
-
-        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (int i = 0; i < block_size_input; ++i) {
-            mac[i] ^= input[offset + i];
-        }
-
-        if (cipher_encrypt(cipher, mac, mac_enc) != 1) {
-            return CIPHER_ERR_ENC_FAILED;
-        }
-
-        memcpy(mac, mac_enc, block_size);
-        offset += block_size_input;
-    } while (offset < length);
-
-    return offset;
+    /* Not allowed to shift more or equal than left operand width
+     * So we shift by maximum num bits of size_t -1 and compare to 1
+     */
+    unsigned shift = (8 * min(sizeof(size_t), num_bytes)) - 1;
+    return (value >> shift) <= 1;
 }
 
-
-int ccm_create_mac_iv(cipher_t* cipher, uint8_t auth_data_len, uint8_t M,
-                      uint8_t L, const uint8_t* nonce, uint8_t nonce_len,
-                      size_t plaintext_len, uint8_t X1[16])
+static int _check_params(uint8_t mac_length, uint8_t length_encoding)
 {
-    uint8_t M_, L_;
+    if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
+        return CCM_ERR_INVALID_MAC_LENGTH;
+    }
+    if (length_encoding < 2 || length_encoding > 8) {
+        return CCM_ERR_INVALID_LENGTH_ENCODING;
+    }
+    return 0;
+}
 
-    /* ensure everything is set to zero */
-    memset(X1, 0, 16);
+/* set the flags of B0 and A0, the nonce is filled in by the caller */
+static void _init_blocks(uint8_t b0[16], uint8_t a0[16], uint8_t M, uint8_t L)
+{
+    memset(b0, 0, CCM_BLOCK_SIZE);
+    memset(a0, 0, CCM_BLOCK_SIZE);
 
     /* set flags in B[0] - bit format:
             7        6     5..3  2..0
         Reserved   Adata    M_    L_    */
-    M_ = (M - 2) / 2;
-    L_ = L - 1;
-    X1[0] = 64 * (auth_data_len > 0) + 8 * M_ + L_;
-
-    /* copy nonce to B[1..15-L] */
-    memcpy(&X1[1], nonce, min(nonce_len, 15 - L));
+    b0[0] = 8 * ((M - 2) / 2) + (L - 1);
+    a0[0] = L - 1;
+}
 
-    /* write plaintext_len to B[15..16-L] */
-    for (uint8_t i = 15; i > 16 - L; --i) {
-        X1[i] = plaintext_len & 0xff;
-        plaintext_len >>= 8;
+/* write len to the last L bytes of B0 and set the Adata flag */
+static int _finish_b0(uint8_t b0[16], uint8_t L, uint32_t auth_data_len,
+                      size_t len)
+{
+    if (auth_data_len > 0) {
+        b0[0] |= 64;
     }
-
-    /* if there is still data, plaintext_len was too big */
-    if (plaintext_len > 0) {
-        return CIPHER_ERR_INVALID_LENGTH;
+    for (uint8_t i = 15; i > 15 - L; --i) {
+        b0[i] = len & 0xff;
+        len >>= 8;
     }
 
-    if (cipher_encrypt(cipher, X1, X1) != 1) {
-        return CIPHER_ERR_ENC_FAILED;
-    }
-    return 0;
+    /* if there is still data, len was too big */
+    return (len > 0) ? CCM_ERR_INVALID_DATA_LENGTH : 0;
 }
 
-int ccm_compute_adata_mac(cipher_t* cipher, const uint8_t* auth_data,
-                          uint32_t auth_data_len, uint8_t X1[16])
+/*
+ * Single pass over the data: the CBC-MAC is one block behind the counter, so
+ * that each MAC block is encrypted together with the next counter block in a
+ * single call to cipher_encrypt_blocks(). This works the same way for
+ * decryption, where a payload block is only known after its counter block
+ * was encrypted.
+ *
+ * blk holds X (the CBC-MAC state) followed by the counter block A, both are
+ * encrypted into ks at once.
+ */
+static int _ccm_crypt(const cipher_t *cipher, const uint8_t b0[16],
+                      const uint8_t a0[16], uint8_t L,
+                      const uint8_t *auth_data, uint32_t auth_data_len,
+                      const uint8_t *input, size_t len, uint8_t *output,
+                      int decrypt, uint8_t tag[16])
 {
-    if (auth_data_len > 0) {
-        int len;
-
-        /* 16 octet block size + max. 10 len encoding  */
-        uint8_t auth_data_encoded[26], len_encoding = 0;
+    uint8_t blk[2 * CCM_BLOCK_SIZE], ks[2 * CCM_BLOCK_SIZE];
+    uint8_t *x = blk, *ctr = &blk[CCM_BLOCK_SIZE];
+    uint8_t s0[CCM_BLOCK_SIZE];
+    int pending = 0;
+
+    /* X1 = E(B0), S0 = E(A0) */
+    memcpy(x, b0, CCM_BLOCK_SIZE);
+    memcpy(ctr, a0, CCM_BLOCK_SIZE);
+    if (cipher_encrypt_blocks(cipher, blk, ks, 2) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    memcpy(x, ks, CCM_BLOCK_SIZE);
+    memcpy(s0, &ks[CCM_BLOCK_SIZE], CCM_BLOCK_SIZE);
 
-        /* If 0 < l(a) < (2^16 - 2^8), then the length field is encoded as two
-         * octets. (RFC3610 page 2)
+    if (auth_data_len > 0) {
+        /* If 0 < l(a) < (2^16 - 2^8), then the length field is encoded as
+         * two octets. (RFC3610 page 2)
          */
-        if (auth_data_len <= 0xFEFF) {
-            /* length (0x0001 ... 0xFEFF)  */
-            len_encoding = 2;
-
-            auth_data_encoded[1] = auth_data_len & 0xFF;
-            auth_data_encoded[0] = (auth_data_len >> 8) & 0xFF;
-        } else {
+        if (auth_data_len > 0xFEFF) {
             DEBUG("UNSUPPORTED Adata length: %" PRIu32 "\n", auth_data_len);
             return -1;
         }
-
-        memcpy(auth_data_encoded + len_encoding, auth_data, auth_data_len);
-        len = ccm_compute_cbc_mac(cipher, X1, auth_data_encoded, auth_data_len + len_encoding, X1);
-        if (len < 0) {
-            return -1;
+        x[0] ^= (auth_data_len >> 8) & 0xFF;
+        x[1] ^= auth_data_len & 0xFF;
+
+        unsigned pos = 2;
+        for (uint32_t i = 0; i < auth_data_len; i++) {
+            if (pos == CCM_BLOCK_SIZE) {
+                if (cipher_encrypt(cipher, x, x) != 1) {
+                    return CIPHER_ERR_ENC_FAILED;
+                }
+                pos = 0;
+            }
+            x[pos++] ^= auth_data[i];
         }
+        /* the last (zero padded) block goes with the first counter block */
+        pending = 1;
     }
 
-    return 0;
-}
+    for (size_t offset = 0; offset < len; offset += CCM_BLOCK_SIZE) {
+        unsigned n = min(len - offset, CCM_BLOCK_SIZE);
 
+        crypto_block_inc_ctr(ctr, L);
+        if (pending) {
+            if (cipher_encrypt_blocks(cipher, blk, ks, 2) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+            memcpy(x, ks, CCM_BLOCK_SIZE);
+        }
+        else if (cipher_encrypt(cipher, ctr, &ks[CCM_BLOCK_SIZE]) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
 
-/* Check if 'value' can be stored in 'num_bytes' */
-static inline int _fits_in_nbytes(size_t value, uint8_t num_bytes)
-{
-    /* Not allowed to shift more or equal than left operand width
-     * So we shift by maximum num bits of size_t -1 and compare to 1
-     */
-    unsigned shift = (8 * min(sizeof(size_t), num_bytes)) - 1;
-    return (value >> shift) <= 1;
-}
+        /* input and output may be the same buffer */
+        for (unsigned i = 0; i < n; i++) {
+            uint8_t in = input[offset + i];
+            uint8_t out = in ^ ks[CCM_BLOCK_SIZE + i];
 
+            x[i] ^= decrypt ? out : in;
+            output[offset + i] = out;
+        }
+        pending = 1;
+    }
 
-int cipher_encrypt_ccm(cipher_t* cipher,
-                       const uint8_t* auth_data, uint32_t auth_data_len,
-                       uint8_t mac_length, uint8_t length_encoding,
-                       const uint8_t* nonce, size_t nonce_len,
-                       const uint8_t* input, size_t input_len,
-                       uint8_t* output)
-{
-    int len = -1;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                stream_block[16] = {0}, zero_block[16] = {0}, block_size;
+    if (pending && cipher_encrypt(cipher, x, x) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
 
-    if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
-        return CCM_ERR_INVALID_MAC_LENGTH;
+    /* T = X ^ S0 */
+    for (unsigned i = 0; i < CCM_BLOCK_SIZE; i++) {
+        tag[i] = x[i] ^ s0[i];
     }
+    return 0;
+}
+
+static int _encrypt(const cipher_t *cipher, uint8_t b0[16],
+                    const uint8_t a0[16], uint8_t mac_length, uint8_t L,
+                    const uint8_t *auth_data, uint32_t auth_data_len,
+                    const uint8_t *input, size_t input_len, uint8_t *output)
+{
+    uint8_t tag[CCM_BLOCK_SIZE];
+    int res;
 
-    if (length_encoding < 2 || length_encoding > 8 ||
-            !_fits_in_nbytes(input_len, length_encoding)) {
+    if (!_fits_in_nbytes(input_len, L)) {
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
-
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
-    block_size = cipher_get_block_size(cipher);
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, input_len, mac_iv) < 0) {
+    if (_finish_b0(b0, L, auth_data_len, input_len) < 0) {
         return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
-    /* MAC calulation (T) with additional data and plaintext */
-    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    if (len < 0) {
-        return len;
-    }
-    len = ccm_compute_cbc_mac(cipher, mac_iv, input, input_len, mac);
-    if (len < 0) {
-        return len;
+    res = _ccm_crypt(cipher, b0, a0, L, auth_data, auth_data_len,
+                     input, input_len, output, 0, tag);
+    if (res < 0) {
+        return res;
     }
+    memcpy(&output[input_len], tag, mac_length);
+
+    return input_len + mac_length;
+}
+
+static int _decrypt(const cipher_t *cipher, uint8_t b0[16],
+                    const uint8_t a0[16], uint8_t mac_length, uint8_t L,
+                    const uint8_t *auth_data, uint32_t auth_data_len,
+                    const uint8_t *input, size_t input_len, uint8_t *plain)
+{
+    uint8_t tag[CCM_BLOCK_SIZE];
+    size_t plain_len;
+    int res;
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    memcpy(&nonce_counter[1], nonce,
-           min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size,
-                             zero_block, block_size, stream_block);
-    if (len < 0) {
-        return len;
+    if (!_fits_in_nbytes(input_len, L)) {
+        return CCM_ERR_INVALID_LENGTH_ENCODING;
+    }
+    if (input_len < mac_length) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
+    }
+    plain_len = input_len - mac_length;
+    if (_finish_b0(b0, L, auth_data_len, plain_len) < 0) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
-    /* Encrypt message in counter mode  */
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             input_len, output);
-    if (len < 0) {
-        return len;
+    res = _ccm_crypt(cipher, b0, a0, L, auth_data, auth_data_len,
+                     input, plain_len, plain, 1, tag);
+    if (res < 0) {
+        return res;
     }
 
-    /* auth value: mac ^ first stream block */
-    for (uint8_t i = 0; i < mac_length; ++i) {
-        output[len + i] = mac[i] ^ stream_block[i];
+    if (!crypto_equals(&input[plain_len], tag, mac_length)) {
+        return CCM_ERR_INVALID_CBC_MAC;
     }
 
-    return len + mac_length;
+    return plain_len;
 }
 
+/* copy the nonce to B[1..15-L] and A[1..15-L] */
+static void _set_nonce(uint8_t b0[16], uint8_t a0[16], uint8_t offset,
+                       uint8_t L, const uint8_t *nonce, size_t nonce_len)
+{
+    size_t n = min(nonce_len, 15 - L - offset);
+
+    memcpy(&b0[1 + offset], nonce, n);
+    memcpy(&a0[1 + offset], nonce, n);
+}
 
-int cipher_decrypt_ccm(cipher_t* cipher,
+int cipher_encrypt_ccm(cipher_t* cipher,
                        const uint8_t* auth_data, uint32_t auth_data_len,
                        uint8_t mac_length, uint8_t length_encoding,
                        const uint8_t* nonce, size_t nonce_len,
                        const uint8_t* input, size_t input_len,
-                       uint8_t* plain)
+                       uint8_t* output)
 {
-    int len = -1;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                mac_recv[16] = {0}, stream_block[16] = {0}, zero_block[16] = {0},
-                                        plain_len, block_size;
+    uint8_t b0[CCM_BLOCK_SIZE], a0[CCM_BLOCK_SIZE];
+    int res = _check_params(mac_length, length_encoding);
 
-    if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
-        return CCM_ERR_INVALID_MAC_LENGTH;
+    if (res < 0) {
+        return res;
     }
+    _init_blocks(b0, a0, mac_length, length_encoding);
+    _set_nonce(b0, a0, 0, length_encoding, nonce, nonce_len);
 
-    if (length_encoding < 2 || length_encoding > 8 ||
-            !_fits_in_nbytes(input_len, length_encoding)) {
-        return CCM_ERR_INVALID_LENGTH_ENCODING;
-    }
+    return _encrypt(cipher, b0, a0, mac_length, length_encoding,
+                    auth_data, auth_data_len, input, input_len, output);
+}
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    block_size = cipher_get_block_size(cipher);
-    memcpy(&nonce_counter[1], nonce, min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size, zero_block,
-                             block_size, stream_block);
-    if (len < 0) {
-        return len;
-    }
+int cipher_decrypt_ccm(cipher_t* cipher,
+                       const uint8_t* auth_data, uint32_t auth_data_len,
+                       uint8_t mac_length, uint8_t length_encoding,
+                       const uint8_t* nonce, size_t nonce_len,
+                       const uint8_t* input, size_t input_len,
+                       uint8_t* plain)
+{
+    uint8_t b0[CCM_BLOCK_SIZE], a0[CCM_BLOCK_SIZE];
+    int res = _check_params(mac_length, length_encoding);
 
-    /* Decrypt message in counter mode */
-    plain_len = input_len - mac_length;
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             plain_len, plain);
-    if (len < 0) {
-        return len;
+    if (res < 0) {
+        return res;
     }
+    _init_blocks(b0, a0, mac_length, length_encoding);
+    _set_nonce(b0, a0, 0, length_encoding, nonce, nonce_len);
 
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, plain_len, mac_iv) < 0) {
-        return CCM_ERR_INVALID_DATA_LENGTH;
-    }
+    return _decrypt(cipher, b0, a0, mac_length, length_encoding,
+                    auth_data, auth_data_len, input, input_len, plain);
+}
+
+int ccm_ctx_init(ccm_ctx_t *ctx, const cipher_t *cipher, uint8_t mac_length,
+                 uint8_t length_encoding, const uint8_t *nonce_prefix,
+                 size_t prefix_len)
+{
+    int res = _check_params(mac_length, length_encoding);
 
-    /* MAC calulation (T) with additional data and plaintext */
-    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    if (len < 0) {
-        return len;
+    if (res < 0) {
+        return res;
     }
-    len = ccm_compute_cbc_mac(cipher, mac_iv, plain, plain_len, mac);
-    if (len < 0) {
-        return len;
+    if (prefix_len > (size_t)(15 - length_encoding)) {
+        return CCM_ERR_INVALID_NONCE_LENGTH;
     }
 
-    /* mac = input[plain_len...plain_len+mac_length] ^ first stream block */
-    for (uint8_t i = 0; i < mac_length; ++i) {
-        mac_recv[i] = input[len + i] ^ stream_block[i];
+    ctx->cipher = cipher;
+    ctx->mac_length = mac_length;
+    ctx->length_encoding = length_encoding;
+    ctx->prefix_len = prefix_len;
+    _init_blocks(ctx->b0, ctx->a0, mac_length, length_encoding);
+    _set_nonce(ctx->b0, ctx->a0, 0, length_encoding, nonce_prefix, prefix_len);
+
+    return 0;
+}
+
+/* B0 and A0 of a frame: the templates with the nonce tail filled in */
+static int _ctx_blocks(const ccm_ctx_t *ctx, uint8_t b0[16], uint8_t a0[16],
+                       const uint8_t *nonce_tail, size_t tail_len)
+{
+    if (tail_len > (size_t)(15 - ctx->length_encoding - ctx->prefix_len)) {
+        return CCM_ERR_INVALID_NONCE_LENGTH;
     }
+    memcpy(b0, ctx->b0, CCM_BLOCK_SIZE);
+    memcpy(a0, ctx->a0, CCM_BLOCK_SIZE);
+    _set_nonce(b0, a0, ctx->prefix_len, ctx->length_encoding,
+               nonce_tail, tail_len);
+    return 0;
+}
 
-    if (!crypto_equals(mac_recv, mac, mac_length)) {
-        return CCM_ERR_INVALID_CBC_MAC;
+int ccm_ctx_encrypt(const ccm_ctx_t *ctx,
+                    const uint8_t *nonce_tail, size_t tail_len,
+                    const uint8_t *auth_data, uint32_t auth_data_len,
+                    const uint8_t *input, size_t input_len, uint8_t *output)
+{
+    uint8_t b0[CCM_BLOCK_SIZE], a0[CCM_BLOCK_SIZE];
+    int res = _ctx_blocks(ctx, b0, a0, nonce_tail, tail_len);
+
+    if (res < 0) {
+        return res;
     }
+    return _encrypt(ctx->cipher, b0, a0, ctx->mac_length,
+                    ctx->length_encoding, auth_data, auth_data_len,
+                    input, input_len, output);
+}
 
-    return plain_len;
+int ccm_ctx_decrypt(const ccm_ctx_t *ctx,
+                    const uint8_t *nonce_tail, size_t tail_len,
+                    const uint8_t *auth_data, uint32_t auth_data_len,
+                    const uint8_t *input, size_t input_len, uint8_t *plain)
+{
+    uint8_t b0[CCM_BLOCK_SIZE], a0[CCM_BLOCK_SIZE];
+    int res = _ctx_blocks(ctx, b0, a0, nonce_tail, tail_len);
+
+    if (res < 0) {
+        return res;
+    }
+    return _decrypt(ctx->cipher, b0, a0, ctx->mac_length,
+                    ctx->length_encoding, auth_data, auth_data_len,
+                    input, input_len, plain);
 }
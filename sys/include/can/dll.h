@@ -62,6 +62,21 @@ int can_dll_register_candev(candev_dev_t *candev);
  */
 int can_dll_dispatch_rx_frame(struct can_frame *frame, kernel_pid_t pid);
 
+/**
+ * @brief Dispatch several received packets
+ *
+ * This function is used by the device thread to dispatch all frames it
+ * received during one interrupt at once, the packets must have been allocated
+ * with can_pkt_alloc_rx()
+ *
+ * @param[in,out] pkts  the received packets, NULL entries are skipped
+ * @param[in] num       the number of packets in @p pkts
+ *
+ * @return 0 on success
+ * @return < 0 if at least one frame could not be delivered to all its receivers
+ */
+int can_dll_dispatch_rx_pkts(can_pkt_t **pkts, unsigned num);
+
 /**
  * @brief Dispatch a tx confirmation
  *
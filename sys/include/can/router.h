@@ -91,6 +91,22 @@ int can_router_free_frame(struct can_frame *frame);
  */
 int can_router_dispatch_rx_indic(can_pkt_t *pkt);
 
+/**
+ * @brief Dispatch several RX indications to subscribers threads
+ *
+ * Same as can_router_dispatch_rx_indic() for each packet of @p pkts, but the
+ * filters are locked only once for all of them. Packets which no subscriber's
+ * thread received are freed.
+ *
+ * @param[in,out] pkts  the packets to dispatch, NULL entries are skipped,
+ *                      the array is modified
+ * @param[in] num       the number of packets in @p pkts
+ *
+ * @return 0 on success
+ * @return < 0 on error, if at least a thread cannot receive message
+ */
+int can_router_dispatch_rx_indic_batch(can_pkt_t **pkts, unsigned num);
+
 /**
  * @brief Dispatch a TX confirmation to the sender's thread
  *
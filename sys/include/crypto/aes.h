@@ -47,6 +47,7 @@ typedef uint8_t u8;
 #define AES_MAXNR         14
 #define AES_BLOCK_SIZE    16
 #define AES_KEY_SIZE      16
+#define AES_ROUNDS        10    /**< rounds for the supported key size */
 
 /**
  * @brief AES key
@@ -63,10 +64,13 @@ typedef struct aes_key_st AES_KEY;
 
 /**
  * @brief the cipher_context_t-struct adapted for AES
+ *
+ * The key is expanded once by aes_init(), so the round keys for both
+ * directions are kept instead of the key itself.
  */
 typedef struct {
-    /** context data buffer */
-    uint32_t context[(4 * (AES_MAXNR + 1)) + 1];
+    uint32_t rd_key_enc[4 * (AES_ROUNDS + 1)];  /**< encryption round keys */
+    uint32_t rd_key_dec[4 * (AES_ROUNDS + 1)];  /**< decryption round keys */
 } aes_context_t;
 
 /**
@@ -100,8 +104,6 @@ int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize);
  *                            be stored
  *
  * @return  1 on success
- * @return  A negative value if the cipher key cannot be expanded with the
- *          AES key schedule
  */
 int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
                 uint8_t *cipher_block);
@@ -120,12 +122,50 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
  *                            plaintext will be stored
  *
  * @return  1 on success
- * @return  A negative value if the cipher key cannot be expanded with the
- *          AES key schedule
  */
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts a number of consecutive blocks
+ *
+ * Same as calling aes_encrypt() for each block, but without a call through
+ * the cipher interface per block.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            encryption
+ * @param       plain_blocks  a pointer to @p blocks plaintext blocks
+ * @param       cipher_blocks a pointer to the place where the @p blocks
+ *                            ciphertext blocks will be stored, may be equal
+ *                            to @p plain_blocks
+ * @param       blocks        the number of blocks
+ *
+ * @return  1 on success
+ */
+int aes_encrypt_blocks(const cipher_context_t *context,
+                       const uint8_t *plain_blocks, uint8_t *cipher_blocks,
+                       size_t blocks);
+
+/**
+ * @brief   decrypts a number of consecutive blocks
+ *
+ * Same as calling aes_decrypt() for each block, but without a call through
+ * the cipher interface per block.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            decryption
+ * @param       cipher_blocks a pointer to @p blocks ciphertext blocks
+ * @param       plain_blocks  a pointer to the place where the @p blocks
+ *                            plaintext blocks will be stored, may be equal
+ *                            to @p cipher_blocks
+ * @param       blocks        the number of blocks
+ *
+ * @return  1 on success
+ */
+int aes_decrypt_blocks(const cipher_context_t *context,
+                       const uint8_t *cipher_blocks, uint8_t *plain_blocks,
+                       size_t blocks);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -45,13 +46,14 @@ extern "C" {
  * Context sizes needed for the different ciphers.
  * Always order by number of bytes descending!!! <br><br>
  *
+ * aes          needs 352 bytes (round keys for encryption and decryption,
+ *              see aes_context_t) <br>
  * threedes     needs 24  bytes                           <br>
- * aes          needs CIPHERS_MAX_KEY_SIZE bytes          <br>
  */
-#if defined(CRYPTO_THREEDES)
+#if defined(CRYPTO_AES)
+    #define CIPHER_MAX_CONTEXT_SIZE 352
+#elif defined(CRYPTO_THREEDES)
     #define CIPHER_MAX_CONTEXT_SIZE 24
-#elif defined(CRYPTO_AES)
-    #define CIPHER_MAX_CONTEXT_SIZE CIPHERS_MAX_KEY_SIZE
 #else
 /* 0 is not a possibility because 0-sized arrays are not allowed in ISO C */
     #define CIPHER_MAX_CONTEXT_SIZE 1
@@ -72,7 +74,8 @@ extern "C" {
  * @brief   the context for cipher-operations
  */
 typedef struct {
-    uint8_t context[CIPHER_MAX_CONTEXT_SIZE];  /**< buffer for cipher operations */
+    /** buffer for cipher operations, aligned for ciphers keeping words */
+    uint8_t context[CIPHER_MAX_CONTEXT_SIZE] __attribute__((aligned(4)));
 } cipher_context_t;
 
 
@@ -96,6 +99,16 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t *ctx, const uint8_t *cipher_block,
                    uint8_t *plain_block);
+
+    /** encrypts consecutive blocks, NULL if the cipher has no such function */
+    int (*encrypt_blocks)(const cipher_context_t *ctx,
+                          const uint8_t *plain_blocks, uint8_t *cipher_blocks,
+                          size_t blocks);
+
+    /** decrypts consecutive blocks, NULL if the cipher has no such function */
+    int (*decrypt_blocks)(const cipher_context_t *ctx,
+                          const uint8_t *cipher_blocks, uint8_t *plain_blocks,
+                          size_t blocks);
 } cipher_interface_t;
 
 
@@ -167,6 +180,44 @@ int cipher_encrypt(const cipher_t *cipher, const uint8_t *input, uint8_t *output
 int cipher_decrypt(const cipher_t *cipher, const uint8_t *input, uint8_t *output);
 
 
+/**
+ * @brief Encrypt a number of consecutive blocks
+ *
+ * Uses the multi-block function of the cipher if it has one and calls
+ * cipher_encrypt() for each block otherwise.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p blocks blocks of input data to encrypt
+ * @param output     pointer to allocated memory for encrypted data. It has to
+ *                   be of size @p blocks * BLOCK_SIZE
+ * @param blocks     number of blocks to encrypt
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+
+/**
+ * @brief Decrypt a number of consecutive blocks
+ *
+ * Uses the multi-block function of the cipher if it has one and calls
+ * cipher_decrypt() for each block otherwise.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p blocks blocks of input data to decrypt
+ * @param output     pointer to allocated memory for decrypted data. It has to
+ *                   be of size @p blocks * BLOCK_SIZE
+ * @param blocks     number of blocks to decrypt
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_decrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+
 /**
  * @brief Get block size of cipher
  * *
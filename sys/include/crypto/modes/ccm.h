@@ -37,6 +37,26 @@ extern "C" {
 #define CCM_ERR_INVALID_MAC_LENGTH          (-5)
 /** @} */
 
+/**
+ * @brief   Pre-keyed CCM context
+ *
+ * Holds the parameters that stay the same for many messages, e.g. all frames
+ * sent with one IEEE 802.15.4 key, together with the first MAC and counter
+ * blocks prepared up to the fixed part of the nonce (e.g. the source
+ * address). Only the rest of the nonce is filled in per message.
+ *
+ * The context only references the cipher, which must stay valid while the
+ * context is in use.
+ */
+typedef struct {
+    const cipher_t *cipher;     /**< already initialized cipher */
+    uint8_t b0[16];             /**< B0 with flags and nonce prefix */
+    uint8_t a0[16];             /**< A0 with flags and nonce prefix */
+    uint8_t mac_length;         /**< length of the MAC */
+    uint8_t length_encoding;    /**< length of the length field (L) */
+    uint8_t prefix_len;         /**< length of the fixed nonce prefix */
+} ccm_ctx_t;
+
 /**
  * @brief Encrypt and authenticate data of arbitrary length in ccm mode.
  *
@@ -93,6 +113,80 @@ int cipher_decrypt_ccm(cipher_t* cipher,
                        const uint8_t* input, size_t input_len,
                        uint8_t* output);
 
+/**
+ * @brief Initialize a pre-keyed CCM context
+ *
+ * The parameters are checked once here instead of for every message.
+ *
+ * @param ctx              context to initialize
+ * @param cipher           Already initialized cipher struct
+ * @param mac_length       length of the appended MAC (between 4 and 16 - only
+ *                         even values)
+ * @param length_encoding  maximal supported length of plaintext
+ *                         (2^(8*length_enc)).
+ * @param nonce_prefix     part of the nonce that is the same for all messages
+ * @param prefix_len       length of @p nonce_prefix
+ *                         (maximum: 15-length_encoding)
+ *
+ * @return                 0 on success
+ * @return                 A negative error code if a parameter is invalid
+ */
+int ccm_ctx_init(ccm_ctx_t *ctx, const cipher_t *cipher, uint8_t mac_length,
+                 uint8_t length_encoding, const uint8_t *nonce_prefix,
+                 size_t prefix_len);
+
+/**
+ * @brief Encrypt and authenticate a message with a pre-keyed CCM context
+ *
+ * Same as cipher_encrypt_ccm() with the nonce being the prefix given to
+ * ccm_ctx_init() followed by @p nonce_tail.
+ *
+ * @param ctx              initialized context
+ * @param nonce_tail       rest of the nonce
+ * @param tail_len         length of @p nonce_tail
+ *                         (maximum: 15-length_encoding-prefix_len)
+ * @param auth_data        Additional data to authenticate in MAC
+ * @param auth_data_len    Length of additional data
+ * @param input            pointer to input data to encrypt
+ * @param input_len        length of the input data
+ * @param output           pointer to allocated memory for encrypted data. It
+ *                         has to be of size data_len + mac_length. May be the
+ *                         same as @p input.
+ *
+ * @return                 Length of encrypted data on a successful encryption
+ * @return                 A negative error code if something went wrong
+ */
+int ccm_ctx_encrypt(const ccm_ctx_t *ctx,
+                    const uint8_t *nonce_tail, size_t tail_len,
+                    const uint8_t *auth_data, uint32_t auth_data_len,
+                    const uint8_t *input, size_t input_len, uint8_t *output);
+
+/**
+ * @brief Decrypt and verify a message with a pre-keyed CCM context
+ *
+ * Same as cipher_decrypt_ccm() with the nonce being the prefix given to
+ * ccm_ctx_init() followed by @p nonce_tail.
+ *
+ * @param ctx              initialized context
+ * @param nonce_tail       rest of the nonce
+ * @param tail_len         length of @p nonce_tail
+ *                         (maximum: 15-length_encoding-prefix_len)
+ * @param auth_data        Additional data to authenticate in MAC
+ * @param auth_data_len    Length of additional data
+ * @param input            pointer to input data to decrypt
+ * @param input_len        length of the input data
+ * @param output           pointer to allocated memory for decrypted data. It
+ *                         has to be of size data_len - mac_length. May be the
+ *                         same as @p input.
+ *
+ * @return                 Length of the decrypted data on a successful decryption
+ * @return                 A negative error code if something went wrong
+ */
+int ccm_ctx_decrypt(const ccm_ctx_t *ctx,
+                    const uint8_t *nonce_tail, size_t tail_len,
+                    const uint8_t *auth_data, uint32_t auth_data_len,
+                    const uint8_t *input, size_t input_len, uint8_t *output);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_mpscq Lock-free multiple producer single consumer queue
+ * @ingroup     sys
+ * @brief       Lock-free intrusive FIFO for any number of producers, threads
+ *              and ISRs alike, and one consumer
+ *
+ * The queue links nodes that are embedded in the caller's records, so
+ * putting a record never copies it and never fails.
+ *
+ * Producers push onto a shared list with a compare-and-swap, so they never
+ * disable interrupts and never wait for each other for more than a retry.
+ * The consumer takes the whole shared list at once with an atomic exchange
+ * and reverses it into a private list, from which it pops records in the
+ * order they were put. As the shared list is always consistent, a producer
+ * that gets preempted never hides records put by others.
+ *
+ * mpscq_get_blocking() waits for a record with
+ * @ref core_thread_flags "thread flags". The producer sets the flag given to
+ * mpscq_init() for the waiting consumer.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Lock-free multiple producer single consumer queue definitions
+ */
+
+#ifndef MPSCQ_H
+#define MPSCQ_H
+
+#include <stdint.h>
+/* The stdatomic.h in GCC gives compilation errors with C++
+ * see: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=60932
+ */
+#ifdef __cplusplus
+#include <atomic>
+using std::atomic_uintptr_t;
+#else
+#include <stdatomic.h>
+#endif
+
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Queue node, to be embedded into the records
+ */
+typedef struct mpscq_node {
+    struct mpscq_node *next;    /**< next node */
+} mpscq_node_t;
+
+/**
+ * @brief   Multiple producer single consumer queue
+ */
+typedef struct {
+    atomic_uintptr_t shared;    /**< nodes put since the consumer last took
+                                     them, newest first */
+    mpscq_node_t *local;        /**< nodes taken by the consumer, oldest
+                                     first */
+    atomic_uintptr_t waiter;    /**< consumer waiting for a node */
+    thread_flags_t flag;        /**< flag to wake the consumer with */
+} mpscq_t;
+
+/**
+ * @brief   Initialize a queue
+ *
+ * @param[out]  q       queue to initialize
+ * @param[in]   flag    thread flag to wake a blocked consumer with
+ */
+void mpscq_init(mpscq_t *q, thread_flags_t flag);
+
+/**
+ * @brief   Put a node into the queue (producer)
+ *
+ * May be called from any thread or ISR. Wakes the consumer if it is blocked.
+ *
+ * @param[in]   q       queue
+ * @param[in]   node    node to put, must not be in a queue
+ */
+void mpscq_put(mpscq_t *q, mpscq_node_t *node);
+
+/**
+ * @brief   Get the oldest node from the queue (consumer)
+ *
+ * @param[in]   q       queue
+ *
+ * @return  the oldest node
+ * @return  NULL if the queue is empty
+ */
+mpscq_node_t *mpscq_get(mpscq_t *q);
+
+/**
+ * @brief   Get the oldest node from the queue, wait for one if the queue is
+ *          empty (consumer)
+ *
+ * @param[in]   q       queue
+ *
+ * @return  the oldest node
+ */
+mpscq_node_t *mpscq_get_blocking(mpscq_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPSCQ_H */
+/** @} */
@@ -35,10 +35,34 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+/**
+ * @brief Node of the prefix trie indexing a FIB table
+ *
+ * Nodes are stored inside the @ref fib_entry_t array of the table, each
+ * entry provides storage for two nodes which is sufficient for a path
+ * compressed binary trie holding all entries.
+ */
+typedef struct fib_trie_node {
+    /** parent node, NULL for the root */
+    struct fib_trie_node *parent;
+    /** child nodes, indexed by the bit following the prefix */
+    struct fib_trie_node *child[2];
+    /** FIB entries with exactly this prefix */
+    struct fib_entry *entries;
+    /** length of the prefix in bits */
+    uint16_t prefix_len;
+    /** node storage is used by the trie */
+    uint8_t in_use;
+    /** prefix of this node, bits beyond prefix_len are 0 */
+    uint8_t key[UNIVERSAL_ADDRESS_SIZE];
+} fib_trie_node_t;
+#endif
+
 /**
  * @brief Container descriptor for a FIB entry
  */
-typedef struct {
+typedef struct fib_entry {
     /** interface ID */
     kernel_pid_t iface_id;
     /** Lifetime of this entry (an absolute time-point is stored by the FIB) */
@@ -51,6 +75,14 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+    /** trie node this entry is attached to */
+    fib_trie_node_t *trie_node;
+    /** next entry attached to the same trie node */
+    struct fib_entry *trie_next;
+    /** storage lent to the trie of the table */
+    fib_trie_node_t trie_nodes[2];
+#endif
 } fib_entry_t;
 
 /**
@@ -133,6 +165,13 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+    /** root of the prefix trie indexing the single hop entries */
+    fib_trie_node_t *trie_root;
+    /** earliest absolute lifetime of all entries, expired entries are swept
+     *  from the table once this point in time has passed */
+    uint64_t next_expiry;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
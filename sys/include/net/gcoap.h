@@ -24,6 +24,11 @@
  * port, which supports RFC 6282 compression. Internally, gcoap depends on the
  * nanocoap package for base level structs and functionality.
  *
+ * With the `gcoap_event` module, gcoap does not allocate a thread of its own.
+ * Instead, the application calls gcoap_init_event() with an @ref sys_event
+ * queue that its own thread serves, so gcoap can share this thread with other
+ * protocols (see @ref net_sock_async_event).
+ *
  * gcoap supports the Observe extension (RFC 7641) for a server. gcoap provides
  * functions to generate and send an observe notification that are similar to
  * the functions to send a client request. gcoap also supports the Block
@@ -338,6 +343,9 @@
 
 #include <stdint.h>
 
+#ifdef MODULE_GCOAP_EVENT
+#include "event/timeout.h"
+#endif
 #include "net/ipv6/addr.h"
 #include "net/sock/udp.h"
 #include "net/nanocoap.h"
@@ -355,6 +363,8 @@ extern "C" {
  */
 /**
  * @brief  Size for module message queue
+ *
+ * @note    Not used with the `gcoap_event` module.
  */
 #ifndef GCOAP_MSG_QUEUE_SIZE
 #define GCOAP_MSG_QUEUE_SIZE    (4)
@@ -456,6 +466,8 @@ extern "C" {
 /**
  * @ingroup net_gcoap_conf
  * @brief   Time in usec that the event loop waits for an incoming CoAP message
+ *
+ * @note    Not used with the `gcoap_event` module.
  */
 #ifndef GCOAP_RECV_TIMEOUT
 #define GCOAP_RECV_TIMEOUT      (1 * US_PER_SEC)
@@ -487,6 +499,8 @@ extern "C" {
 
 /**
  * @brief   Identifies waiting timed out for a response to a sent message
+ *
+ * @note    Not used with the `gcoap_event` module.
  */
 #define GCOAP_MSG_TYPE_TIMEOUT  (0x1501)
 
@@ -495,6 +509,8 @@ extern "C" {
  *          on a sock
  *
  * Allows the event loop to process IPC messages.
+ *
+ * @note    Not used with the `gcoap_event` module.
  */
 #define GCOAP_MSG_TYPE_INTR     (0x1502)
 
@@ -658,8 +674,13 @@ typedef struct {
                                              supports resending message */
     sock_udp_ep_t remote_ep;            /**< Remote endpoint */
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
+#ifdef MODULE_GCOAP_EVENT
+    event_timeout_t response_timer;     /**< Limits wait for response */
+    event_t timeout_event;              /**< Posted by response timer */
+#else
     xtimer_t response_timer;            /**< Limits wait for response */
     msg_t timeout_msg;                  /**< For response timer */
+#endif
 } gcoap_request_memo_t;
 
 /**
@@ -672,16 +693,41 @@ typedef struct {
     unsigned token_len;                 /**< Actual length of token attribute */
 } gcoap_observe_memo_t;
 
+#if !defined(MODULE_GCOAP_EVENT) || defined(DOXYGEN)
 /**
  * @brief   Initializes the gcoap thread and device
  *
  * Must call once before first use.
  *
+ * @note    Not available with the `gcoap_event` module, use gcoap_init_event()
+ *          instead.
+ *
  * @return  PID of the gcoap thread on success.
  * @return  -EEXIST, if thread already has been created.
  * @return  -EINVAL, if the IP port already is in use.
  */
 kernel_pid_t gcoap_init(void);
+#endif
+
+#if defined(MODULE_GCOAP_EVENT) || defined(DOXYGEN)
+/**
+ * @brief   Initializes gcoap on an event queue served by the caller
+ *
+ * Must call once before first use, instead of gcoap_init(). All messaging of
+ * gcoap, including calls of the resource and response handlers, then happens
+ * in the thread serving @p queue, so its stack must be at least
+ * @ref GCOAP_STACK_SIZE.
+ *
+ * @pre `queue != NULL`
+ *
+ * @param[in] queue     Event queue to handle gcoap's events on.
+ *
+ * @return  0 on success.
+ * @return  -EEXIST, if gcoap already has been initialized.
+ * @return  -EADDRINUSE, if the IP port already is in use.
+ */
+int gcoap_init_event(event_queue_t *queue);
+#endif
 
 /**
  * @brief   Starts listening for resource paths
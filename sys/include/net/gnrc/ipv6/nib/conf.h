@@ -266,6 +266,39 @@ extern "C" {
 #define GNRC_IPV6_NIB_OFFL_NUMOF            (8)
 #endif
 
+/**
+ * @brief   Number of buckets of the hash index over the on-link entries
+ *
+ * Lets neighbor cache lookups scale to a large @ref GNRC_IPV6_NIB_NUMOF.
+ * 0 disables the index, on-link entries are then searched linearly.
+ */
+#ifndef GNRC_IPV6_NIB_ONL_HASH_NUMOF
+#if GNRC_IPV6_NIB_NUMOF >= 32
+#define GNRC_IPV6_NIB_ONL_HASH_NUMOF        (GNRC_IPV6_NIB_NUMOF / 2)
+#else
+#define GNRC_IPV6_NIB_ONL_HASH_NUMOF        (0)
+#endif
+#endif
+
+/**
+ * @brief   Number of entries in the route cache
+ *
+ * The route cache remembers which off-link entry best matches a destination,
+ * so routing further packets to it does not need to search all off-link
+ * entries. It is flushed whenever an off-link entry is added or removed.
+ * 0 disables the route cache.
+ *
+ * @note    Not to be confused with the destination cache of
+ *          @ref GNRC_IPV6_NIB_CONF_DC.
+ */
+#ifndef GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+#if GNRC_IPV6_NIB_OFFL_NUMOF >= 32
+#define GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF     (8)
+#else
+#define GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF     (0)
+#endif
+#endif
+
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C || defined(DOXYGEN)
 /**
  * @brief   Number of authoritative border router entries in NIB
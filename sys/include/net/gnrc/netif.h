@@ -59,6 +59,15 @@
 extern "C" {
 #endif
 
+/**
+ * @name    Device interrupt states of gnrc_netif_t::rx_isr
+ * @{
+ */
+#define GNRC_NETIF_RX_ISR_IDLE      (0U)    /**< device not served by the thread */
+#define GNRC_NETIF_RX_ISR_SERVING   (1U)    /**< thread calls netdev_driver_t::isr() */
+#define GNRC_NETIF_RX_ISR_PENDING   (2U)    /**< device interrupted while served */
+/** @} */
+
 /**
  * @brief   Operations to an interface
  */
@@ -112,6 +121,24 @@ typedef struct {
 #endif
 #if defined(MODULE_GNRC_SIXLOWPAN) || DOXYGEN
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
+#endif
+#if defined(MODULE_GNRC_NETIF_RX_BATCH) || DOXYGEN
+    /**
+     * @brief   Number of packets received since the last device interrupt
+     *
+     * @note    Only available with the `gnrc_netif_rx_batch` module.
+     */
+    uint16_t rx_batch;
+    /**
+     * @brief   Device interrupt state while the thread serves the device
+     *
+     * While the interface thread calls netdev_driver_t::isr(), further
+     * interrupts of the device only set this to
+     * @ref GNRC_NETIF_RX_ISR_PENDING instead of queueing another message.
+     *
+     * @note    Only available with the `gnrc_netif_rx_batch` module.
+     */
+    volatile uint8_t rx_isr;
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
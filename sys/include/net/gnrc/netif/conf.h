@@ -57,6 +57,22 @@ extern "C" {
 #define GNRC_NETIF_MSG_QUEUE_SIZE  (16U)
 #endif
 
+/**
+ * @brief   Maximum number of device interrupts served per wake-up
+ *
+ * With the `gnrc_netif_rx_batch` module the interface thread serves device
+ * interrupts raised while it calls netdev_driver_t::isr() right away,
+ * instead of queueing a message for each of them, until no further interrupt
+ * is pending or this budget is used up. If the budget is used up the thread
+ * serves the pending interrupt after the messages already in its queue are
+ * handled.
+ *
+ * @note    Only used with the `gnrc_netif_rx_batch` module.
+ */
+#ifndef GNRC_NETIF_RX_BUDGET
+#define GNRC_NETIF_RX_BUDGET       (8U)
+#endif
+
 /**
  * @brief   Number of multicast addresses needed for @ref net_gnrc_rpl "RPL".
  *
@@ -72,6 +72,18 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of slots in the hash table of the registry
+ *
+ * @note    Only used with the `gnrc_netreg_hash` module. Each distinct pair of
+ *          @ref gnrc_nettype_t and gnrc_netreg_entry_t::demux_ctx occupies a
+ *          slot, entries sharing both are stored in the same slot. Must be a
+ *          power of 2.
+ */
+#ifndef GNRC_NETREG_HASH_SIZE
+#define GNRC_NETREG_HASH_SIZE       (32U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -311,6 +323,9 @@ static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
  *
  * @return  0 on success
  * @return  -EINVAL if @p type was < GNRC_NETTYPE_UNDEF or >= GNRC_NETTYPE_NUMOF
+ * @return  -ENOMEM if the `gnrc_netreg_hash` module is used and all
+ *          @ref GNRC_NETREG_HASH_SIZE slots are occupied by other types or
+ *          demux contexts
  */
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry);
 
@@ -58,6 +58,83 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Pool sizes of the `gnrc_pktbuf_slab` packet buffer
+ *
+ * The `gnrc_pktbuf_slab` implementation keeps packet snips and packet data in
+ * separate pools of fixed size blocks instead of one @ref GNRC_PKTBUF_SIZE
+ * large buffer, so allocating and freeing take constant time and the buffer
+ * can't fragment. Data goes to the smallest block size it fits in, or to a
+ * larger one if all of those are used. Data larger than
+ * @ref GNRC_PKTBUF_SLAB_LARGE_SIZE can't be allocated.
+ *
+ * The defaults take about as much memory as the default
+ * @ref GNRC_PKTBUF_SIZE. Block sizes must be multiples of 4.
+ * @{
+ */
+#ifndef GNRC_PKTBUF_SLAB_SNIPS
+#define GNRC_PKTBUF_SLAB_SNIPS          (40)    /**< number of packet snips */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define GNRC_PKTBUF_SLAB_SMALL_SIZE     (32)    /**< size of small blocks,
+                                                     e.g. for headers */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define GNRC_PKTBUF_SLAB_SMALL_NUMOF    (16)    /**< number of small blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_SIZE
+#define GNRC_PKTBUF_SLAB_MEDIUM_SIZE    (128)   /**< size of medium blocks,
+                                                     e.g. for 802.15.4 frames */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_NUMOF
+#define GNRC_PKTBUF_SLAB_MEDIUM_NUMOF   (16)    /**< number of medium blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_SIZE
+#define GNRC_PKTBUF_SLAB_LARGE_SIZE     (1536)  /**< size of large blocks,
+                                                     e.g. for Ethernet frames */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define GNRC_PKTBUF_SLAB_LARGE_NUMOF    (2)     /**< number of large blocks */
+#endif
+/** @} */
+
+/**
+ * @brief   Headroom to reserve in front of the payload of an outgoing packet
+ *
+ * Enough for a UDP and an IPv6 header and some extension headers or 6LoWPAN
+ * dispatches. See gnrc_pktbuf_add_headroom().
+ */
+#ifndef GNRC_PKTBUF_TX_HEADROOM
+#define GNRC_PKTBUF_TX_HEADROOM     (64U)
+#endif
+
+#if defined(MODULE_GNRC_PKTBUF_COUNTERS) || defined(DOXYGEN)
+/**
+ * @brief   Packet buffer counters
+ *
+ * @note    Only available with the `gnrc_pktbuf_counters` module.
+ */
+typedef struct {
+    uint32_t allocs;        /**< allocations of packet snips and data */
+    uint32_t headroom;      /**< headers put into headroom instead of
+                             *   allocating data for them */
+    uint32_t copied;        /**< bytes copied by the packet buffer */
+} gnrc_pktbuf_counters_t;
+
+/**
+ * @brief   The packet buffer counters, may be reset by the user
+ */
+extern gnrc_pktbuf_counters_t gnrc_pktbuf_counters;
+
+/**
+ * @brief   Adds @p n to counter @p field
+ * @internal
+ */
+#define GNRC_PKTBUF_COUNT(field, n) (gnrc_pktbuf_counters.field += (n))
+#else
+#define GNRC_PKTBUF_COUNT(field, n) (void)0
+#endif
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -87,6 +164,70 @@ void gnrc_pktbuf_init(void);
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
                                 gnrc_nettype_t type);
 
+/**
+ * @brief   Adds a new gnrc_pktsnip_t and reserves headroom in front of its
+ *          data
+ *
+ * Meant for the payload of outgoing packets: as long as the headroom
+ * suffices, gnrc_pktbuf_add_header() with the returned snip (or a header
+ * added in front of it this way) as @p next puts the new header's data
+ * directly in front of the data of @p next instead of allocating it. The
+ * headers and the payload then end up in one contiguous piece of memory.
+ * Releasing the header in front returns its space to the headroom.
+ *
+ * @note    Only `gnrc_pktbuf_slab` reserves headroom, the other
+ *          implementations behave like gnrc_pktbuf_add(). It reserves at most
+ *          what is left of the smallest block class @p size fits into.
+ *
+ * @param[in] next      Next gnrc_pktsnip_t in the packet. Leave NULL if you
+ *                      want to create a new packet.
+ * @param[in] data      Data of the new gnrc_pktsnip_t. If @p data is NULL no data
+ *                      will be inserted into `result`.
+ * @param[in] size      Length of @p data.
+ * @param[in] headroom  Bytes to reserve in front of the data, e.g.
+ *                      @ref GNRC_PKTBUF_TX_HEADROOM
+ * @param[in] type      Protocol type of the gnrc_pktsnip_t.
+ *
+ * @return  Pointer to the packet part that represents the new gnrc_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, const void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type);
+
+/**
+ * @brief   Adds a new header in front of @p next, in its headroom if there
+ *          is enough
+ *
+ * Used by the protocols that build the headers of outgoing packets.
+ * gnrc_pktbuf_add() always allocates the data of a new snip.
+ *
+ * @note    Only `gnrc_pktbuf_slab` has headroom, the other implementations
+ *          behave like gnrc_pktbuf_add().
+ *
+ * @param[in] next      Next gnrc_pktsnip_t in the packet, e.g. the payload
+ *                      added with gnrc_pktbuf_add_headroom().
+ * @param[in] data      Data of the new gnrc_pktsnip_t. If @p data is NULL no data
+ *                      will be inserted into `result`.
+ * @param[in] size      Length of @p data.
+ * @param[in] type      Protocol type of the gnrc_pktsnip_t.
+ *
+ * @return  Pointer to the packet part that represents the new gnrc_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_add_header(gnrc_pktsnip_t *next, const void *data,
+                                       size_t size, gnrc_nettype_t type);
+
+/**
+ * @brief   Gets the headroom available in front of the data of @p pkt
+ *
+ * @param[in] pkt   A packet snip.
+ *
+ * @return  Number of bytes gnrc_pktbuf_add_header() can put in front of the
+ *          data of @p pkt without allocating.
+ */
+size_t gnrc_pktbuf_headroom(const gnrc_pktsnip_t *pkt);
+
 /**
  * @brief   Marks the first @p size bytes in a received packet with a new
  *          packet snip that is appended to the packet.
@@ -289,7 +430,8 @@ int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt);
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include the number of bytes in use, its high-water
+ *          mark and how fragmented the free space is.
  */
 void gnrc_pktbuf_stats(void);
 #endif
@@ -97,6 +97,29 @@ extern "C" {
 #define GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE    (1)
 #endif
 
+/**
+ * @brief   Number of hash buckets of the reassembly buffer
+ *
+ * @note    Only applicable with the `gnrc_sixlowpan_frag_rbuf_hash` module.
+ *          Must be a power of 2.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS
+#define GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS    (8U)
+#endif
+
+/**
+ * @brief   Maximum datagram size the reassembly buffer accepts
+ *
+ * @note    Only applicable with the `gnrc_sixlowpan_frag_rbuf_hash` module.
+ *
+ * Each reassembly buffer entry tracks the received fragments in two bitmaps
+ * with one bit per 8 byte unit of this size. Fragments of larger datagrams
+ * are dropped. Defaults to the IPv6 minimum MTU.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RBUF_DATAGRAM_MAX
+#define GNRC_SIXLOWPAN_FRAG_RBUF_DATAGRAM_MAX   (1280U)
+#endif
+
 /**
  * @brief   Registration lifetime in minutes for the address registration option
  *
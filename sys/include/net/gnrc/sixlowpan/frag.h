@@ -14,6 +14,15 @@
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
+ *
+ * The reassembly buffer is searched linearly by default. For nodes that
+ * reassemble datagrams from many peers at once, e.g. border routers, the
+ * `gnrc_sixlowpan_frag_rbuf_hash` module indexes the entries by a hash over
+ * (source, destination, tag, size). It also tracks received fragments in
+ * per-entry bitmaps and evicts the least recently used entry when the buffer
+ * is full. See @ref GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS and
+ * @ref GNRC_SIXLOWPAN_FRAG_RBUF_DATAGRAM_MAX for its configuration. The
+ * module can't be combined with `gnrc_sixlowpan_frag_vrb`.
  * @{
  *
  * @file
@@ -87,6 +96,13 @@ typedef struct {
                              *   reassembly buffer is full */
     unsigned frag_full;     /**< counts the number of events that there where
                              *   no @ref gnrc_sixlowpan_msg_frag_t available */
+    unsigned rbuf_hit;      /**< counts the number of fragments that belonged
+                             *   to an existing reassembly buffer entry */
+    unsigned rbuf_miss;     /**< counts the number of fragments that required
+                             *   a new reassembly buffer entry */
+    unsigned rbuf_evict;    /**< counts the number of reassembly buffer
+                             *   entries that were removed to make room for a
+                             *   new datagram */
 #if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || DOXYGEN
     unsigned vrb_full;      /**< counts the number of events where the virtual
                              *   reassembly buffer is full */
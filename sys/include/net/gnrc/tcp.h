@@ -121,20 +121,25 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  * @pre @p tcb must not be NULL.
  * @pre @p data must not be NULL.
  *
- * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ * @note Blocks until all @p len bytes were acknowledged by the peer, the user timeout
+ *       expired or an error occured.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
  * @param[in]     len                        Number of bytes that should be transmitted.
- * @param[in]     user_timeout_duration_us   If not zero and there was not data transmitted
- *                                           the function returns after user_timeout_duration_us.
+ * @param[in]     user_timeout_duration_us   If not zero, the function returns after
+ *                                           user_timeout_duration_us, even if not all data
+ *                                           was acknowledged. Data that was sent but not
+ *                                           acknowledged by then is dropped.
  *                                           If zero, no timeout will be triggered.
  *
- * @returns   The number of successfully transmitted bytes.
+ * @returns   The number of bytes acknowledged by the peer. This is less than @p len if
+ *            @p user_timeout_duration_us expired after a part of the data was acknowledged.
  *            -ENOTCONN if connection is not established.
  *            -ECONNRESET if connection was resetted by the peer.
  *            -ECONNABORTED if the connection was aborted.
- *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired before any data was
+ *            acknowledged.
  */
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
@@ -189,6 +194,25 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
  */
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb);
 
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief Set an event callback for a TCP connection.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note @p cb is called from the TCP thread with the TCB locked, so it must
+ *       not call any function on @p tcb but only signal the event, e.g. by
+ *       posting it to an event queue (see @ref net_sock_async_event).
+ *       Data already waiting in @p tcb is reported to @p cb right away.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     cb    Event callback. May be NULL to unset the callback.
+ * @param[in]     arg   Argument to provide to @p cb.
+ */
+void gnrc_tcp_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cb_t cb, void *arg);
+#endif
+
 /**
  * @brief Calculate and set checksum in TCP header.
  *
@@ -79,6 +79,33 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Maximum number of segments in flight (sent, but not yet acknowledged)
+ *        per connection
+ *
+ * Each of them stays in the packet buffer until it is acknowledged. The
+ * number of bytes in flight is further limited by the peers receive window
+ * and the congestion window.
+ */
+#ifndef GNRC_TCP_SND_QUEUE_SIZE
+#define GNRC_TCP_SND_QUEUE_SIZE (4U)
+#endif
+
+/**
+ * @brief Number of segments received out of order that are kept per
+ *        connection until the data in front of them arrived
+ */
+#ifndef GNRC_TCP_RCV_OOO_QUEUE_SIZE
+#define GNRC_TCP_RCV_OOO_QUEUE_SIZE (2U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUP_ACK_THRESHOLD
+#define GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
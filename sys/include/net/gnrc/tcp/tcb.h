@@ -30,6 +30,10 @@
 #include "net/gnrc/pkt.h"
 #include "config.h"
 
+#ifdef MODULE_SOCK_ASYNC
+#include "net/sock/async/types.h"
+#endif
+
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
 #endif
@@ -43,6 +47,24 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+struct _transmission_control_block;
+
+/**
+ * @brief Event callback for a TCB
+ *
+ * @param[in] tcb    The TCB the event happened on.
+ * @param[in] flags  The event flags. Expected values are
+ *                   - @ref SOCK_ASYNC_CONN_RDY,
+ *                   - @ref SOCK_ASYNC_CONN_FIN,
+ *                   - @ref SOCK_ASYNC_MSG_RECV,
+ *                   - @ref SOCK_ASYNC_MSG_SENT
+ * @param[in] arg    Argument provided when setting the callback.
+ */
+typedef void (*gnrc_tcp_cb_t)(struct _transmission_control_block *tcb,
+                              sock_async_flags_t flags, void *arg);
+#endif
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -67,20 +89,31 @@ typedef struct _transmission_control_block {
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< AckNo. that ends the running rtt estimation */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_pktsnip_t *rtx_queue[GNRC_TCP_SND_QUEUE_SIZE]; /**< Sent, unacknowledged packets */
+    uint8_t rtx_head;      /**< Index of the oldest packet in rtx_queue */
+    uint8_t rtx_len;       /**< Number of packets in rtx_queue */
+    gnrc_pktsnip_t *rcv_ooo[GNRC_TCP_RCV_OOO_QUEUE_SIZE]; /**< Packets received out of order */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+    gnrc_tcp_cb_t async_cb;  /**< Event callback, called by the FSM */
+    void *async_cb_arg;      /**< Argument for async_cb */
+#endif
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
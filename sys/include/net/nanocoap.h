@@ -69,6 +69,12 @@
  * and exact matching should be register, and then a second one with the path
  * `/resource01/` and subtree matching.
  *
+ * Resources are matched by comparing their paths with the URI-path one after
+ * the other. With many resources, the `nanocoap_resource_index` module keeps a
+ * hash index over the resource paths instead, see
+ * coap_resource_index_find(). Both nanocoap's coap_handle_req() and gcoap
+ * use the index if the module is present.
+ *
  * @{
  *
  * @file
@@ -147,6 +153,26 @@ extern "C" {
 #define NANOCOAP_BLOCK_SIZE_EXP_MAX  (6)
 #endif
 
+#if defined(MODULE_NANOCOAP_RESOURCE_INDEX) || defined(DOXYGEN)
+/**
+ * @brief    Maximum number of resources a resource index can hold
+ *
+ * Only used with the `nanocoap_resource_index` module.
+ */
+#ifndef NANOCOAP_RESOURCE_INDEX_SIZE
+#define NANOCOAP_RESOURCE_INDEX_SIZE    (32U)
+#endif
+
+/**
+ * @brief    Number of hash buckets of a resource index, must be a power of 2
+ *
+ * Only used with the `nanocoap_resource_index` module.
+ */
+#ifndef NANOCOAP_RESOURCE_INDEX_BUCKETS
+#define NANOCOAP_RESOURCE_INDEX_BUCKETS (16U)
+#endif
+#endif
+
 #if defined(MODULE_GCOAP) || defined(DOXYGEN)
 /** @brief   Maximum length of a query string written to a message */
 #ifndef NANOCOAP_QS_MAX
@@ -593,6 +619,36 @@ ssize_t coap_opt_get_next(const coap_pkt_t *pkt, coap_optpos_t *opt,
  * @return        -ENOENT if option not found
  */
 ssize_t coap_opt_get_opaque(coap_pkt_t *pkt, unsigned opt_num, uint8_t **value);
+
+/**
+ * @brief   Find the first option with a given number
+ *
+ * @param[in]     pkt         packet to read from
+ * @param[in]     opt_num     option number to look for
+ *
+ * @return        start of the option header
+ * @return        NULL if the option is not present
+ */
+uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num);
+
+/**
+ * @brief   Iterate over the values of a repeated option
+ *
+ * Start with @p first set and @p optpos pointing to the option header
+ * returned by coap_find_option(). Following calls with @p first unset return
+ * the values of the following options with the same number.
+ *
+ * @param[in]     pkt         packet to read from
+ * @param[in,out] optpos      header of the option to read, set to the
+ *                            following option, or to NULL at the end
+ * @param[out]    opt_len     length of the option value
+ * @param[in]     first       nonzero for the first option
+ *
+ * @return        start of the option value
+ * @return        NULL if there is no further option with the same number
+ */
+uint8_t *coap_iterate_option(const coap_pkt_t *pkt, uint8_t **optpos,
+                             int *opt_len, int first);
 /**@}*/
 
 
@@ -1413,6 +1469,110 @@ extern ssize_t coap_well_known_core_default_handler(coap_pkt_t *pkt, \
  */
 int coap_match_path(const coap_resource_t *resource, uint8_t *uri);
 
+/**
+ * @brief   Checks if a CoAP resource path matches the URI path of a request
+ *
+ * Same as coap_match_path(), but compares with the Uri-Path options of
+ * @p pkt in place instead of with a copy of the URI path.
+ *
+ * @note This function is not intended for application use.
+ * @internal
+ *
+ * @param[in] resource CoAP resource to check
+ * @param[in] pkt      Parsed request
+ *
+ * @return the same values as coap_match_path()
+ */
+int coap_match_path_pkt(const coap_resource_t *resource, const coap_pkt_t *pkt);
+
+#if defined(MODULE_NANOCOAP_RESOURCE_INDEX) || defined(DOXYGEN)
+/**
+ * @name    Functions -- Resource index
+ *
+ * Hash index over the paths of registered resources, so a request can be
+ * dispatched without comparing its URI path with every resource. Resources
+ * with exact path matching are looked up by the hash of their path, resources
+ * with @ref COAP_MATCH_SUBTREE are kept in a list that is always checked.
+ *
+ * A lookup returns the same resource as the linear search over all resources
+ * in the order they were added.
+ */
+/**@{*/
+/**
+ * @brief   Resource index entry
+ */
+typedef struct {
+    const coap_resource_t *resource;    /**< indexed resource               */
+    void *owner;                        /**< resource collection, e.g. the
+                                             gcoap listener                 */
+    uint32_t hash;                      /**< hash of the resource path      */
+    uint16_t next;                      /**< next entry of the same bucket
+                                             plus 1, 0 for none             */
+} coap_resource_index_entry_t;
+
+/**
+ * @brief   Resource index
+ *
+ * A zero initialized index is empty.
+ */
+typedef struct {
+    coap_resource_index_entry_t entries[NANOCOAP_RESOURCE_INDEX_SIZE];
+                                                /**< entries in the order
+                                                     they were added        */
+    uint16_t buckets[NANOCOAP_RESOURCE_INDEX_BUCKETS];
+                                                /**< first entry of each
+                                                     bucket plus 1          */
+    uint16_t subtree;                           /**< first subtree entry
+                                                     plus 1                 */
+    uint16_t numof;                             /**< number of entries      */
+} coap_resource_index_t;
+
+/**
+ * @brief   Empty a resource index
+ *
+ * @param[out]  index       resource index
+ */
+void coap_resource_index_init(coap_resource_index_t *index);
+
+/**
+ * @brief   Add resources to a resource index
+ *
+ * Resources added later have lower precedence than resources added before,
+ * in the same way as resources further down in a linear search.
+ *
+ * @param[in,out] index     resource index
+ * @param[in]   resources   resources to add
+ * @param[in]   numof       number of resources
+ * @param[in]   owner       collection the resources belong to, given back by
+ *                          coap_resource_index_find()
+ *
+ * @returns     0 on success
+ * @returns     -ENOMEM if @p index has no room for @p numof more resources,
+ *              no resource is added in that case
+ */
+int coap_resource_index_add(coap_resource_index_t *index,
+                            const coap_resource_t *resources, size_t numof,
+                            void *owner);
+
+/**
+ * @brief   Find the resource for a request
+ *
+ * @param[in]   index       resource index
+ * @param[in]   pkt         parsed request
+ * @param[in]   method_flag method of the request, see coap_method2flag()
+ * @param[out]  entry       index entry of the resource found
+ *
+ * @returns     0 if a resource for the path and method was found
+ * @returns     -EPERM if resources match the path, but not the method
+ * @returns     -ENOENT if no resource matches the path
+ */
+int coap_resource_index_find(const coap_resource_index_t *index,
+                             const coap_pkt_t *pkt,
+                             coap_method_flags_t method_flag,
+                             const coap_resource_index_entry_t **entry);
+/**@}*/
+#endif
+
 #if defined(MODULE_GCOAP) || defined(DOXYGEN)
 /**
  * @name    Functions -- gcoap specific
@@ -51,6 +51,14 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+#if defined(MODULE_GNRC_NETIF_RX_BATCH) || defined(DOXYGEN)
+    uint32_t rx_batches;        /**< wake-ups that received at least one
+                                     packet, only with `gnrc_netif_rx_batch` */
+    uint32_t rx_batch_max;      /**< most packets received in one wake-up,
+                                     only with `gnrc_netif_rx_batch` */
+    uint32_t rx_budget_exhausted; /**< wake-ups that hit the receive budget,
+                                       only with `gnrc_netif_rx_batch` */
+#endif
 } netstats_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async  Asynchronous sock
+ * @ingroup     net_sock
+ * @brief       Event callbacks for sock objects
+ *
+ * With the `sock_async` module, a callback can be set on a sock object. The
+ * network stack calls it whenever an event happens on the sock, e.g. when a
+ * message was received, so a single thread can serve many sock objects
+ * without blocking on any of them.
+ *
+ * The callback is called from the context of the network stack, so it must
+ * not block and should only signal the event to the thread handling it.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous sock definitions
+ */
+#ifndef NET_SOCK_ASYNC_H
+#define NET_SOCK_ASYNC_H
+
+#include "net/sock/async/types.h"
+
+#ifdef MODULE_SOCK_IP
+#include "net/sock/ip.h"
+#endif
+#ifdef MODULE_SOCK_TCP
+#include "net/sock/tcp.h"
+#endif
+#ifdef MODULE_SOCK_UDP
+#include "net/sock/udp.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_SOCK_IP) || defined(DOXYGEN)
+/**
+ * @brief   Sets event callback for @ref sock_ip_t
+ *
+ * Messages already waiting in @p sock are reported to @p cb right away.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object.
+ * @param[in] cb        An event callback. May be NULL to unset event
+ *                      callback.
+ * @param[in] cb_arg    Argument to provide to @p cb.
+ */
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *cb_arg);
+#endif  /* defined(MODULE_SOCK_IP) || defined(DOXYGEN) */
+
+#if defined(MODULE_SOCK_TCP) || defined(DOXYGEN)
+/**
+ * @brief   Sets event callback for @ref sock_tcp_t
+ *
+ * Messages already waiting in @p sock are reported to @p cb right away.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock      A TCP sock object.
+ * @param[in] cb        An event callback. May be NULL to unset event
+ *                      callback.
+ * @param[in] cb_arg    Argument to provide to @p cb.
+ */
+void sock_tcp_set_cb(sock_tcp_t *sock, sock_tcp_cb_t cb, void *cb_arg);
+
+/**
+ * @brief   Sets event callback for @ref sock_tcp_queue_t
+ *
+ * Connections already waiting in @p queue are reported to @p cb right away.
+ *
+ * @pre `(queue != NULL)`
+ *
+ * @param[in] queue     A TCP listening queue.
+ * @param[in] cb        An event callback. May be NULL to unset event
+ *                      callback.
+ * @param[in] cb_arg    Argument to provide to @p cb.
+ */
+void sock_tcp_queue_set_cb(sock_tcp_queue_t *queue, sock_tcp_queue_cb_t cb,
+                           void *cb_arg);
+#endif  /* defined(MODULE_SOCK_TCP) || defined(DOXYGEN) */
+
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Sets event callback for @ref sock_udp_t
+ *
+ * Messages already waiting in @p sock are reported to @p cb right away.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in] cb        An event callback. May be NULL to unset event
+ *                      callback.
+ * @param[in] cb_arg    Argument to provide to @p cb.
+ */
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *cb_arg);
+#endif  /* defined(MODULE_SOCK_UDP) || defined(DOXYGEN) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_H */
+/** @} */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async_event    Asynchronous sock with event API
+ * @ingroup     net_sock_async
+ * @brief       Posts events of sock objects to an @ref sys_event queue
+ *
+ * With the `sock_async_event` module, the events of a sock object are
+ * handed to the thread serving an @ref event_queue_t instead of to the network
+ * stack's context. Since no thread needs to block on a sock anymore, any
+ * number of sock objects, of one or of multiple protocols, can be served by
+ * the same thread:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static sock_udp_t sock;
+ * static sock_event_t sock_event;
+ *
+ * void handler(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+ * {
+ *     if (type & SOCK_ASYNC_MSG_RECV) {
+ *         uint8_t buf[64];
+ *         ssize_t res;
+ *
+ *         while ((res = sock_udp_recv(sock, buf, sizeof(buf), 0, NULL)) > 0) {
+ *             ...
+ *         }
+ *     }
+ * }
+ *
+ * int main(void)
+ * {
+ *     event_queue_t queue;
+ *     sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+ *
+ *     event_queue_init(&queue);
+ *     local.port = 12345;
+ *     sock_udp_create(&sock, &local, NULL, 0);
+ *     sock_udp_event_init(&sock, &sock_event, &queue, handler, NULL);
+ *     event_loop(&queue);
+ *     return 0;
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Events happening while one is still queued are merged into it, so a
+ * handler must drain the sock completely, e.g. by receiving with a timeout
+ * of 0 until no more data is available.
+ *
+ * To stop receiving events, unset the callback of the sock with
+ * `sock_udp_set_cb(sock, NULL, NULL)` (or the respective function for the sock
+ * type) and remove the event from the queue with @ref event_cancel().
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous sock using @ref sys_event definitions
+ */
+#ifndef NET_SOCK_ASYNC_EVENT_H
+#define NET_SOCK_ASYNC_EVENT_H
+
+/* not this file, but the event queue API of sys/include */
+#include <event.h>
+
+#include "net/sock/async.h"
+
+#ifdef MODULE_GNRC_TCP
+#include "net/gnrc/tcp.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Event of a sock object
+ *
+ * The storage is provided by the user and must stay valid until the event is
+ * unset again.
+ */
+typedef struct {
+    event_t super;                      /**< event structure that gets extended */
+    event_queue_t *queue;               /**< queue the event is posted to */
+    void *sock;                         /**< sock the event happened on */
+    union {
+        sock_ip_cb_t ip;                /**< handler for @ref sock_ip_t */
+        sock_tcp_cb_t tcp;              /**< handler for @ref sock_tcp_t */
+        sock_tcp_queue_cb_t tcp_queue;  /**< handler for @ref sock_tcp_queue_t */
+        sock_udp_cb_t udp;              /**< handler for @ref sock_udp_t */
+#if defined(MODULE_GNRC_TCP) || defined(DOXYGEN)
+        gnrc_tcp_cb_t gnrc_tcp;         /**< handler for @ref gnrc_tcp_tcb_t */
+#endif
+    } handler;                          /**< handler to call in the queue's thread */
+    void *handler_arg;                  /**< argument for the handler */
+    sock_async_flags_t type;            /**< events collected since the handler
+                                         *   was last called */
+} sock_event_t;
+
+#if defined(MODULE_SOCK_IP) || defined(DOXYGEN)
+/**
+ * @brief   Makes a raw IPv4/IPv6 sock post its events to an event queue
+ *
+ * @pre `(sock != NULL) && (event != NULL) && (queue != NULL) &&
+ *       (handler != NULL)`
+ *
+ * @param[in] sock          A raw IPv4/IPv6 sock object.
+ * @param[out] event        Storage for the event of @p sock.
+ * @param[in] queue         The event queue to post the events to.
+ * @param[in] handler       Called in the thread serving @p queue.
+ * @param[in] handler_arg   Argument to provide to @p handler.
+ */
+void sock_ip_event_init(sock_ip_t *sock, sock_event_t *event,
+                        event_queue_t *queue, sock_ip_cb_t handler,
+                        void *handler_arg);
+#endif  /* defined(MODULE_SOCK_IP) || defined(DOXYGEN) */
+
+#if defined(MODULE_SOCK_TCP) || defined(DOXYGEN)
+/**
+ * @brief   Makes a TCP sock post its events to an event queue
+ *
+ * @pre `(sock != NULL) && (event != NULL) && (queue != NULL) &&
+ *       (handler != NULL)`
+ *
+ * @param[in] sock          A TCP sock object.
+ * @param[out] event        Storage for the event of @p sock.
+ * @param[in] queue         The event queue to post the events to.
+ * @param[in] handler       Called in the thread serving @p queue.
+ * @param[in] handler_arg   Argument to provide to @p handler.
+ */
+void sock_tcp_event_init(sock_tcp_t *sock, sock_event_t *event,
+                         event_queue_t *queue, sock_tcp_cb_t handler,
+                         void *handler_arg);
+
+/**
+ * @brief   Makes a TCP listening queue post its events to an event queue
+ *
+ * @pre `(tcp_queue != NULL) && (event != NULL) && (queue != NULL) &&
+ *       (handler != NULL)`
+ *
+ * @param[in] tcp_queue     A TCP listening queue.
+ * @param[out] event        Storage for the event of @p tcp_queue.
+ * @param[in] queue         The event queue to post the events to.
+ * @param[in] handler       Called in the thread serving @p queue.
+ * @param[in] handler_arg   Argument to provide to @p handler.
+ */
+void sock_tcp_queue_event_init(sock_tcp_queue_t *tcp_queue,
+                               sock_event_t *event, event_queue_t *queue,
+                               sock_tcp_queue_cb_t handler,
+                               void *handler_arg);
+#endif  /* defined(MODULE_SOCK_TCP) || defined(DOXYGEN) */
+
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Makes a UDP sock post its events to an event queue
+ *
+ * @pre `(sock != NULL) && (event != NULL) && (queue != NULL) &&
+ *       (handler != NULL)`
+ *
+ * @param[in] sock          A UDP sock object.
+ * @param[out] event        Storage for the event of @p sock.
+ * @param[in] queue         The event queue to post the events to.
+ * @param[in] handler       Called in the thread serving @p queue.
+ * @param[in] handler_arg   Argument to provide to @p handler.
+ */
+void sock_udp_event_init(sock_udp_t *sock, sock_event_t *event,
+                         event_queue_t *queue, sock_udp_cb_t handler,
+                         void *handler_arg);
+#endif  /* defined(MODULE_SOCK_UDP) || defined(DOXYGEN) */
+
+#if defined(MODULE_GNRC_TCP) || defined(DOXYGEN)
+/**
+ * @brief   Makes a GNRC TCP connection post its events to an event queue
+ *
+ * @pre `(tcb != NULL) && (event != NULL) && (queue != NULL) &&
+ *       (handler != NULL)`
+ *
+ * @param[in] tcb           TCB of the connection.
+ * @param[out] event        Storage for the event of @p tcb.
+ * @param[in] queue         The event queue to post the events to.
+ * @param[in] handler       Called in the thread serving @p queue.
+ * @param[in] handler_arg   Argument to provide to @p handler.
+ */
+void gnrc_tcp_event_init(gnrc_tcp_tcb_t *tcb, sock_event_t *event,
+                         event_queue_t *queue, gnrc_tcp_cb_t handler,
+                         void *handler_arg);
+#endif  /* defined(MODULE_GNRC_TCP) || defined(DOXYGEN) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_EVENT_H */
+/** @} */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_sock_async
+ * @{
+ *
+ * @file
+ * @brief       Type definitions for asynchronous sock
+ *
+ * Separate from @ref net/sock/async.h, so the sock backends can use them in
+ * their `sock_types.h`.
+ */
+#ifndef NET_SOCK_ASYNC_TYPES_H
+#define NET_SOCK_ASYNC_TYPES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* forward declarations, defined by the sock backends */
+struct sock_ip;
+struct sock_tcp;
+struct sock_tcp_queue;
+struct sock_udp;
+
+/**
+ * @brief   Flag types to signify asynchronous sock events
+ *
+ * Flags may be combined, so a callback must check each of them.
+ */
+typedef enum {
+    SOCK_ASYNC_CONN_RDY     = 0x0001,   /**< Connection ready event */
+    SOCK_ASYNC_CONN_FIN     = 0x0002,   /**< Connection finished event */
+    SOCK_ASYNC_CONN_RECV    = 0x0004,   /**< Listener received connection event */
+    SOCK_ASYNC_MSG_RECV     = 0x0010,   /**< Message received event */
+    SOCK_ASYNC_MSG_SENT     = 0x0020,   /**< Message sent event */
+} sock_async_flags_t;
+
+/**
+ * @brief   Event callback for @ref sock_ip_t
+ *
+ * @param[in] sock      The sock the event happened on
+ * @param[in] flags     The event flags. Expected values are
+ *                      - @ref SOCK_ASYNC_MSG_RECV,
+ *                      - @ref SOCK_ASYNC_MSG_SENT
+ * @param[in] arg       Argument provided when setting the callback
+ */
+typedef void (*sock_ip_cb_t)(struct sock_ip *sock, sock_async_flags_t flags,
+                             void *arg);
+
+/**
+ * @brief   Event callback for @ref sock_tcp_t
+ *
+ * @param[in] sock      The sock the event happened on
+ * @param[in] flags     The event flags. Expected values are
+ *                      - @ref SOCK_ASYNC_CONN_RDY,
+ *                      - @ref SOCK_ASYNC_CONN_FIN,
+ *                      - @ref SOCK_ASYNC_MSG_RECV,
+ *                      - @ref SOCK_ASYNC_MSG_SENT
+ * @param[in] arg       Argument provided when setting the callback
+ */
+typedef void (*sock_tcp_cb_t)(struct sock_tcp *sock, sock_async_flags_t flags,
+                              void *arg);
+
+/**
+ * @brief   Event callback for @ref sock_tcp_queue_t
+ *
+ * @param[in] queue     The TCP listening queue the event happened on
+ * @param[in] flags     The event flags. The only expected value is
+ *                      @ref SOCK_ASYNC_CONN_RECV.
+ * @param[in] arg       Argument provided when setting the callback
+ */
+typedef void (*sock_tcp_queue_cb_t)(struct sock_tcp_queue *queue,
+                                    sock_async_flags_t flags, void *arg);
+
+/**
+ * @brief   Event callback for @ref sock_udp_t
+ *
+ * @param[in] sock      The sock the event happened on
+ * @param[in] flags     The event flags. Expected values are
+ *                      - @ref SOCK_ASYNC_MSG_RECV,
+ *                      - @ref SOCK_ASYNC_MSG_SENT
+ * @param[in] arg       Argument provided when setting the callback
+ */
+typedef void (*sock_udp_cb_t)(struct sock_udp *sock, sock_async_flags_t flags,
+                              void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_TYPES_H */
+/** @} */
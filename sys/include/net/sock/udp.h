@@ -273,6 +273,7 @@
 #include <stdlib.h>
 #include <sys/types.h>
 
+#include "iolist.h"
 #include "net/sock.h"
 
 #ifdef __cplusplus
@@ -402,6 +403,50 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Provides stack-internal buffer space containing a UDP message from
+ *          a remote end point
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * Other than sock_udp_recv() the data is not copied, @p data points to the
+ * payload in the stack's packet buffer instead. The payload may be spread
+ * over multiple chunks: call this function with the same @p data and
+ * @p buf_ctx again to get the next chunk, until it returns 0. The buffer is
+ * released by that final call, so it must always be made.
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the current chunk of the received data.
+ *                      Read-only, valid until the next call with @p buf_ctx.
+ * @param[in,out] buf_ctx   Stack-internal buffer context. Must be `NULL`
+ *                          (`*buf_ctx == NULL`) to receive a new message,
+ *                          is set to `NULL` again, when the buffer was
+ *                          released.
+ * @param[in] timeout   Timeout for receive in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available).
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ * @note    Currently only implemented by GNRC.
+ *
+ * @return  The number of bytes in @p data on success.
+ * @return  0, if no more data is available and the buffer was released.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -EINVAL, if @p remote is invalid or @p sock is not properly
+ *          initialized (or closed while sock_udp_recv_buf() blocks).
+ * @return  -ENOMEM, if no memory was available to receive @p data.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -438,6 +483,35 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends a UDP message gathered from multiple buffers to remote end
+ *          point
+ *
+ * @pre `((sock != NULL || remote != NULL))`
+ *
+ * Other than sock_udp_send() the payload does not need to be in one
+ * continuous buffer, so e.g. a header and a payload can be sent without
+ * copying them together first.
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] snips     List of buffers to send as payload, in order.
+ *                      May be `NULL` for an empty payload.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *                      sock_udp_ep_t::family may be AF_UNSPEC, if local
+ *                      end point of @p sock provides this information.
+ *                      sock_udp_ep_t::port may not be 0.
+ *
+ * @note    Currently only implemented by GNRC.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  Same errors as sock_udp_send().
+ */
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
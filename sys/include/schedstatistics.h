@@ -16,6 +16,22 @@
  *
  * @note        If auto_init is disabled `init_schedstatistics()` needs to be
  *              called as well as xtimer_init().
+ *
+ * By default the time stamps are taken from xtimer. With the
+ * `schedstatistics_cycles` pseudomodule they are taken from a cycle counter
+ * instead, which is cheaper to read and much finer grained: the DWT cycle
+ * counter on Cortex-M3 and up, `clock_gettime()` with microsecond resolution
+ * on native. This mode additionally counts voluntary and involuntary
+ * switches, tracks the maximum latency from a thread becoming ready to it
+ * running, and the time spent in interrupt service routines where the CPU
+ * reports it (see @ref schedstat_isr_enter()).
+ *
+ * The scheduler hook does a constant amount of work: one counter read and a
+ * few additions, independent of the number of threads.
+ *
+ * @note        The time stamps are 32 bit wide, so a thread must not run for
+ *              longer than 2^32 ticks without a context switch for its
+ *              runtime to be correct (~60 s at 72 MHz for the cycle counter).
  * @{
  *
  * @file
@@ -44,6 +60,15 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+#if defined(MODULE_SCHEDSTATISTICS_CYCLES) || defined(DOXYGEN)
+    uint32_t readystart;     /**< Time stamp of the last time this thread
+                                  became ready to run */
+    uint32_t max_latency;    /**< Longest time from becoming ready to running
+                                  in ticks */
+    unsigned int voluntary;  /**< Switches away while blocked */
+    unsigned int involuntary;/**< Switches away while still runnable, i.e.
+                                  preemptions and yields */
+#endif
 } schedstat_t;
 
 /**
@@ -57,6 +82,66 @@ extern schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
  */
 void init_schedstatistics(void);
 
+/**
+ * @brief   The scheduler hook updating the statistics on a context switch
+ *
+ * Registered by init_schedstatistics().
+ *
+ * @param[in]   active_thread   thread that ran until now
+ * @param[in]   next_thread     thread that runs next
+ */
+void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread);
+
+/**
+ * @brief   Get the number of ticks per second of the time stamps
+ *
+ * @return  XTIMER_HZ, or the rate of the cycle counter with
+ *          `schedstatistics_cycles`
+ */
+uint32_t schedstat_ticks_per_sec(void);
+
+/**
+ * @brief   Get a consistent copy of the statistics of a thread
+ *
+ * @param[in]   pid     thread to get the statistics of
+ * @param[out]  stat    the statistics
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p pid is not a valid pid
+ */
+int schedstat_get(kernel_pid_t pid, schedstat_t *stat);
+
+/**
+ * @brief   Reset the statistics of all threads and the ISR time
+ */
+void schedstat_reset(void);
+
+#if defined(MODULE_SCHEDSTATISTICS_CYCLES) || defined(DOXYGEN)
+/**
+ * @brief   Get the total time spent in interrupt service routines
+ *
+ * @return  ISR time in ticks, 0 if the CPU doesn't report it
+ */
+uint64_t schedstat_isr_ticks(void);
+
+/**
+ * @brief   Mark the begin of an interrupt service routine
+ *
+ * To be called by the CPU's common interrupt entry path, if it has one.
+ * ISRs must not nest between schedstat_isr_enter() and
+ * schedstat_isr_exit().
+ */
+void schedstat_isr_enter(void);
+
+/**
+ * @brief   Mark the end of an interrupt service routine
+ *
+ * The time since schedstat_isr_enter() is not accounted to the interrupted
+ * thread. Must be called before a context switch requested by the ISR.
+ */
+void schedstat_isr_exit(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
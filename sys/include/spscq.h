@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_spscq Lock-free single producer single consumer queue
+ * @ingroup     sys
+ * @brief       Lock-free queue of variable sized records for one producer and
+ *              one consumer, e.g. an ISR handing data to a thread
+ *
+ * The records are stored in a ring buffer. The producer reserves space for a
+ * record with spscq_reserve(), fills it in place and publishes it with
+ * spscq_commit(). The consumer gets the oldest record with spscq_peek() and
+ * frees it with spscq_release(). spscq_put() and spscq_get() copy a record in
+ * and out.
+ *
+ * Neither side disables interrupts: the producer and the consumer each only
+ * write their own position in the ring, the other side reads it with acquire
+ * semantics. So exactly one context may produce and one may consume at a
+ * time; e.g. two ISRs of different priority must not both put into the same
+ * queue.
+ *
+ * Each record takes its size rounded up to 4 bytes plus a 4 byte header. A
+ * record is always contiguous; if it doesn't fit in before the end of the
+ * buffer, the rest of the buffer is skipped. Hence a record is only
+ * guaranteed to fit into an empty queue if its SPSCQ_RECORD_SIZE() is at
+ * most half the buffer size.
+ *
+ * spscq_peek_blocking() and spscq_get_blocking() wait for a record with
+ * @ref core_thread_flags "thread flags". The producer sets the flag given to
+ * spscq_init() for the waiting consumer.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Lock-free single producer single consumer queue definitions
+ */
+
+#ifndef SPSCQ_H
+#define SPSCQ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+/* The stdatomic.h in GCC gives compilation errors with C++
+ * see: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=60932
+ */
+#ifdef __cplusplus
+#include <atomic>
+using std::atomic_uint;
+using std::atomic_uintptr_t;
+#else
+#include <stdatomic.h>
+#endif
+
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the header in front of each record
+ */
+#define SPSCQ_HDR_SIZE      (4U)
+
+/**
+ * @brief   Space a record of @p len bytes takes in the buffer
+ */
+#define SPSCQ_RECORD_SIZE(len)  (SPSCQ_HDR_SIZE + (((len) + 3U) & ~3U))
+
+/**
+ * @brief   Single producer single consumer queue
+ */
+typedef struct {
+    uint8_t *buf;               /**< buffer, 4 byte aligned */
+    unsigned size;              /**< size of the buffer, power of 2 */
+    atomic_uint reads;          /**< bytes consumed, written by the consumer */
+    atomic_uint writes;         /**< bytes produced, written by the producer */
+    unsigned reserved;          /**< start of the reserved record */
+    unsigned reserved_len;      /**< length of the reserved record */
+    atomic_uintptr_t waiter;    /**< consumer waiting for a record */
+    thread_flags_t flag;        /**< flag to wake the consumer with */
+} spscq_t;
+
+/**
+ * @brief   Initialize a queue
+ *
+ * @param[out]  q       queue to initialize
+ * @param[in]   buf     buffer for the records, 4 byte aligned
+ * @param[in]   size    size of @p buf, must be a power of 2
+ * @param[in]   flag    thread flag to wake a blocked consumer with
+ */
+void spscq_init(spscq_t *q, void *buf, unsigned size, thread_flags_t flag);
+
+/**
+ * @brief   Reserve space for a record (producer)
+ *
+ * The record becomes visible to the consumer on spscq_commit(). Until then
+ * no other record may be reserved.
+ *
+ * @param[in]   q       queue
+ * @param[in]   len     maximum length of the record
+ *
+ * @return  pointer to @p len bytes to write the record to
+ * @return  NULL if the queue is too full
+ */
+void *spscq_reserve(spscq_t *q, size_t len);
+
+/**
+ * @brief   Publish the record reserved with spscq_reserve() (producer)
+ *
+ * Wakes the consumer if it is blocked.
+ *
+ * @param[in]   q       queue
+ * @param[in]   len     actual length of the record, at most the length
+ *                      that was reserved
+ */
+void spscq_commit(spscq_t *q, size_t len);
+
+/**
+ * @brief   Copy a record into the queue (producer)
+ *
+ * @param[in]   q       queue
+ * @param[in]   data    record
+ * @param[in]   len     length of @p data
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS if the queue is too full
+ */
+int spscq_put(spscq_t *q, const void *data, size_t len);
+
+/**
+ * @brief   Get the oldest record without removing it (consumer)
+ *
+ * @param[in]   q       queue
+ * @param[out]  len     length of the record
+ *
+ * @return  pointer to the record, valid until spscq_release()
+ * @return  NULL if the queue is empty
+ */
+void *spscq_peek(spscq_t *q, size_t *len);
+
+/**
+ * @brief   Remove the record returned by spscq_peek() (consumer)
+ *
+ * @pre The queue is not empty
+ *
+ * @param[in]   q       queue
+ */
+void spscq_release(spscq_t *q);
+
+/**
+ * @brief   Copy the oldest record out of the queue (consumer)
+ *
+ * @param[in]   q       queue
+ * @param[out]  buf     buffer for the record
+ * @param[in]   max_len size of @p buf
+ *
+ * @return  length of the record
+ * @return  -EAGAIN if the queue is empty
+ * @return  -ENOBUFS if the record doesn't fit into @p buf, it stays in the
+ *          queue
+ */
+ssize_t spscq_get(spscq_t *q, void *buf, size_t max_len);
+
+/**
+ * @brief   Get the oldest record, wait for one if the queue is empty
+ *          (consumer)
+ *
+ * @param[in]   q       queue
+ * @param[out]  len     length of the record
+ *
+ * @return  pointer to the record, valid until spscq_release()
+ */
+void *spscq_peek_blocking(spscq_t *q, size_t *len);
+
+/**
+ * @brief   Copy the oldest record out of the queue, wait for one if the
+ *          queue is empty (consumer)
+ *
+ * @param[in]   q       queue
+ * @param[out]  buf     buffer for the record
+ * @param[in]   max_len size of @p buf
+ *
+ * @return  length of the record
+ * @return  -ENOBUFS if the record doesn't fit into @p buf, it stays in the
+ *          queue
+ */
+ssize_t spscq_get_blocking(spscq_t *q, void *buf, size_t max_len);
+
+/**
+ * @brief   Check if the queue is empty
+ *
+ * @param[in]   q       queue
+ *
+ * @return  1 if empty, 0 otherwise
+ */
+int spscq_empty(spscq_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSCQ_H */
+/** @} */
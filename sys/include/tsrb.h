@@ -154,6 +154,49 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c);
  */
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n);
 
+/**
+ * @brief       Get the oldest bytes in the ringbuffer without copying them
+ *
+ * Returns a pointer into the buffer of @p rb, e.g. to hand it to a parser or
+ * DMA transfer. As the data may wrap around the end of the buffer, only the
+ * part up to the end is returned; call again after tsrb_drop() for the rest.
+ *
+ * @note        Only the consumer of @p rb may call this function. The data
+ *              stays valid until it is released with tsrb_drop().
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    Start of the oldest bytes in the buffer
+ * @return      nr of bytes that can be read contiguously from @p data
+ */
+unsigned tsrb_get_contig(const tsrb_t *rb, uint8_t **data);
+
+/**
+ * @brief       Get free space in the ringbuffer to write to directly
+ *
+ * Returns a pointer into the buffer of @p rb, e.g. as the destination of a
+ * DMA transfer. Only the free space up to the end of the buffer is returned;
+ * call again after tsrb_add_commit() for the rest.
+ *
+ * @note        Only the producer of @p rb may call this function.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    Start of the free space in the buffer
+ * @return      nr of bytes that can be written contiguously to @p data
+ */
+unsigned tsrb_add_contig(const tsrb_t *rb, uint8_t **data);
+
+/**
+ * @brief       Make bytes written to the space returned by tsrb_add_contig()
+ *              available for reading
+ *
+ * @pre         @p n is not larger than the value returned by the last call to
+ *              tsrb_add_contig()
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes written
+ */
+void tsrb_add_commit(tsrb_t *rb, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
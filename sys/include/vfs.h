@@ -153,6 +153,27 @@ extern "C" {
 #define VFS_NAME_MAX (31)
 #endif
 
+#ifndef THREAD_FLAG_VFS_POLL
+/**
+ * @brief Thread flag set by vfs_poll_notify() on threads waiting for a file
+ *
+ * Only used with module `vfs_poll`.
+ */
+#define THREAD_FLAG_VFS_POLL (1u << 13)
+#endif
+
+/**
+ * @name Readiness events returned by vfs_poll_ready()
+ *
+ * The values match the Linux ones for the corresponding @c POLL* events.
+ * @{
+ */
+#define VFS_POLLIN  (0x01)  /**< data can be read without blocking */
+#define VFS_POLLOUT (0x04)  /**< data can be written without blocking */
+#define VFS_POLLERR (0x08)  /**< an error occurred */
+#define VFS_POLLHUP (0x10)  /**< the remote end hung up */
+/** @} */
+
 /**
  * @brief Used with vfs_bind to bind to any available fd number
  */
@@ -201,6 +222,16 @@ struct vfs_mount_struct {
     void *private_data;          /**< File system driver private data, implementation defined */
 };
 
+/**
+ * @brief Thread waiting for events on an open file
+ *
+ * @see vfs_poll_add()
+ */
+typedef struct vfs_poll_waiter {
+    struct vfs_poll_waiter *next;   /**< next waiter on the same file */
+    kernel_pid_t pid;               /**< the waiting thread */
+} vfs_poll_waiter_t;
+
 /**
  * @brief Information about an open file
  *
@@ -217,6 +248,9 @@ typedef struct {
         int value;              /**< alternatively, you can use private_data as an int */
         uint8_t buffer[VFS_FILE_BUFFER_SIZE]; /**< Buffer space, in case a single pointer is not enough */
     } private_data;             /**< File system driver private data, implementation defined */
+#if defined(MODULE_VFS_POLL) || defined(DOXYGEN)
+    vfs_poll_waiter_t *poll_waiters; /**< Threads waiting for events on the file */
+#endif
 } vfs_file_t;
 
 /**
@@ -370,6 +404,22 @@ struct vfs_file_ops {
      * @return <0 on error
      */
     ssize_t (*write) (vfs_file_t *filp, const void *src, size_t nbytes);
+
+#if defined(MODULE_VFS_POLL) || defined(DOXYGEN)
+    /**
+     * @brief Query the readiness of an open file
+     *
+     * Drivers implementing this must call vfs_poll_notify() whenever the
+     * returned events may have changed. If not implemented, the file is
+     * considered to never block.
+     *
+     * @param[in]  filp     pointer to open file
+     *
+     * @return combination of @ref VFS_POLLIN, @ref VFS_POLLOUT,
+     *         @ref VFS_POLLERR, and @ref VFS_POLLHUP
+     */
+    int (*poll) (vfs_file_t *filp);
+#endif
 };
 
 /**
@@ -848,6 +898,55 @@ int vfs_statvfs(const char *restrict path, struct statvfs *restrict buf);
  */
 int vfs_bind(int fd, int flags, const vfs_file_ops_t *f_op, void *private_data);
 
+#if defined(MODULE_VFS_POLL) || defined(DOXYGEN)
+/**
+ * @brief Query the readiness of an open file
+ *
+ * @param[in]  fd       fd number to query
+ *
+ * @return combination of @ref VFS_POLLIN, @ref VFS_POLLOUT,
+ *         @ref VFS_POLLERR, and @ref VFS_POLLHUP on success
+ * @return <0 on error
+ */
+int vfs_poll_ready(int fd);
+
+/**
+ * @brief Register the calling thread to be woken up by events on an open file
+ *
+ * @ref THREAD_FLAG_VFS_POLL is set on the calling thread when
+ * vfs_poll_notify() is called for @p fd until vfs_poll_del() is called or
+ * the file is closed. A thread can wait on several files at once, using one
+ * @p waiter per file.
+ *
+ * @param[in]  fd       fd number to wait on
+ * @param[out] waiter   waiter entry, must stay valid until vfs_poll_del()
+ *
+ * @return 0 on success
+ * @return <0 on error
+ */
+int vfs_poll_add(int fd, vfs_poll_waiter_t *waiter);
+
+/**
+ * @brief Unregister a waiter added with vfs_poll_add()
+ *
+ * @param[in]  fd       fd number @p waiter was added to
+ * @param[in]  waiter   the waiter entry
+ */
+void vfs_poll_del(int fd, vfs_poll_waiter_t *waiter);
+
+/**
+ * @brief Wake up all threads waiting on an open file
+ *
+ * To be called by file drivers whenever the readiness of @p fd may have
+ * changed.
+ *
+ * @attention Must not be called from interrupt context.
+ *
+ * @param[in]  fd       fd number of the file
+ */
+void vfs_poll_notify(int fd);
+#endif
+
 /**
  * @brief Normalize a path
  *
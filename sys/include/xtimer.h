@@ -20,6 +20,11 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * With the `xtimer_wheel` module, timers are kept in a hierarchical timing
+ * wheel instead, which makes insertion and removal O(1). Timers are moved to
+ * finer levels of the wheel as their target time approaches, at most
+ * @ref XTIMER_WHEEL_LEVELS times per timer.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -74,6 +79,11 @@ typedef struct xtimer {
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+    struct xtimer *prev;         /**< reference to previous timer in the same
+                                     timer wheel slot */
+    uint8_t wheel_slot;          /**< timer wheel slot the timer is stored in */
+#endif
 } xtimer_t;
 
 /**
@@ -585,6 +595,20 @@ void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
 #define XTIMER_MASK (0)
 #endif
 
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of levels of the timer wheel
+ *
+ * Only used with the `xtimer_wheel` module. Each level has 16 slots and
+ * covers 4 more bits of the distance between now and a timer's target time,
+ * so the default of 8 levels covers 2^32 ticks. Timers further in the future
+ * are kept in an extra list that is revisited every 2^(4 * levels) ticks.
+ *
+ * Must be between 1 and 15.
+ */
+#define XTIMER_WHEEL_LEVELS (8U)
+#endif
+
 /**
  * @brief  Base frequency of xtimer is 1 MHz
  */
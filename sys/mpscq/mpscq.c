@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_mpscq
+ * @{
+ *
+ * @file
+ * @brief       Lock-free multiple producer single consumer queue
+ *              implementation
+ *
+ * @}
+ */
+
+#include "thread.h"
+#include "mpscq.h"
+
+void mpscq_init(mpscq_t *q, thread_flags_t flag)
+{
+    atomic_init(&q->shared, 0);
+    q->local = NULL;
+    atomic_init(&q->waiter, 0);
+    q->flag = flag;
+}
+
+void mpscq_put(mpscq_t *q, mpscq_node_t *node)
+{
+    uintptr_t head = atomic_load_explicit(&q->shared, memory_order_relaxed);
+
+    do {
+        node->next = (mpscq_node_t *)head;
+    } while (!atomic_compare_exchange_weak_explicit(&q->shared, &head,
+                                                    (uintptr_t)node,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+
+    thread_t *waiter = (thread_t *)atomic_load(&q->waiter);
+    if (waiter) {
+        thread_flags_set(waiter, q->flag);
+    }
+}
+
+mpscq_node_t *mpscq_get(mpscq_t *q)
+{
+    mpscq_node_t *node = q->local;
+
+    if (node == NULL) {
+        /* take everything put so far and reverse it to oldest first */
+        node = (mpscq_node_t *)atomic_exchange_explicit(&q->shared, 0,
+                                                        memory_order_acquire);
+        while (node) {
+            mpscq_node_t *next = node->next;
+            node->next = q->local;
+            q->local = node;
+            node = next;
+        }
+        node = q->local;
+        if (node == NULL) {
+            return NULL;
+        }
+    }
+    q->local = node->next;
+    node->next = NULL;
+    return node;
+}
+
+mpscq_node_t *mpscq_get_blocking(mpscq_t *q)
+{
+    mpscq_node_t *node;
+
+    /* register before looking, so a node put in between sets the flag and
+     * the wait returns right away */
+    atomic_store(&q->waiter, (uintptr_t)sched_active_thread);
+    while ((node = mpscq_get(q)) == NULL) {
+        thread_flags_wait_any(q->flag);
+    }
+    atomic_store(&q->waiter, 0);
+    return node;
+}
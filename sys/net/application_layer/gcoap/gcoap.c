@@ -13,18 +13,24 @@
  * @file
  * @brief       GNRC's implementation of CoAP protocol
  *
- * Runs a thread (_pid) to manage request/response messaging.
+ * Runs a thread (_pid) to manage request/response messaging. With the
+ * `gcoap_event` module it runs on an event queue of the application instead.
  *
  * @author      Ken Bannister <kb2ma@runbox.com>
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdatomic.h>
 #include <string.h>
 
 #include "assert.h"
 #include "net/gcoap.h"
+#ifdef MODULE_GCOAP_EVENT
+#include "kernel_defines.h"
+#include "net/sock/async/event.h"
+#endif
 #include "net/sock/util.h"
 #include "mutex.h"
 #include "random.h"
@@ -39,8 +45,15 @@
 #define GCOAP_RESOURCE_NO_PATH -2
 
 /* Internal functions */
+#ifdef MODULE_GCOAP_EVENT
+static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg);
+static void _on_resp_timeout(event_t *event);
+#else
 static void *_event_loop(void *arg);
-static void _listen(sock_udp_t *sock);
+#endif
+static void _handle_resp_timeout(gcoap_request_memo_t *memo);
+static bool _listen(sock_udp_t *sock);
+static void _clear_resp_timer(gcoap_request_memo_t *memo);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx);
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                          sock_udp_ep_t *remote);
@@ -85,18 +98,66 @@ typedef struct {
                                         /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
                                            the entry is available */
+#ifdef MODULE_NANOCOAP_RESOURCE_INDEX
+    coap_resource_index_t index;        /* Index over listener resources */
+    bool index_full;                    /* Some listener didn't fit into the
+                                           index, search linearly */
+#endif
 } gcoap_state_t;
 
 static gcoap_state_t _coap_state = {
     .listeners   = &_default_listener,
 };
 
+static sock_udp_t _sock;
+#ifdef MODULE_GCOAP_EVENT
+static event_queue_t *_queue;
+static sock_event_t _sock_event;
+#else
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
 static msg_t _msg_queue[GCOAP_MSG_QUEUE_SIZE];
-static sock_udp_t _sock;
+#endif
+
+
+#ifdef MODULE_GCOAP_EVENT
+/* Handles events of the sock on the thread serving _queue. */
+static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+{
+    (void)arg;
+
+    if (type & SOCK_ASYNC_MSG_RECV) {
+        /* events are merged while queued, so take all waiting messages */
+        while (_listen(sock)) {}
+    }
+}
+
+/* Handles expiration of the response timer of a request. */
+static void _on_resp_timeout(event_t *event)
+{
+    gcoap_request_memo_t *memo = container_of(event, gcoap_request_memo_t,
+                                              timeout_event);
+
+    /* response handled while the event was waiting in the queue */
+    if (memo->state != GCOAP_MEMO_WAIT) {
+        return;
+    }
+    _handle_resp_timeout(memo);
+}
 
+/* Starts waiting for the response to a request. */
+static void _set_resp_timer(gcoap_request_memo_t *memo, uint32_t timeout)
+{
+    event_timeout_set(&memo->response_timer, timeout);
+}
 
+/* Stops waiting for the response to a request. */
+static void _clear_resp_timer(gcoap_request_memo_t *memo)
+{
+    event_timeout_clear(&memo->response_timer);
+    event_cancel(_queue, &memo->timeout_event);
+}
+#else
 /* Event/Message loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
 {
@@ -122,42 +183,9 @@ static void *_event_loop(void *arg)
 
         if (res > 0) {
             switch (msg_rcvd.type) {
-            case GCOAP_MSG_TYPE_TIMEOUT: {
-                gcoap_request_memo_t *memo = (gcoap_request_memo_t *)msg_rcvd.content.ptr;
-
-                /* no retries remaining */
-                if ((memo->send_limit == GCOAP_SEND_LIMIT_NON)
-                        || (memo->send_limit == 0)) {
-                    _expire_request(memo);
-                }
-                /* reduce retries remaining, double timeout and resend */
-                else {
-                    memo->send_limit--;
-#ifdef GCOAP_NO_RETRANS_BACKOFF
-                    unsigned i        = 0;
-#else
-                    unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
-#endif
-                    uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
-#if COAP_ACK_VARIANCE > 0
-                    uint32_t variance = ((uint32_t)COAP_ACK_VARIANCE << i) * US_PER_SEC;
-                    timeout = random_uint32_range(timeout, timeout + variance);
-#endif
-
-                    ssize_t bytes = sock_udp_send(&_sock, memo->msg.data.pdu_buf,
-                                                  memo->msg.data.pdu_len,
-                                                  &memo->remote_ep);
-                    if (bytes > 0) {
-                        xtimer_set_msg(&memo->response_timer, timeout,
-                                       &memo->timeout_msg, _pid);
-                    }
-                    else {
-                        DEBUG("gcoap: sock resend failed: %d\n", (int)bytes);
-                        _expire_request(memo);
-                    }
-                }
+            case GCOAP_MSG_TYPE_TIMEOUT:
+                _handle_resp_timeout((gcoap_request_memo_t *)msg_rcvd.content.ptr);
                 break;
-            }
             default:
                 break;
             }
@@ -169,13 +197,70 @@ static void *_event_loop(void *arg)
     return 0;
 }
 
-/* Listen for an incoming CoAP message. */
-static void _listen(sock_udp_t *sock)
+/* Starts waiting for the response to a request. */
+static void _set_resp_timer(gcoap_request_memo_t *memo, uint32_t timeout)
+{
+    xtimer_set_msg(&memo->response_timer, timeout, &memo->timeout_msg, _pid);
+}
+
+/* Stops waiting for the response to a request. */
+static void _clear_resp_timer(gcoap_request_memo_t *memo)
+{
+    xtimer_remove(&memo->response_timer);
+}
+#endif
+
+/* Resends a request whose response timed out, or expires it. */
+static void _handle_resp_timeout(gcoap_request_memo_t *memo)
+{
+    /* no retries remaining */
+    if ((memo->send_limit == GCOAP_SEND_LIMIT_NON)
+            || (memo->send_limit == 0)) {
+        _expire_request(memo);
+    }
+    /* reduce retries remaining, double timeout and resend */
+    else {
+        memo->send_limit--;
+#ifdef GCOAP_NO_RETRANS_BACKOFF
+        unsigned i        = 0;
+#else
+        unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
+#endif
+        uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
+#if COAP_ACK_VARIANCE > 0
+        uint32_t variance = ((uint32_t)COAP_ACK_VARIANCE << i) * US_PER_SEC;
+        timeout = random_uint32_range(timeout, timeout + variance);
+#endif
+
+        ssize_t bytes = sock_udp_send(&_sock, memo->msg.data.pdu_buf,
+                                      memo->msg.data.pdu_len,
+                                      &memo->remote_ep);
+        if (bytes > 0) {
+            _set_resp_timer(memo, timeout);
+        }
+        else {
+            DEBUG("gcoap: sock resend failed: %d\n", (int)bytes);
+            _expire_request(memo);
+        }
+    }
+}
+
+/*
+ * Listen for an incoming CoAP message.
+ *
+ * return true if a message was taken from the sock
+ */
+static bool _listen(sock_udp_t *sock)
 {
     coap_pkt_t pdu;
     uint8_t buf[GCOAP_PDU_BUF_SIZE];
     sock_udp_ep_t remote;
     gcoap_request_memo_t *memo = NULL;
+
+#ifdef MODULE_GCOAP_EVENT
+    /* Called on a receive event, so never wait here */
+    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf), 0, &remote);
+#else
     uint8_t open_reqs = gcoap_op_state();
 
     /* We expect a -EINTR response here when unlimited waiting (SOCK_NO_TIMEOUT)
@@ -186,25 +271,26 @@ static void _listen(sock_udp_t *sock)
     ssize_t res = sock_udp_recv(sock, buf, sizeof(buf),
                                 open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
                                 &remote);
+#endif
     if (res <= 0) {
 #if ENABLE_DEBUG
-        if (res < 0 && res != -ETIMEDOUT) {
+        if (res < 0 && res != -ETIMEDOUT && res != -EAGAIN) {
             DEBUG("gcoap: udp recv failure: %d\n", res);
         }
 #endif
-        return;
+        return false;
     }
 
     res = coap_parse(&pdu, buf, res);
     if (res < 0) {
         DEBUG("gcoap: parse failure: %d\n", (int)res);
         /* If a response, can't clear memo, but it will timeout later. */
-        return;
+        return true;
     }
 
     if (pdu.hdr->code == COAP_CODE_EMPTY) {
         DEBUG("gcoap: empty messages not handled yet\n");
-        return;
+        return true;
     }
 
     /* validate class and type for incoming */
@@ -235,7 +321,7 @@ static void _listen(sock_udp_t *sock)
             switch (coap_get_type(&pdu)) {
             case COAP_TYPE_NON:
             case COAP_TYPE_ACK:
-                xtimer_remove(&memo->response_timer);
+                _clear_resp_timer(memo);
                 memo->state = GCOAP_MEMO_RESP;
                 if (memo->resp_handler) {
                     memo->resp_handler(memo->state, &pdu, &remote);
@@ -261,6 +347,7 @@ static void _listen(sock_udp_t *sock)
     default:
         DEBUG("gcoap: illegal code class: %u\n", coap_get_code_class(&pdu));
     }
+    return true;
 }
 
 /*
@@ -394,6 +481,23 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     /* Find path for CoAP msg among listener resources and execute callback. */
     gcoap_listener_t *listener = _coap_state.listeners;
 
+#ifdef MODULE_NANOCOAP_RESOURCE_INDEX
+    if (!_coap_state.index_full) {
+        const coap_resource_index_entry_t *entry;
+        switch (coap_resource_index_find(&_coap_state.index, pdu, method_flag,
+                                         &entry)) {
+            case 0:
+                *resource_ptr = entry->resource;
+                *listener_ptr = entry->owner;
+                return GCOAP_RESOURCE_FOUND;
+            case -EPERM:
+                return GCOAP_RESOURCE_WRONG_METHOD;
+            default:
+                return GCOAP_RESOURCE_NO_PATH;
+        }
+    }
+#endif
+
     uint8_t uri[NANOCOAP_URI_MAX];
     if (coap_get_uri_path(pdu, uri) <= 0) {
         return GCOAP_RESOURCE_NO_PATH;
@@ -611,15 +715,34 @@ static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
  * gcoap interface functions
  */
 
-kernel_pid_t gcoap_init(void)
+#ifdef MODULE_NANOCOAP_RESOURCE_INDEX
+/*
+ * Adds the resources of a listener to the resource index. Falls back to
+ * searching all listeners linearly if the index is full.
+ */
+static void _index_listener(gcoap_listener_t *listener)
 {
-    if (_pid != KERNEL_PID_UNDEF) {
-        return -EEXIST;
+    /* the default listener always comes first */
+    if (!_coap_state.index.numof && (listener != &_default_listener)) {
+        _index_listener(&_default_listener);
     }
-    _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
-                            THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
+    if (coap_resource_index_add(&_coap_state.index, listener->resources,
+                                listener->resources_len, listener) < 0) {
+        DEBUG("gcoap: resource index full, falling back to linear search\n");
+        _coap_state.index_full = true;
+    }
+}
+#endif
 
+/* Initializes the state of gcoap. */
+static void _init_state(void)
+{
     mutex_init(&_coap_state.lock);
+#ifdef MODULE_NANOCOAP_RESOURCE_INDEX
+    if (!_coap_state.index.numof) {
+        _index_listener(&_default_listener);
+    }
+#endif
     /* Blank lists so we know if an entry is available. */
     memset(&_coap_state.open_reqs[0], 0, sizeof(_coap_state.open_reqs));
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
@@ -627,9 +750,47 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
+}
+
+#ifdef MODULE_GCOAP_EVENT
+int gcoap_init_event(event_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    if (_queue != NULL) {
+        return -EEXIST;
+    }
+    _init_state();
+
+    sock_udp_ep_t local;
+    memset(&local, 0, sizeof(sock_udp_ep_t));
+    local.family = AF_INET6;
+    local.netif  = SOCK_ADDR_ANY_NETIF;
+    local.port   = GCOAP_PORT;
+
+    int res = sock_udp_create(&_sock, &local, NULL, 0);
+    if (res < 0) {
+        DEBUG("gcoap: cannot create sock: %d\n", res);
+        return res;
+    }
+    _queue = queue;
+    sock_udp_event_init(&_sock, &_sock_event, queue, _on_sock_evt, NULL);
+    return 0;
+}
+#else
+kernel_pid_t gcoap_init(void)
+{
+    if (_pid != KERNEL_PID_UNDEF) {
+        return -EEXIST;
+    }
+    _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
+                            THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
+
+    _init_state();
 
     return _pid;
 }
+#endif
 
 void gcoap_register_listener(gcoap_listener_t *listener)
 {
@@ -644,6 +805,10 @@ void gcoap_register_listener(gcoap_listener_t *listener)
         listener->link_encoder = gcoap_encode_link;
     }
     _last->next = listener;
+
+#ifdef MODULE_NANOCOAP_RESOURCE_INDEX
+    _index_listener(listener);
+#endif
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
@@ -790,6 +955,21 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
         }
     }
 
+#ifdef MODULE_GCOAP_EVENT
+    /* Memos complete; start timer and send msg. The timer is started first,
+     * since the response may be handled on the gcoap thread before
+     * sock_udp_send() returns here. */
+    if ((memo != NULL) && (timeout > 0)) {
+        memo->timeout_event.handler = _on_resp_timeout;
+        event_timeout_init(&memo->response_timer, _queue, &memo->timeout_event);
+        _set_resp_timer(memo, timeout);
+    }
+    ssize_t res = sock_udp_send(&_sock, buf, len, remote);
+
+    if ((res <= 0) && (memo != NULL) && (timeout > 0)) {
+        _clear_resp_timer(memo);
+    }
+#else
     /* Memos complete; send msg and start timer */
     ssize_t res = sock_udp_send(&_sock, buf, len, remote);
 
@@ -810,13 +990,14 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
             /* start response wait timer on the gcoap thread */
             memo->timeout_msg.type        = GCOAP_MSG_TYPE_TIMEOUT;
             memo->timeout_msg.content.ptr = (char *)memo;
-            xtimer_set_msg(&memo->response_timer, timeout, &memo->timeout_msg, _pid);
+            _set_resp_timer(memo, timeout);
         }
         else {
             res = 0;
             DEBUG("gcoap: can't wake up mbox; no timeout for msg\n");
         }
     }
+#endif
     if (res <= 0) {
         if (memo != NULL) {
             if (msg_type == COAP_TYPE_CON) {
@@ -162,6 +162,40 @@ int coap_match_path(const coap_resource_t *resource, uint8_t *uri)
     return res;
 }
 
+int coap_match_path_pkt(const coap_resource_t *resource, const coap_pkt_t *pkt)
+{
+    assert(resource && pkt);
+
+    const uint8_t *path = (const uint8_t *)resource->path;
+    bool subtree = resource->methods & COAP_MATCH_SUBTREE;
+    uint8_t *opt_pos = coap_find_option(pkt, COAP_OPT_URI_PATH);
+    uint8_t *segment = NULL;
+    int len;
+
+    /* a request without Uri-Path option is for "/" */
+    if (!opt_pos) {
+        if (*path != '/') {
+            return (subtree && !*path) ? 0 : '/' - *path;
+        }
+        return -(int)path[1];
+    }
+
+    while ((segment = coap_iterate_option(pkt, &opt_pos, &len,
+                                          (segment == NULL)))) {
+        if (*path != '/') {
+            return (subtree && !*path) ? 0 : '/' - *path;
+        }
+        path++;
+        for (int i = 0; i < len; i++, path++) {
+            if (!*path || (segment[i] != *path)) {
+                return (subtree && !*path) ? 0 : segment[i] - *path;
+            }
+        }
+    }
+    /* the URI path ended, the resource path must end as well */
+    return -(int)*path;
+}
+
 uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
 {
     const coap_optpos_t *optpos = pkt->options;
@@ -377,6 +411,27 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
 
     coap_method_flags_t method_flag = coap_method2flag(coap_get_code_detail(pkt));
 
+#ifdef MODULE_NANOCOAP_RESOURCE_INDEX
+    /* built on the first request, the index is unused if it is too small */
+    static coap_resource_index_t index;
+    static int index_state;
+
+    if (!index_state) {
+        index_state = coap_resource_index_add(&index, coap_resources,
+                                              coap_resources_numof, NULL)
+                      ? -1 : 1;
+    }
+    if (index_state > 0) {
+        const coap_resource_index_entry_t *entry;
+        if (coap_resource_index_find(&index, pkt, method_flag, &entry) == 0) {
+            const coap_resource_t *resource = entry->resource;
+            return resource->handler(pkt, resp_buf, resp_buf_len,
+                                     resource->context);
+        }
+        return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+    }
+#endif
+
     uint8_t uri[NANOCOAP_URI_MAX];
     if (coap_get_uri_path(pkt, uri) <= 0) {
         return -EBADMSG;
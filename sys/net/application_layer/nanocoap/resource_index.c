@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_nanocoap
+ * @{
+ *
+ * @file
+ * @brief       Hash index over CoAP resource paths
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/nanocoap.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if (NANOCOAP_RESOURCE_INDEX_BUCKETS & (NANOCOAP_RESOURCE_INDEX_BUCKETS - 1))
+#error "NANOCOAP_RESOURCE_INDEX_BUCKETS must be a power of 2"
+#endif
+
+#if (NANOCOAP_RESOURCE_INDEX_SIZE >= UINT16_MAX)
+#error "NANOCOAP_RESOURCE_INDEX_SIZE too large"
+#endif
+
+/* 32 bit FNV-1a */
+#define FNV_OFFSET  (2166136261UL)
+#define FNV_PRIME   (16777619UL)
+
+static inline uint32_t _hash_add(uint32_t hash, uint8_t c)
+{
+    return (hash ^ c) * FNV_PRIME;
+}
+
+static uint32_t _hash_path(const char *path)
+{
+    uint32_t hash = FNV_OFFSET;
+
+    while (*path) {
+        hash = _hash_add(hash, (uint8_t)*path++);
+    }
+    return hash;
+}
+
+/* hashes the URI path of a request without copying it */
+static uint32_t _hash_pkt(const coap_pkt_t *pkt)
+{
+    uint32_t hash = FNV_OFFSET;
+    uint8_t *opt_pos = coap_find_option(pkt, COAP_OPT_URI_PATH);
+    uint8_t *segment = NULL;
+    int len;
+
+    if (!opt_pos) {
+        return _hash_add(hash, '/');
+    }
+    while ((segment = coap_iterate_option(pkt, &opt_pos, &len,
+                                          (segment == NULL)))) {
+        hash = _hash_add(hash, '/');
+        for (int i = 0; i < len; i++) {
+            hash = _hash_add(hash, segment[i]);
+        }
+    }
+    return hash;
+}
+
+void coap_resource_index_init(coap_resource_index_t *index)
+{
+    memset(index, 0, sizeof(*index));
+}
+
+int coap_resource_index_add(coap_resource_index_t *index,
+                            const coap_resource_t *resources, size_t numof,
+                            void *owner)
+{
+    if (numof > (NANOCOAP_RESOURCE_INDEX_SIZE - index->numof)) {
+        DEBUG("nanocoap: resource index full\n");
+        return -ENOMEM;
+    }
+
+    for (size_t i = 0; i < numof; i++) {
+        coap_resource_index_entry_t *entry = &index->entries[index->numof];
+        uint16_t *link;
+
+        entry->resource = &resources[i];
+        entry->owner = owner;
+        entry->next = 0;
+        if (resources[i].methods & COAP_MATCH_SUBTREE) {
+            entry->hash = 0;
+            link = &index->subtree;
+        }
+        else {
+            entry->hash = _hash_path(resources[i].path);
+            link = &index->buckets[entry->hash &
+                                   (NANOCOAP_RESOURCE_INDEX_BUCKETS - 1)];
+        }
+        /* append, so chains stay in the order entries were added */
+        while (*link) {
+            link = &index->entries[*link - 1].next;
+        }
+        *link = ++index->numof;
+    }
+    return 0;
+}
+
+int coap_resource_index_find(const coap_resource_index_t *index,
+                             const coap_pkt_t *pkt,
+                             coap_method_flags_t method_flag,
+                             const coap_resource_index_entry_t **entry)
+{
+    const coap_resource_index_entry_t *found = NULL;
+    uint32_t hash = _hash_pkt(pkt);
+    int res = -ENOENT;
+
+    for (uint16_t i = index->buckets[hash & (NANOCOAP_RESOURCE_INDEX_BUCKETS - 1)];
+         i; i = index->entries[i - 1].next) {
+        const coap_resource_index_entry_t *cur = &index->entries[i - 1];
+
+        if ((cur->hash != hash) || coap_match_path_pkt(cur->resource, pkt)) {
+            continue;
+        }
+        if (cur->resource->methods & method_flag) {
+            found = cur;
+            break;
+        }
+        res = -EPERM;
+    }
+
+    /* a subtree resource takes precedence if it was added before */
+    for (uint16_t i = index->subtree; i; i = index->entries[i - 1].next) {
+        const coap_resource_index_entry_t *cur = &index->entries[i - 1];
+
+        if (found && (cur > found)) {
+            break;
+        }
+        if (coap_match_path_pkt(cur->resource, pkt)) {
+            continue;
+        }
+        if (cur->resource->methods & method_flag) {
+            found = cur;
+            break;
+        }
+        res = -EPERM;
+    }
+
+    if (found) {
+        *entry = found;
+        return 0;
+    }
+    return res;
+}
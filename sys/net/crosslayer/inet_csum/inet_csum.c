@@ -13,13 +13,122 @@
  */
 
 #include <inttypes.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
+#if defined(CPU_NATIVE) && (defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* words that may be used to read any (aligned) buffer */
+typedef uint16_t __attribute__((__may_alias__)) _csum_half_t;
+typedef uint32_t __attribute__((__may_alias__)) _csum_word_t;
+
+#if defined(CPU_NATIVE) && defined(__AVX2__)
+#define CSUM_VEC_SIZE   (32U)
+
+/* Sums all 16-bit words in chunks of CSUM_VEC_SIZE bytes in host byte order.
+ * The 32-bit lanes can not overflow, as len is at most UINT16_MAX */
+static uint64_t _sum_vec(const uint8_t *buf, size_t len)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    uint32_t lanes[8];
+    uint64_t sum = 0;
+
+    for (; len >= CSUM_VEC_SIZE; buf += CSUM_VEC_SIZE, len -= CSUM_VEC_SIZE) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)buf);
+        acc = _mm256_add_epi32(acc, _mm256_unpacklo_epi16(v, zero));
+        acc = _mm256_add_epi32(acc, _mm256_unpackhi_epi16(v, zero));
+    }
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    for (unsigned i = 0; i < 8; i++) {
+        sum += lanes[i];
+    }
+    return sum;
+}
+#elif defined(CPU_NATIVE) && defined(__SSE2__)
+#define CSUM_VEC_SIZE   (16U)
+
+/* Sums all 16-bit words in chunks of CSUM_VEC_SIZE bytes in host byte order.
+ * The 32-bit lanes can not overflow, as len is at most UINT16_MAX */
+static uint64_t _sum_vec(const uint8_t *buf, size_t len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    uint32_t lanes[4];
+    uint64_t sum = 0;
+
+    for (; len >= CSUM_VEC_SIZE; buf += CSUM_VEC_SIZE, len -= CSUM_VEC_SIZE) {
+        __m128i v = _mm_loadu_si128((const __m128i *)buf);
+        acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v, zero));
+        acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(v, zero));
+    }
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    for (unsigned i = 0; i < 4; i++) {
+        sum += lanes[i];
+    }
+    return sum;
+}
+#endif
+
+/* Sums up an even number of bytes as 16-bit words in host byte order.
+ * Carries are kept in the upper bits of the result and folded by the caller */
+static uint64_t _sum_words(const uint8_t *buf, size_t len)
+{
+    uint64_t sum = 0;
+
+#ifdef CSUM_VEC_SIZE
+    if (len >= CSUM_VEC_SIZE) {
+        sum = _sum_vec(buf, len);
+        buf += len & ~(CSUM_VEC_SIZE - 1);
+        len &= (CSUM_VEC_SIZE - 1);
+    }
+#endif
+
+    if (((uintptr_t)buf & 1) == 0) {
+        /* align to 32-bit words */
+        if (((uintptr_t)buf & 2) && (len >= 2)) {
+            sum += *((const _csum_half_t *)buf);
+            buf += 2;
+            len -= 2;
+        }
+        for (; len >= 4; buf += 4, len -= 4) {
+            sum += *((const _csum_word_t *)buf);
+        }
+    }
+    else {
+        for (; len >= 4; buf += 4, len -= 4) {
+            uint32_t word;
+            memcpy(&word, buf, sizeof(word));
+            sum += word;
+        }
+    }
+
+    if (len >= 2) {
+        uint16_t word;
+        memcpy(&word, buf, sizeof(word));
+        sum += word;
+    }
+    return sum;
+}
+
+static inline uint16_t _fold(uint64_t sum)
+{
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)sum;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -44,18 +153,15 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
-    }
+    /* The one's complement sum is independent of byte order (RFC 1071, 2.(B)):
+     * sum up in host byte order and swap the folded result */
+    csum += ntohs(_fold(_sum_words(buf, len & ~1)));
+    buf += len & ~1;
 
     if ((accum_len + len) & 1)          /* if accumulated length is odd */
         csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
 
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
-    }
+    csum = _fold(csum);
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
@@ -29,6 +29,7 @@
 #include "net/netstats.h"
 #endif
 #include "fmt.h"
+#include "irq.h"
 #include "log.h"
 #include "sched.h"
 #include "xtimer.h"
@@ -1267,6 +1268,54 @@ static void _test_options(gnrc_netif_t *netif)
 }
 #endif /* DEVELHELP */
 
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+/* Serves the device after an interrupt: netdev_driver_t::isr() is called
+ * again only for interrupts the device raised meanwhile, see _event_cb(),
+ * up to GNRC_NETIF_RX_BUDGET times */
+static void _isr_batch(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    unsigned budget = GNRC_NETIF_RX_BUDGET;
+    bool pending;
+
+    netif->rx_batch = 0;
+    netif->rx_isr = GNRC_NETIF_RX_ISR_SERVING;
+    do {
+        dev->driver->isr(dev);
+        budget--;
+
+        unsigned state = irq_disable();
+        pending = (netif->rx_isr == GNRC_NETIF_RX_ISR_PENDING);
+        /* leave the serving state atomically with the check, so an
+         * interrupt from now on queues a message again */
+        netif->rx_isr = (pending && budget) ? GNRC_NETIF_RX_ISR_SERVING
+                                            : GNRC_NETIF_RX_ISR_IDLE;
+        irq_restore(state);
+    } while (pending && budget);
+
+    if (pending) {
+        /* serve the interrupt after the other queued messages */
+        msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
+                      .content = { .ptr = netif } };
+
+        if (msg_send_to_self(&msg) <= 0) {
+            puts("gnrc_netif: possibly lost interrupt.");
+        }
+    }
+#ifdef MODULE_NETSTATS_L2
+    if (netif->rx_batch > 0) {
+        netif->stats.rx_batches++;
+        if (netif->rx_batch > netif->stats.rx_batch_max) {
+            netif->stats.rx_batch_max = netif->rx_batch;
+        }
+    }
+    if (pending) {
+        netif->stats.rx_budget_exhausted++;
+    }
+#endif
+}
+#endif
+
 static void *_gnrc_netif_thread(void *args)
 {
     gnrc_netapi_opt_t *opt;
@@ -1326,7 +1375,11 @@ static void *_gnrc_netif_thread(void *args)
         switch (msg.type) {
             case NETDEV_MSG_TYPE_EVENT:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+                _isr_batch(netif);
+#else
                 dev->driver->isr(dev);
+#endif
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
@@ -1413,6 +1466,16 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
         msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
                       .content = { .ptr = netif } };
 
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+        unsigned state = irq_disable();
+        if (netif->rx_isr != GNRC_NETIF_RX_ISR_IDLE) {
+            /* the thread serves the device, _isr_batch() picks this up */
+            netif->rx_isr = GNRC_NETIF_RX_ISR_PENDING;
+            irq_restore(state);
+            return;
+        }
+        irq_restore(state);
+#endif
         if (msg_send(&msg, netif->pid) <= 0) {
             puts("gnrc_netif: possibly lost interrupt.");
         }
@@ -1424,6 +1487,9 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             case NETDEV_EVENT_RX_COMPLETE:
                 pkt = netif->ops->recv(netif);
                 if (pkt) {
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+                    netif->rx_batch++;
+#endif
                     _pass_on_packet(pkt);
                 }
                 break;
@@ -28,14 +28,93 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+#if (GNRC_NETREG_HASH_SIZE & (GNRC_NETREG_HASH_SIZE - 1)) != 0
+#error "GNRC_NETREG_HASH_SIZE must be a power of 2"
+#endif
+
+/**
+ * @brief   Slot of the registry's hash table
+ *
+ * All entries of a slot share gnrc_netreg_entry_t::demux_ctx and the type they
+ * were registered with and are linked via gnrc_netreg_entry_t::next.
+ */
+typedef struct {
+    gnrc_netreg_entry_t *head;  /**< entries registered for this key */
+    uint32_t demux_ctx;         /**< demux context of the entries */
+    gnrc_nettype_t type;        /**< type of the entries */
+} _netreg_slot_t;
+
+/* The registry as open addressing hash table by (gnrc_nettype_t, demux_ctx) */
+static _netreg_slot_t netreg[GNRC_NETREG_HASH_SIZE];
+#else
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#endif
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
+}
+
+#ifdef MODULE_GNRC_NETREG_HASH
+static inline unsigned _hash(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* Fibonacci hashing, demux contexts are often consecutive ports */
+    uint32_t h = (demux_ctx ^ ((uint32_t)type << 24)) * 0x9e3779b1U;
+
+    return (h >> 16) & (GNRC_NETREG_HASH_SIZE - 1);
+}
+
+/**
+ * @brief   Searches the slot for the given key
+ *
+ * @return  The slot of the key
+ * @return  The first free slot of the key's probe sequence, if the key is not
+ *          in the table
+ * @return  NULL if the key is not in the table and the table is full
+ */
+static _netreg_slot_t *_slot_find(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    unsigned idx = _hash(type, demux_ctx);
+
+    for (unsigned i = 0; i < GNRC_NETREG_HASH_SIZE; i++) {
+        _netreg_slot_t *slot = &netreg[idx];
+
+        if ((slot->head == NULL) ||
+            ((slot->type == type) && (slot->demux_ctx == demux_ctx))) {
+            return slot;
+        }
+        idx = (idx + 1) & (GNRC_NETREG_HASH_SIZE - 1);
+    }
+    return NULL;
+}
+
+/* shifts the following slots of the probe sequence back into a slot emptied
+ * by unregistration, so lookups never need tombstones */
+static void _slot_free(_netreg_slot_t *slot)
+{
+    unsigned free_idx = slot - netreg;
+    unsigned idx = free_idx;
+
+    netreg[free_idx].head = NULL;
+    while (1) {
+        idx = (idx + 1) & (GNRC_NETREG_HASH_SIZE - 1);
+        if ((idx == free_idx) || (netreg[idx].head == NULL)) {
+            return;
+        }
+        unsigned home = _hash(netreg[idx].type, netreg[idx].demux_ctx);
+        /* move the slot if its home is not cyclically within (free_idx, idx] */
+        if (((idx - home) & (GNRC_NETREG_HASH_SIZE - 1)) >=
+            ((idx - free_idx) & (GNRC_NETREG_HASH_SIZE - 1))) {
+            netreg[free_idx] = netreg[idx];
+            netreg[idx].head = NULL;
+            free_idx = idx;
+        }
+    }
 }
+#endif
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
 {
@@ -59,7 +138,18 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    _netreg_slot_t *slot = _slot_find(type, entry->demux_ctx);
+
+    if (slot == NULL) {
+        return -ENOMEM;
+    }
+    slot->type = type;
+    slot->demux_ctx = entry->demux_ctx;
+    LL_PREPEND(slot->head, entry);
+#else
     LL_PREPEND(netreg[type], entry);
+#endif
 
     return 0;
 }
@@ -70,7 +160,19 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    _netreg_slot_t *slot = _slot_find(type, entry->demux_ctx);
+
+    if ((slot == NULL) || (slot->head == NULL)) {
+        return;
+    }
+    LL_DELETE(slot->head, entry);
+    if (slot->head == NULL) {
+        _slot_free(slot);
+    }
+#else
     LL_DELETE(netreg[type], entry);
+#endif
 }
 
 /**
@@ -91,10 +193,22 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
 {
     gnrc_netreg_entry_t *res = NULL;
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    /* all entries linked to a slot share type and demux context */
+    if (from) {
+        res = from->next;
+    }
+    else if (!_INVALID_TYPE(type)) {
+        _netreg_slot_t *slot = _slot_find(type, demux_ctx);
+
+        res = (slot) ? slot->head : NULL;
+    }
+#else
     if (from || !_INVALID_TYPE(type)) {
         gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
         LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
     }
+#endif
 
     return res;
 }
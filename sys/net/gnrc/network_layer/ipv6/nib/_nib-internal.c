@@ -43,6 +43,24 @@ static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 static _nib_abr_entry_t _abrs[GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 
+#if GNRC_IPV6_NIB_ONL_HASH_NUMOF
+/* on-link entries with a specified address, chained by hash of the address */
+static _nib_onl_entry_t *_onl_buckets[GNRC_IPV6_NIB_ONL_HASH_NUMOF];
+static _nib_onl_entry_t *_onl_chain[GNRC_IPV6_NIB_NUMOF];
+#endif  /* GNRC_IPV6_NIB_ONL_HASH_NUMOF */
+
+#if GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+typedef struct {
+    ipv6_addr_t dst;            /**< destination */
+    _nib_offl_entry_t *offl;    /**< best matching off-link entry for dst */
+    unsigned gen;               /**< _offl_gen the entry is valid for */
+} _route_cache_entry_t;
+
+static _route_cache_entry_t _route_cache[GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF];
+/* changes whenever off-link entries are added or removed, 0 is never valid */
+static unsigned _offl_gen = 1;
+#endif  /* GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 mutex_t _nib_mutex = MUTEX_INIT;
@@ -52,6 +70,81 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
 static inline bool _node_unreachable(_nib_onl_entry_t *node);
 
+#if GNRC_IPV6_NIB_ONL_HASH_NUMOF || GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+static inline unsigned _addr_hash(const ipv6_addr_t *addr)
+{
+    /* neighbors mostly differ in their interface identifier, but fold in the
+     * prefix so link-local and global addresses of a node spread as well */
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return hash;
+}
+#endif
+
+#if GNRC_IPV6_NIB_ONL_HASH_NUMOF
+static inline _nib_onl_entry_t **_onl_bucket(const ipv6_addr_t *addr)
+{
+    return &_onl_buckets[_addr_hash(addr) % GNRC_IPV6_NIB_ONL_HASH_NUMOF];
+}
+
+static void _onl_index(_nib_onl_entry_t *node)
+{
+    if (!ipv6_addr_is_unspecified(&node->ipv6)) {
+        _nib_onl_entry_t **bucket = _onl_bucket(&node->ipv6);
+
+        _onl_chain[node - _nodes] = *bucket;
+        *bucket = node;
+    }
+}
+
+static void _onl_unindex(_nib_onl_entry_t *node)
+{
+    if (!ipv6_addr_is_unspecified(&node->ipv6)) {
+        _nib_onl_entry_t **ptr = _onl_bucket(&node->ipv6);
+
+        while ((*ptr != NULL) && (*ptr != node)) {
+            ptr = &_onl_chain[*ptr - _nodes];
+        }
+        if (*ptr != NULL) {
+            *ptr = _onl_chain[node - _nodes];
+        }
+    }
+}
+#else   /* GNRC_IPV6_NIB_ONL_HASH_NUMOF */
+static inline void _onl_index(_nib_onl_entry_t *node)
+{
+    (void)node;
+}
+
+static inline void _onl_unindex(_nib_onl_entry_t *node)
+{
+    (void)node;
+}
+#endif  /* GNRC_IPV6_NIB_ONL_HASH_NUMOF */
+
+static inline void _offl_changed(void)
+{
+#if GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+    _offl_gen++;
+    if (_offl_gen == 0) {
+        _offl_gen++;
+    }
+#endif  /* GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
+}
+
+static void _onl_set_addr(_nib_onl_entry_t *node, const ipv6_addr_t *addr)
+{
+    if (!ipv6_addr_equal(addr, &node->ipv6)) {
+        _onl_unindex(node);
+        memcpy(&node->ipv6, addr, sizeof(node->ipv6));
+        _onl_index(node);
+    }
+}
+
 void _nib_init(void)
 {
 #ifdef TEST_SUITES
@@ -63,7 +156,11 @@ void _nib_init(void)
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
+#if GNRC_IPV6_NIB_ONL_HASH_NUMOF
+    memset(_onl_buckets, 0, sizeof(_onl_buckets));
+#endif  /* GNRC_IPV6_NIB_ONL_HASH_NUMOF */
 #endif  /* TEST_SUITES */
+    _offl_changed();
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -204,20 +301,50 @@ _nib_onl_entry_t *_nib_onl_iter(const _nib_onl_entry_t *last)
     return NULL;
 }
 
+static inline bool _onl_matches(const _nib_onl_entry_t *node,
+                                const ipv6_addr_t *addr, unsigned iface)
+{
+    return (node->mode != _EMPTY) &&
+           /* either requested or current interface undefined or
+            * interfaces equal */
+           ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+            (_nib_onl_get_if(node) == iface)) &&
+           ipv6_addr_equal(&node->ipv6, addr);
+}
+
 _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
 {
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_ONL_HASH_NUMOF
+    /* entries with the unspecified address are not in the index, and a
+     * link-local address without interface may match entries on several
+     * interfaces: leave both to the linear search */
+    if (!ipv6_addr_is_unspecified(addr) &&
+        ((iface != 0) || !ipv6_addr_is_link_local(addr))) {
+        _nib_onl_entry_t *res = NULL;
+
+        for (_nib_onl_entry_t *node = *_onl_bucket(addr); node != NULL;
+             node = _onl_chain[node - _nodes]) {
+            /* prefer the first match in _nodes, as the linear search would */
+            if (_onl_matches(node, addr, iface) &&
+                ((res == NULL) || (node < res))) {
+                res = node;
+            }
+        }
+        if (res != NULL) {
+            DEBUG("  Found %p\n", (void *)res);
+            return res;
+        }
+        DEBUG("  No suitable entry found\n");
+        return NULL;
+    }
+#endif  /* GNRC_IPV6_NIB_ONL_HASH_NUMOF */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
-        if ((node->mode != _EMPTY) &&
-            /* either requested or current interface undefined or
-             * interfaces equal */
-            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
-             (_nib_onl_get_if(node) == iface)) &&
-            ipv6_addr_equal(&node->ipv6, addr)) {
+        if (_onl_matches(node, addr, iface)) {
             DEBUG("  Found %p\n", (void *)node);
             return node;
         }
@@ -226,6 +353,16 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     return NULL;
 }
 
+bool _nib_onl_clear(_nib_onl_entry_t *node)
+{
+    if (node->mode == _EMPTY) {
+        _onl_unindex(node);
+        memset(node, 0, sizeof(_nib_onl_entry_t));
+        return true;
+    }
+    return false;
+}
+
 void _nib_nc_set_reachable(_nib_onl_entry_t *node)
 {
 #if GNRC_IPV6_NIB_CONF_ARSM
@@ -481,9 +618,11 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             /* exact match (or next hop address was previously unset) */
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
-                memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+                _onl_set_addr(tmp_node, next_hop);
             }
             tmp->next_hop->mode |= _DST;
+            /* caller may change the entry's mode */
+            _offl_changed();
             return tmp;
         }
         if ((dst == NULL) && (tmp_node == NULL)) {
@@ -502,6 +641,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _offl_changed();
     }
     return dst;
 }
@@ -520,6 +660,8 @@ static inline bool _in_abrs(const _nib_abr_entry_t *abr)
 
 void _nib_offl_clear(_nib_offl_entry_t *dst)
 {
+    /* the entry's mode may have changed even if it isn't cleared */
+    _offl_changed();
     if (dst->next_hop != NULL) {
         _nib_offl_entry_t *ptr;
         for (ptr = _dsts; _in_dsts(ptr); ptr++) {
@@ -585,6 +727,26 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
     return res;
 }
 
+static _nib_offl_entry_t *_route_cache_get_match(const ipv6_addr_t *dst)
+{
+#if GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+    _route_cache_entry_t *entry;
+
+    entry = &_route_cache[_addr_hash(dst) % GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF];
+    if ((entry->gen == _offl_gen) && ipv6_addr_equal(&entry->dst, dst)) {
+        DEBUG("nib: route cache hit for %s\n",
+              ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+        return entry->offl;
+    }
+    memcpy(&entry->dst, dst, sizeof(entry->dst));
+    entry->offl = _nib_offl_get_match(dst);
+    entry->gen = _offl_gen;
+    return entry->offl;
+#else   /* GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
+    return _nib_offl_get_match(dst);
+#endif  /* GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
+}
+
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
 {
     assert((dst != NULL) && (dst->next_hop != NULL) && (fte != NULL));
@@ -607,7 +769,7 @@ int _nib_get_route(const ipv6_addr_t *dst, gnrc_pktsnip_t *pkt,
     DEBUG("nib: get route %s for packet %p\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)),
           (void *)pkt);
-    _nib_offl_entry_t *offl = _nib_offl_get_match(dst);
+    _nib_offl_entry_t *offl = _route_cache_get_match(dst);
 
     if ((offl == NULL) || (offl->mode == _PL)) {
         /* give default router precedence over PLE */
@@ -810,7 +972,7 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
 {
     _nib_onl_clear(node);
     if (addr != NULL) {
-        memcpy(&node->ipv6, addr, sizeof(node->ipv6));
+        _onl_set_addr(node, addr);
     }
     _nib_onl_set_if(node, iface);
 }
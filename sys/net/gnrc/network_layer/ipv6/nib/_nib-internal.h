@@ -312,14 +312,7 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
  * @return  true, if entry was cleared.
  * @return  false, if entry was not cleared.
  */
-static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
-{
-    if (node->mode == _EMPTY) {
-        memset(node, 0, sizeof(_nib_onl_entry_t));
-        return true;
-    }
-    return false;
-}
+bool _nib_onl_clear(_nib_onl_entry_t *node);
 
 /**
  * @brief   Iterates over on-link entries
@@ -15,6 +15,7 @@
 #include <inttypes.h>
 #include <stdbool.h>
 
+#include "kernel_defines.h"
 #include "rbuf.h"
 #include "net/ipv6.h"
 #include "net/ipv6/hdr.h"
@@ -28,6 +29,9 @@
 #include "thread.h"
 #include "xtimer.h"
 #include "utlist.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+#include "bitfield.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -39,16 +43,61 @@
 #define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
 #endif
 
-#ifndef RBUF_INT_SIZE
 /* same as ((int) ceil((double) N / D)) */
 #define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
+
+#ifndef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+#ifndef RBUF_INT_SIZE
 #define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
 #endif
 
 static gnrc_sixlowpan_rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 
 static gnrc_sixlowpan_rbuf_t rbuf[RBUF_SIZE];
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+/* the virtual reassembly buffer takes over the interval list of an entry,
+ * which is left empty with the hashed reassembly buffer */
+#error "gnrc_sixlowpan_frag_rbuf_hash can't be used with gnrc_sixlowpan_frag_vrb"
+#endif
+
+#if (GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS & (GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS - 1))
+#error "GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS must be a power of 2"
+#endif
+
+#if (RBUF_SIZE >= UINT8_MAX)
+#error "GNRC_SIXLOWPAN_FRAG_RBUF_SIZE too large"
+#endif
+
+/* number of 8 byte units of the largest accepted datagram */
+#define RBUF_UNITS  (DIV_CEIL(GNRC_SIXLOWPAN_FRAG_RBUF_DATAGRAM_MAX, 8U))
+
+/* 32 bit FNV-1a */
+#define FNV_OFFSET  (2166136261UL)
+#define FNV_PRIME   (16777619UL)
+
+/* index state of a reassembly buffer entry, all links are index + 1 with 0
+ * marking the end of a list */
+typedef struct {
+    BITFIELD(starts, RBUF_UNITS);   /* units a received fragment starts at */
+    BITFIELD(received, RBUF_UNITS); /* units covered by received fragments */
+    uint32_t hash;                  /* hash of the identifying tuple */
+    uint8_t next;                   /* next entry in bucket or free list */
+    uint8_t older;                  /* previous entry in LRU list */
+    uint8_t newer;                  /* next entry in LRU list */
+} _rbuf_idx_t;
+
+static _rbuf_idx_t _idx[RBUF_SIZE];
+static uint8_t _buckets[GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS];
+static uint8_t _lru_oldest, _lru_newest;
+/* entries released by rbuf_rm() */
+static uint8_t _free;
+/* entries never used yet, so the state needs no initialization */
+static uint8_t _unused_from;
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
+
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
 static xtimer_t _gc_timer;
@@ -57,11 +106,13 @@ static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
+#ifndef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
 /* checks whether start and end overlaps, but not identical to, given interval i */
 static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_rbuf_int_t *i,
                                                uint16_t start, uint16_t end);
 /* gets a free entry from interval buffer */
 static gnrc_sixlowpan_rbuf_int_t *_rbuf_int_get_free(void);
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 /* update interval buffer of entry */
 static bool _rbuf_update_ints(gnrc_sixlowpan_rbuf_base_t *entry,
                               uint16_t offset, size_t frag_size);
@@ -91,6 +142,57 @@ gnrc_sixlowpan_frag_stats_t *gnrc_sixlowpan_frag_stats_get(void)
 }
 #endif
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+static inline _rbuf_idx_t *_rbuf_idx(gnrc_sixlowpan_rbuf_base_t *entry)
+{
+    return &_idx[container_of(entry, gnrc_sixlowpan_rbuf_t, super) - rbuf];
+}
+
+static int _check_fragments(gnrc_sixlowpan_rbuf_base_t *entry,
+                            size_t frag_size, size_t offset)
+{
+    _rbuf_idx_t *idx = _rbuf_idx(entry);
+    unsigned start = offset / 8U;
+    unsigned end;
+    bool overlap = false;
+    bool identical;
+
+    if (frag_size == 0) {
+        /* nothing to add */
+        return RBUF_ADD_DUPLICATE;
+    }
+    end = (offset + frag_size - 1) / 8U;
+    identical = bf_isset(idx->starts, start);
+    /* fragments start at 8 byte boundaries, so they overlap iff they share a
+     * unit. A fragment is identical to a received one iff that one starts at
+     * the same unit and covers exactly the same units (see
+     * https://tools.ietf.org/html/rfc4944#section-5.3) */
+    for (unsigned i = start; i <= end; i++) {
+        if (bf_isset(idx->received, i)) {
+            overlap = true;
+        }
+        else {
+            identical = false;
+        }
+        if ((i != start) && bf_isset(idx->starts, i)) {
+            identical = false;
+        }
+    }
+    if (!overlap) {
+        return RBUF_ADD_SUCCESS;
+    }
+    if (identical && (((end + 1) >= RBUF_UNITS) ||
+                      !bf_isset(idx->received, end + 1) ||
+                      bf_isset(idx->starts, end + 1))) {
+        DEBUG("6lo rbuf: fragment already in reassembly buffer");
+        return RBUF_ADD_DUPLICATE;
+    }
+    /* "A fresh reassembly may be commenced with the most recently
+     * received link fragment"
+     * https://tools.ietf.org/html/rfc4944#section-5.3 */
+    return RBUF_ADD_REPEAT;
+}
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 static int _check_fragments(gnrc_sixlowpan_rbuf_base_t *entry,
                             size_t frag_size, size_t offset)
 {
@@ -116,6 +218,7 @@ static int _check_fragments(gnrc_sixlowpan_rbuf_base_t *entry,
     }
     return RBUF_ADD_SUCCESS;
 }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
               size_t offset, unsigned page)
@@ -214,6 +317,7 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     return RBUF_ADD_SUCCESS;
 }
 
+#ifndef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
 static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_rbuf_int_t *i,
                                                uint16_t start, uint16_t end)
 {
@@ -232,9 +336,105 @@ static gnrc_sixlowpan_rbuf_int_t *_rbuf_int_get_free(void)
 
     return NULL;
 }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+static uint32_t _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len,
+                           size_t size, uint16_t tag)
+{
+    uint32_t hash = FNV_OFFSET;
+
+    for (size_t i = 0; i < src_len; i++) {
+        hash = (hash ^ src[i]) * FNV_PRIME;
+    }
+    for (size_t i = 0; i < dst_len; i++) {
+        hash = (hash ^ dst[i]) * FNV_PRIME;
+    }
+    hash = (hash ^ (tag & 0xff)) * FNV_PRIME;
+    hash = (hash ^ (tag >> 8)) * FNV_PRIME;
+    hash = (hash ^ (size & 0xff)) * FNV_PRIME;
+    hash = (hash ^ (size >> 8)) * FNV_PRIME;
+    return hash;
+}
+
+static inline uint8_t *_rbuf_bucket(uint32_t hash)
+{
+    return &_buckets[hash & (GNRC_SIXLOWPAN_FRAG_RBUF_BUCKETS - 1)];
+}
+
+static void _lru_unlink(unsigned i)
+{
+    _rbuf_idx_t *idx = &_idx[i];
+
+    if (idx->older) {
+        _idx[idx->older - 1].newer = idx->newer;
+    }
+    else {
+        _lru_oldest = idx->newer;
+    }
+    if (idx->newer) {
+        _idx[idx->newer - 1].older = idx->older;
+    }
+    else {
+        _lru_newest = idx->older;
+    }
+    idx->older = 0;
+    idx->newer = 0;
+}
+
+static void _lru_push(unsigned i)
+{
+    _idx[i].older = _lru_newest;
+    _idx[i].newer = 0;
+    if (_lru_newest) {
+        _idx[_lru_newest - 1].newer = i + 1;
+    }
+    else {
+        _lru_oldest = i + 1;
+    }
+    _lru_newest = i + 1;
+}
+
+/* links a newly created entry into its bucket and as the most recently used */
+static void _rbuf_link(gnrc_sixlowpan_rbuf_t *entry, uint32_t hash)
+{
+    unsigned i = entry - rbuf;
+    uint8_t *bucket = _rbuf_bucket(hash);
+
+    memset(_idx[i].starts, 0, sizeof(_idx[i].starts));
+    memset(_idx[i].received, 0, sizeof(_idx[i].received));
+    _idx[i].hash = hash;
+    _idx[i].next = *bucket;
+    *bucket = i + 1;
+    _lru_push(i);
+}
+
+static void _rbuf_unlink(gnrc_sixlowpan_rbuf_t *entry)
+{
+    unsigned i = entry - rbuf;
+    uint8_t *link = _rbuf_bucket(_idx[i].hash);
+
+    while (*link && (*link != (i + 1))) {
+        link = &_idx[*link - 1].next;
+    }
+    if (*link) {
+        *link = _idx[i].next;
+    }
+    _lru_unlink(i);
+    _idx[i].next = _free;
+    _free = i + 1;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 
 void rbuf_rm(gnrc_sixlowpan_rbuf_t *entry)
 {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+    /* only entries with a packet are linked */
+    if (entry->pkt != NULL) {
+        _rbuf_unlink(entry);
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
     gnrc_sixlowpan_frag_rbuf_base_rm(&entry->super);
     entry->pkt = NULL;
 }
@@ -242,6 +442,23 @@ void rbuf_rm(gnrc_sixlowpan_rbuf_t *entry)
 static bool _rbuf_update_ints(gnrc_sixlowpan_rbuf_base_t *entry,
                               uint16_t offset, size_t frag_size)
 {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+    _rbuf_idx_t *idx = _rbuf_idx(entry);
+    unsigned end = (offset + frag_size - 1) / 8U;
+
+    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %u) to entry (%s, ",
+          offset, (unsigned)(offset + frag_size - 1),
+          gnrc_netif_addr_to_str(entry->src, entry->src_len, l2addr_str));
+    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst,
+                                                  entry->dst_len,
+                                                  l2addr_str),
+          entry->datagram_size, entry->tag);
+    bf_set(idx->starts, offset / 8U);
+    for (unsigned i = offset / 8U; i <= end; i++) {
+        bf_set(idx->received, i);
+    }
+    return true;
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
     gnrc_sixlowpan_rbuf_int_t *new;
     uint16_t end = (uint16_t)(offset + frag_size - 1);
 
@@ -267,31 +484,42 @@ static bool _rbuf_update_ints(gnrc_sixlowpan_rbuf_base_t *entry,
     LL_PREPEND(entry->ints, new);
 
     return true;
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
+}
+
+static void _rbuf_timed_out(gnrc_sixlowpan_rbuf_t *entry)
+{
+    DEBUG("6lo rfrag: entry (%s, ",
+          gnrc_netif_addr_to_str(entry->super.src, entry->super.src_len,
+                                 l2addr_str));
+    DEBUG("%s, %u, %u) timed out\n",
+          gnrc_netif_addr_to_str(entry->super.dst, entry->super.dst_len,
+                                 l2addr_str),
+          (unsigned)entry->super.datagram_size, entry->super.tag);
+
+    gnrc_pktbuf_release(entry->pkt);
+    rbuf_rm(entry);
 }
 
 void rbuf_gc(void)
 {
     uint32_t now_usec = xtimer_now_usec();
-    unsigned int i;
 
-    for (i = 0; i < RBUF_SIZE; i++) {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+    /* the LRU list is ordered by arrival, so stop at the first live entry */
+    while (_lru_oldest &&
+           ((now_usec - rbuf[_lru_oldest - 1].super.arrival) > RBUF_TIMEOUT)) {
+        _rbuf_timed_out(&rbuf[_lru_oldest - 1]);
+    }
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
         /* since pkt occupies pktbuf, aggressivly collect garbage */
         if (!rbuf_entry_empty(&rbuf[i]) &&
               ((now_usec - rbuf[i].super.arrival) > RBUF_TIMEOUT)) {
-            DEBUG("6lo rfrag: entry (%s, ",
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
-
-            gnrc_pktbuf_release(rbuf[i].pkt);
-            rbuf_rm(&(rbuf[i]));
+            _rbuf_timed_out(&rbuf[i]);
         }
     }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
     gnrc_sixlowpan_frag_vrb_gc();
 #endif
@@ -302,14 +530,111 @@ static inline void _set_rbuf_timeout(void)
     xtimer_set_msg(&_gc_timer, RBUF_TIMEOUT, &_gc_timer_msg, sched_active_pid);
 }
 
+static void _rbuf_found(gnrc_sixlowpan_rbuf_t *entry, uint32_t now_usec)
+{
+    DEBUG("6lo rfrag: entry %p (%s, ", (void *)entry,
+          gnrc_netif_addr_to_str(entry->super.src, entry->super.src_len,
+                                 l2addr_str));
+    DEBUG("%s, %u, %u) found\n",
+          gnrc_netif_addr_to_str(entry->super.dst, entry->super.dst_len,
+                                 l2addr_str),
+          (unsigned)entry->super.datagram_size, entry->super.tag);
+    entry->super.arrival = now_usec;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    _stats.rbuf_hit++;
+#endif
+    _set_rbuf_timeout();
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+static gnrc_sixlowpan_rbuf_t *_rbuf_lookup(uint32_t hash,
+                                           const void *src, size_t src_len,
+                                           const void *dst, size_t dst_len,
+                                           size_t size, uint16_t tag)
+{
+    for (uint8_t i = *_rbuf_bucket(hash); i; i = _idx[i - 1].next) {
+        gnrc_sixlowpan_rbuf_t *entry = &rbuf[i - 1];
+
+        if ((_idx[i - 1].hash == hash) &&
+            (entry->super.datagram_size == size) &&
+            (entry->super.tag == tag) && (entry->super.src_len == src_len) &&
+            (entry->super.dst_len == dst_len) &&
+            (memcmp(entry->super.src, src, src_len) == 0) &&
+            (memcmp(entry->super.dst, dst, dst_len) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* gets an unlinked entry, evicting the least recently used one if needed */
+static gnrc_sixlowpan_rbuf_t *_rbuf_alloc(uint32_t now_usec)
+{
+    if (!_free && (_unused_from < RBUF_SIZE)) {
+        return &rbuf[_unused_from++];
+    }
+    if (!_free) {
+        assert(_lru_oldest);
+        gnrc_sixlowpan_rbuf_t *oldest = &rbuf[_lru_oldest - 1];
+
+        if (!GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE &&
+            ((now_usec - oldest->super.arrival) <=
+             GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)) {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            _stats.rbuf_full++;
+#endif
+            return NULL;
+        }
+        DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
+        gnrc_pktbuf_release(oldest->pkt);
+        rbuf_rm(oldest);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+#if GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE
+        _stats.rbuf_full++;
+#endif
+        _stats.rbuf_evict++;
+#endif
+    }
+
+    /* rbuf_rm() put the entry on the free list */
+    gnrc_sixlowpan_rbuf_t *res = &rbuf[_free - 1];
+    _free = _idx[_free - 1].next;
+    return res;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
+
 static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
                                         const void *dst, size_t dst_len,
                                         size_t size, uint16_t tag,
                                         unsigned page)
 {
-    gnrc_sixlowpan_rbuf_t *res = NULL, *oldest = NULL;
+    gnrc_sixlowpan_rbuf_t *res = NULL;
     uint32_t now_usec = xtimer_now_usec();
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+    uint32_t hash = _rbuf_hash(src, src_len, dst, dst_len, size, tag);
+
+    res = _rbuf_lookup(hash, src, src_len, dst, dst_len, size, tag);
+    if (res != NULL) {
+        _lru_unlink(res - rbuf);
+        _lru_push(res - rbuf);
+        _rbuf_found(res, now_usec);
+        return res;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    _stats.rbuf_miss++;
+#endif
+    if (size > GNRC_SIXLOWPAN_FRAG_RBUF_DATAGRAM_MAX) {
+        DEBUG("6lo rfrag: datagram too large for reassembly buffer\n");
+        return NULL;
+    }
+    res = _rbuf_alloc(now_usec);
+    if (res == NULL) {
+        return NULL;
+    }
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
+    gnrc_sixlowpan_rbuf_t *oldest = NULL;
+
     for (unsigned int i = 0; i < RBUF_SIZE; i++) {
         /* check first if entry already available */
         if ((rbuf[i].pkt != NULL) && (rbuf[i].super.datagram_size == size) &&
@@ -317,17 +642,7 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
             (rbuf[i].super.dst_len == dst_len) &&
             (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
             (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
-            rbuf[i].super.arrival = now_usec;
-            _set_rbuf_timeout();
+            _rbuf_found(&rbuf[i], now_usec);
             return &(rbuf[i]);
         }
 
@@ -344,6 +659,10 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
         }
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    _stats.rbuf_miss++;
+#endif
+
     /* entry not in buffer and no empty spot found */
     if (res == NULL) {
         assert(oldest != NULL);
@@ -357,9 +676,11 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
             gnrc_pktbuf_release(oldest->pkt);
             rbuf_rm(oldest);
             res = oldest;
-#if GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE && \
-    defined(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+#if GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE
             _stats.rbuf_full++;
+#endif
+            _stats.rbuf_evict++;
 #endif
         }
         else {
@@ -369,6 +690,7 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
             return NULL;
         }
     }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 
     /* now we have an empty spot */
 
@@ -386,8 +708,15 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->pkt = gnrc_pktbuf_add(NULL, NULL, size, reass_type);
     if (res->pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+        _idx[res - rbuf].next = _free;
+        _free = (res - rbuf) + 1;
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
         return NULL;
     }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+    _rbuf_link(res, hash);
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 
     *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
                                                * look-ups */
@@ -417,7 +746,16 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
 void rbuf_reset(void)
 {
     xtimer_remove(&_gc_timer);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+    memset(_idx, 0, sizeof(_idx));
+    memset(_buckets, 0, sizeof(_buckets));
+    _lru_oldest = 0;
+    _lru_newest = 0;
+    _free = 0;
+    _unused_from = 0;
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
     memset(rbuf_int, 0, sizeof(rbuf_int));
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
     for (unsigned int i = 0; i < RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -241,12 +241,13 @@ static inline bool _add_uncompr_disp(gnrc_pktsnip_t *pkt)
 
     DEBUG("6lo: Send uncompressed\n");
 
-    sixlowpan = gnrc_pktbuf_add(NULL, NULL, sizeof(uint8_t), GNRC_NETTYPE_SIXLOWPAN);
+    /* put dispatch in front of the IPv6 header's data if there is headroom */
+    sixlowpan = gnrc_pktbuf_add_header(pkt->next, NULL, sizeof(uint8_t),
+                                       GNRC_NETTYPE_SIXLOWPAN);
 
     if (sixlowpan == NULL) {
         return false;
     }
-    sixlowpan->next = pkt->next;
     pkt->next = sixlowpan;
     disp = sixlowpan->data;
     disp[0] = SIXLOWPAN_UNCOMP;
@@ -664,7 +664,10 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     gnrc_netif_hdr_t *netif_hdr = pkt->data;
     ipv6_hdr_t *ipv6_hdr;
     gnrc_netif_t *iface = gnrc_netif_hdr_get_netif(netif_hdr);
-    uint8_t *iphc_hdr;
+    /* compressed headers are never longer than an uncompressed IPv6 and UDP
+     * header, so compress into a buffer on the stack and only allocate the
+     * dispatch once its final size is known */
+    uint8_t iphc_hdr[sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)];
     gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
     gnrc_pktsnip_t *dispatch, *ptr = pkt->next;
     bool addr_comp = false;
@@ -713,16 +716,6 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
      * function should not be called */
     assert(dispatch_size > 0);
     ipv6_hdr = pkt->next->data;
-    dispatch = gnrc_pktbuf_add(NULL, NULL, dispatch_size,
-                               GNRC_NETTYPE_SIXLOWPAN);
-
-    if (dispatch == NULL) {
-        DEBUG("6lo iphc: error allocating dispatch space\n");
-        gnrc_pktbuf_release(pkt);
-        return;
-    }
-
-    iphc_hdr = dispatch->data;
 
     /* set initial dispatch value*/
     iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
@@ -1000,9 +993,11 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     }
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    gnrc_pktsnip_t *udp = NULL;
+
     switch (ipv6_hdr->nh) {
         case PROTNUM_UDP: {
-            gnrc_pktsnip_t *udp = pkt->next->next;
+            udp = pkt->next->next;
 
             assert(udp->size >= sizeof(udp_hdr_t));
             inline_pos += iphc_nhc_udp_encode(&iphc_hdr[inline_pos], udp);
@@ -1013,11 +1008,10 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 
                 if (udp == NULL) {
                     DEBUG("gnrc_sixlowpan_iphc_encode: unable to mark UDP header\n");
-                    gnrc_pktbuf_release(dispatch);
+                    gnrc_pktbuf_release(pkt);
                     return;
                 }
             }
-            gnrc_pktbuf_remove_snip(pkt, udp);
             break;
         }
         default:
@@ -1025,12 +1019,27 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     }
 #endif
 
-    /* shrink dispatch allocation to final size */
-    /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
-    gnrc_pktbuf_realloc_data(dispatch, (size_t)inline_pos);
+    assert(inline_pos <= sizeof(iphc_hdr));
 
     /* remove IPv6 header */
     pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    /* remove UDP header after the IPv6 header, so the packet buffer can give
+     * the space of both back to the payload's headroom */
+    if (udp != NULL) {
+        gnrc_pktbuf_remove_snip(pkt, udp);
+    }
+#endif
+
+    /* put dispatch into the headroom of the payload if there is enough, so
+     * the frame's payload is contiguous */
+    dispatch = gnrc_pktbuf_add_header(pkt->next, iphc_hdr, (size_t)inline_pos,
+                                      GNRC_NETTYPE_SIXLOWPAN);
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error allocating dispatch space\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
 
     /* insert dispatch into packet */
     dispatch->next = pkt->next;
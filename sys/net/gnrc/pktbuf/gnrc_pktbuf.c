@@ -15,6 +15,10 @@
 
 #include "net/gnrc/pktbuf.h"
 
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+gnrc_pktbuf_counters_t gnrc_pktbuf_counters;
+#endif
+
 gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt,
                                         gnrc_pktsnip_t *snip)
 {
@@ -92,6 +96,7 @@ int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt)
     /* Copy data to new buffer */
     for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
         memcpy(((uint8_t *)pkt->data) + offset, ptr->data, ptr->size);
+        GNRC_PKTBUF_COUNT(copied, ptr->size);
         offset += ptr->size;
     }
 
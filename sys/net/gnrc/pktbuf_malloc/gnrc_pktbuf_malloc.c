@@ -38,13 +38,27 @@
 
 static mutex_t _mutex = MUTEX_INIT;
 
-#ifdef TEST_SUITES
+#if defined(TEST_SUITES) || defined(DEVELHELP) || \
+    defined(MODULE_GNRC_PKTBUF_COUNTERS)
 static unsigned mallocs;
+#ifdef DEVELHELP
+static unsigned max_mallocs;
+#endif
 
 static inline void *_malloc(size_t size)
 {
-    mallocs++;
-    return malloc(size);
+    void *ptr = malloc(size);
+
+    if (ptr != NULL) {
+        mallocs++;
+        GNRC_PKTBUF_COUNT(allocs, 1);
+#ifdef DEVELHELP
+        if (mallocs > max_mallocs) {
+            max_mallocs = mallocs;
+        }
+#endif
+    }
+    return ptr;
 }
 
 static inline void _free(void *ptr)
@@ -78,7 +92,7 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 
 void gnrc_pktbuf_init(void)
 {
-#ifdef TEST_SUITES
+#if defined(TEST_SUITES) || defined(DEVELHELP)
     mallocs = 0;
 #endif
 }
@@ -99,6 +113,27 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t s
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, const void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type)
+{
+    /* headers get their own allocation anyway */
+    (void)headroom;
+    return gnrc_pktbuf_add(next, data, size, type);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add_header(gnrc_pktsnip_t *next, const void *data,
+                                       size_t size, gnrc_nettype_t type)
+{
+    return gnrc_pktbuf_add(next, data, size, type);
+}
+
+size_t gnrc_pktbuf_headroom(const gnrc_pktsnip_t *pkt)
+{
+    (void)pkt;
+    return 0;
+}
+
 static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
 {
     gnrc_pktsnip_t *header;
@@ -131,6 +166,7 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
         return NULL;
     }
     memcpy(payload, ((uint8_t *)pkt->data) + size, pkt->size - size);
+    GNRC_PKTBUF_COUNT(copied, pkt->size - size);
     header_data = realloc(pkt->data, size);
     if (header_data == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
@@ -172,11 +208,20 @@ static int _realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         pkt->data = NULL;
     }
     else {
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+        uintptr_t old = (uintptr_t)pkt->data;
+#endif
         void *data = (pkt->data) ? realloc(pkt->data, size) : _malloc(size);
         if (data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
             return ENOMEM;
         }
+#ifdef MODULE_GNRC_PKTBUF_COUNTERS
+        /* realloc() had to move the data */
+        if ((old != 0) && (old != (uintptr_t)data)) {
+            GNRC_PKTBUF_COUNT(copied, (pkt->size < size) ? pkt->size : size);
+        }
+#endif
         pkt->data = data;
     }
     pkt->size = size;
@@ -252,7 +297,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
 #ifdef DEVELHELP
 void gnrc_pktbuf_stats(void)
 {
-    LOG_INFO("pktbuf: no stat output for gnrc_pktbuf_malloc, use tools like valgrind\n");
+    printf("packet buffer: %u allocations in use, max in use: %u\n",
+           mallocs, max_mallocs);
+    LOG_INFO("pktbuf: no byte or fragmentation stats for gnrc_pktbuf_malloc, "
+             "use tools like valgrind\n");
 }
 #endif
 
@@ -291,6 +339,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
     _set_pktsnip(pkt, next, _data, size, type);
     if (data != NULL) {
         memcpy(_data, data, size);
+        GNRC_PKTBUF_COUNT(copied, size);
     }
     return pkt;
 }
@@ -0,0 +1,630 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer with segregated pools of fixed size blocks
+ *
+ * Packet snips come from a pool linked through gnrc_pktsnip_t::next while
+ * they are free. Packet data comes from one of three pools of blocks, each
+ * with a stack of free block indexes. The pool and block of a data pointer
+ * follow from its address, so gnrc_pktbuf_mark() can split data without
+ * copying: both parts then hold a reference on the block.
+ *
+ * Each block also remembers the offset of its front-most data. Everything in
+ * front of it is unused, so gnrc_pktbuf_add_header() can put a header right in
+ * front of the data of `next` (see gnrc_pktbuf_add_headroom()).
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _CLASSES_NUMOF  (3U)
+
+typedef struct {
+    uint8_t *blocks;        /**< first block */
+    uint8_t *refs;          /**< references on each block */
+    uint8_t *free;          /**< stack of free block indexes */
+    uint16_t *front;        /**< offset of the front-most data in each block */
+#ifdef DEVELHELP
+    uint16_t *len;          /**< bytes requested of each block */
+    uint16_t failed;        /**< allocations that fell through this pool */
+    uint8_t max_used;       /**< high-water mark of blocks in use */
+#endif
+    uint16_t size;          /**< size of a block */
+    uint8_t numof;          /**< number of blocks */
+    uint8_t free_numof;     /**< number of free blocks */
+} _pool_t;
+
+#ifdef DEVELHELP
+#define _POOL(name, size, numof) \
+    static uint8_t name ## _blocks[(size) * (numof)] __attribute__((aligned(4))); \
+    static uint8_t name ## _refs[numof]; \
+    static uint8_t name ## _free[numof]; \
+    static uint16_t name ## _front[numof]; \
+    static uint16_t name ## _len[numof]
+#define _POOL_INIT(name, size, numof) \
+    { name ## _blocks, name ## _refs, name ## _free, name ## _front, \
+      name ## _len, 0, 0, (size), (numof), 0 }
+#else
+#define _POOL(name, size, numof) \
+    static uint8_t name ## _blocks[(size) * (numof)] __attribute__((aligned(4))); \
+    static uint8_t name ## _refs[numof]; \
+    static uint8_t name ## _free[numof]; \
+    static uint16_t name ## _front[numof]
+#define _POOL_INIT(name, size, numof) \
+    { name ## _blocks, name ## _refs, name ## _free, name ## _front, \
+      (size), (numof), 0 }
+#endif
+
+_POOL(_small, GNRC_PKTBUF_SLAB_SMALL_SIZE, GNRC_PKTBUF_SLAB_SMALL_NUMOF);
+_POOL(_medium, GNRC_PKTBUF_SLAB_MEDIUM_SIZE, GNRC_PKTBUF_SLAB_MEDIUM_NUMOF);
+_POOL(_large, GNRC_PKTBUF_SLAB_LARGE_SIZE, GNRC_PKTBUF_SLAB_LARGE_NUMOF);
+
+/* ordered by block size */
+static _pool_t _pools[_CLASSES_NUMOF] = {
+    _POOL_INIT(_small, GNRC_PKTBUF_SLAB_SMALL_SIZE, GNRC_PKTBUF_SLAB_SMALL_NUMOF),
+    _POOL_INIT(_medium, GNRC_PKTBUF_SLAB_MEDIUM_SIZE, GNRC_PKTBUF_SLAB_MEDIUM_NUMOF),
+    _POOL_INIT(_large, GNRC_PKTBUF_SLAB_LARGE_SIZE, GNRC_PKTBUF_SLAB_LARGE_NUMOF),
+};
+
+static mutex_t _mutex = MUTEX_INIT;
+static gnrc_pktsnip_t _snips[GNRC_PKTBUF_SLAB_SNIPS];
+static gnrc_pktsnip_t *_free_snips;
+static unsigned _free_snips_numof;
+
+#ifdef DEVELHELP
+static unsigned _snips_max_used;
+static uint16_t _snips_failed;
+#endif
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    size_t headroom, gnrc_nettype_t type);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static inline bool _snip_contains(void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - (uint8_t *)_snips) < sizeof(_snips);
+}
+
+static gnrc_pktsnip_t *_snip_alloc(void)
+{
+    gnrc_pktsnip_t *snip = _free_snips;
+
+    if (snip == NULL) {
+        DEBUG("pktbuf: no packet snip left\n");
+#ifdef DEVELHELP
+        _snips_failed++;
+#endif
+        return NULL;
+    }
+    _free_snips = snip->next;
+    _free_snips_numof--;
+    GNRC_PKTBUF_COUNT(allocs, 1);
+#ifdef DEVELHELP
+    if ((GNRC_PKTBUF_SLAB_SNIPS - _free_snips_numof) > _snips_max_used) {
+        _snips_max_used = GNRC_PKTBUF_SLAB_SNIPS - _free_snips_numof;
+    }
+#endif
+    return snip;
+}
+
+static void _snip_free(gnrc_pktsnip_t *snip)
+{
+    assert(_snip_contains(snip));
+    snip->next = _free_snips;
+    _free_snips = snip;
+    _free_snips_numof++;
+}
+
+/* finds the pool of a data pointer, NULL if it isn't in any */
+static _pool_t *_pool_of(const void *data, unsigned *idx)
+{
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _pool_t *pool = &_pools[i];
+        unsigned offset = (unsigned)((uint8_t *)data - pool->blocks);
+
+        if (offset < ((unsigned)pool->size * pool->numof)) {
+            *idx = offset / pool->size;
+            return pool;
+        }
+    }
+    return NULL;
+}
+
+static void *_data_alloc(size_t size, size_t headroom)
+{
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _pool_t *pool = &_pools[i];
+
+        if ((size + headroom) > pool->size) {
+            continue;
+        }
+        if (pool->free_numof == 0) {
+#ifdef DEVELHELP
+            pool->failed++;
+#endif
+            continue;
+        }
+        unsigned idx = pool->free[--pool->free_numof];
+        assert(pool->refs[idx] == 0);
+        pool->refs[idx] = 1;
+        pool->front[idx] = headroom;
+#ifdef DEVELHELP
+        pool->len[idx] = size;
+        if ((pool->numof - pool->free_numof) > pool->max_used) {
+            pool->max_used = pool->numof - pool->free_numof;
+        }
+#endif
+        GNRC_PKTBUF_COUNT(allocs, 1);
+        return &pool->blocks[(idx * pool->size) + headroom];
+    }
+    DEBUG("pktbuf: no block left for %u bytes\n", (unsigned)size);
+    return NULL;
+}
+
+static void _data_unref(void *data, size_t size)
+{
+    unsigned idx;
+    _pool_t *pool;
+
+    if ((data == NULL) || ((pool = _pool_of(data, &idx)) == NULL)) {
+        return;
+    }
+    assert(pool->refs[idx] > 0);
+    if (--pool->refs[idx] == 0) {
+        pool->free[pool->free_numof++] = idx;
+    }
+    else if ((uint8_t *)data == &pool->blocks[(idx * pool->size) +
+                                              pool->front[idx]]) {
+        /* give the space of a released header back to the headroom */
+        pool->front[idx] += size;
+#ifdef DEVELHELP
+        pool->len[idx] -= size;
+#endif
+    }
+}
+
+/* puts size bytes directly in front of the data of next, NULL if there is no
+ * headroom for them */
+static void *_data_push(gnrc_pktsnip_t *next, size_t size)
+{
+    unsigned idx;
+    _pool_t *pool;
+
+    if ((next == NULL) || (next->data == NULL) || (size == 0) ||
+        ((pool = _pool_of(next->data, &idx)) == NULL)) {
+        return NULL;
+    }
+    if (((uint8_t *)next->data != &pool->blocks[(idx * pool->size) +
+                                               pool->front[idx]]) ||
+        (pool->front[idx] < size) || (pool->refs[idx] == UINT8_MAX)) {
+        return NULL;
+    }
+    pool->refs[idx]++;
+    pool->front[idx] -= size;
+#ifdef DEVELHELP
+    pool->len[idx] += size;
+#endif
+    GNRC_PKTBUF_COUNT(headroom, 1);
+    return ((uint8_t *)next->data) - size;
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    _free_snips = NULL;
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_SNIPS; i++) {
+        _snips[i].next = _free_snips;
+        _free_snips = &_snips[i];
+    }
+    _free_snips_numof = GNRC_PKTBUF_SLAB_SNIPS;
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _pool_t *pool = &_pools[i];
+
+        assert((pool->size % 4) == 0);
+        memset(pool->refs, 0, pool->numof);
+        /* hand out the lowest blocks first */
+        for (unsigned j = 0; j < pool->numof; j++) {
+            pool->free[j] = pool->numof - 1 - j;
+        }
+        pool->free_numof = pool->numof;
+    }
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > GNRC_PKTBUF_SLAB_LARGE_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SLAB_LARGE_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, 0, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, const void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > GNRC_PKTBUF_SLAB_LARGE_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SLAB_LARGE_SIZE);
+        return NULL;
+    }
+    /* the headroom must not push the payload into a larger class, the large
+     * blocks are few */
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        if (size <= _pools[i].size) {
+            if ((size + headroom) > _pools[i].size) {
+                headroom = _pools[i].size - size;
+            }
+            break;
+        }
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, headroom, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add_header(gnrc_pktsnip_t *next, const void *data,
+                                       size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+    void *_data;
+
+    if (size > GNRC_PKTBUF_SLAB_LARGE_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SLAB_LARGE_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    /* only take the headroom if there is a snip for the header */
+    if ((_free_snips != NULL) && ((_data = _data_push(next, size)) != NULL)) {
+        pkt = _snip_alloc();
+        if (data != NULL) {
+            memcpy(_data, data, size);
+            GNRC_PKTBUF_COUNT(copied, size);
+        }
+        _set_pktsnip(pkt, next, _data, size, type);
+    }
+    else {
+        pkt = _create_snip(next, data, size, 0, type);
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+size_t gnrc_pktbuf_headroom(const gnrc_pktsnip_t *pkt)
+{
+    unsigned idx;
+    _pool_t *pool;
+    size_t res = 0;
+
+    mutex_lock(&_mutex);
+    if ((pkt != NULL) && (pkt->data != NULL) &&
+        ((pool = _pool_of(pkt->data, &idx)) != NULL) &&
+        ((uint8_t *)pkt->data == &pool->blocks[(idx * pool->size) +
+                                              pool->front[idx]])) {
+        res = pool->front[idx];
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *marked_data;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _snip_alloc();
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    marked_data = pkt->data;
+    if (pkt->size != size) {
+        unsigned idx;
+        _pool_t *pool = _pool_of(pkt->data, &idx);
+
+        /* both parts now reference the block */
+        if (pool != NULL) {
+            if (pool->refs[idx] == UINT8_MAX) {
+                DEBUG("pktbuf: block split too often.\n");
+                _snip_free(marked_snip);
+                mutex_unlock(&_mutex);
+                return NULL;
+            }
+            pool->refs[idx]++;
+        }
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, marked_data, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    unsigned idx = 0;
+    _pool_t *pool;
+
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _data_unref(pkt->data, pkt->size);
+        pkt->data = NULL;
+    }
+    else if (size > pkt->size) {
+        pool = (pkt->data != NULL) ? _pool_of(pkt->data, &idx) : NULL;
+        /* grow in place if the block is not shared and big enough */
+        if ((pool != NULL) && (pool->refs[idx] == 1) &&
+            ((size_t)((uint8_t *)pkt->data - &pool->blocks[idx * pool->size]) + size
+             <= pool->size)) {
+#ifdef DEVELHELP
+            pool->len[idx] += size - pkt->size;
+#endif
+        }
+        else {
+            void *new_data = _data_alloc(size, 0);
+
+            if (new_data == NULL) {
+                DEBUG("pktbuf: error allocating new data section\n");
+                mutex_unlock(&_mutex);
+                return ENOMEM;
+            }
+            if (pkt->data != NULL) {
+                memcpy(new_data, pkt->data, pkt->size);
+                GNRC_PKTBUF_COUNT(copied, pkt->size);
+            }
+            _data_unref(pkt->data, pkt->size);
+            pkt->data = new_data;
+        }
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_snip_contains(pkt));
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _data_unref(pkt->data, pkt->size);
+            _snip_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, 0, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    mutex_lock(&_mutex);
+    printf("packet buffer: slab pools\n");
+    printf("  snips: %u/%u used, max used: %u, failed: %" PRIu16 "\n",
+           GNRC_PKTBUF_SLAB_SNIPS - _free_snips_numof, GNRC_PKTBUF_SLAB_SNIPS,
+           _snips_max_used, _snips_failed);
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _pool_t *pool = &_pools[i];
+        unsigned used = pool->numof - pool->free_numof;
+        unsigned requested = 0;
+
+        for (unsigned j = 0; j < pool->numof; j++) {
+            if (pool->refs[j] > 0) {
+                requested += pool->len[j];
+            }
+        }
+        /* internal fragmentation: share of the used blocks that was not
+         * requested */
+        printf("  %4u byte blocks: %u/%u used, max used: %u, failed: %" PRIu16
+               ", fragmentation: %u%%\n",
+               pool->size, used, (unsigned)pool->numof, pool->max_used,
+               pool->failed,
+               used ? 100 - ((requested * 100) / (used * pool->size)) : 0);
+    }
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    if (_free_snips_numof != GNRC_PKTBUF_SLAB_SNIPS) {
+        return false;
+    }
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        if (_pools[i].free_numof != _pools[i].numof) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - the free snip list holds _free_snips_numof snips of _snips
+     *  - forall pools: the free stack holds exactly the blocks without
+     *    references, each once
+     *  - forall used blocks: the front-most data lies within the block
+     */
+    unsigned count = 0;
+
+    for (gnrc_pktsnip_t *ptr = _free_snips; ptr; ptr = ptr->next) {
+        if (!_snip_contains(ptr) || (++count > GNRC_PKTBUF_SLAB_SNIPS)) {
+            return false;
+        }
+    }
+    if (count != _free_snips_numof) {
+        return false;
+    }
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _pool_t *pool = &_pools[i];
+        unsigned unreferenced = 0;
+
+        for (unsigned j = 0; j < pool->numof; j++) {
+            if (pool->refs[j] == 0) {
+                unreferenced++;
+            }
+            else if (pool->front[j] >= pool->size) {
+                return false;
+            }
+        }
+        if (unreferenced != pool->free_numof) {
+            return false;
+        }
+        for (unsigned j = 0; j < pool->free_numof; j++) {
+            if ((pool->free[j] >= pool->numof) ||
+                (pool->refs[pool->free[j]] != 0)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    size_t headroom, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _snip_alloc();
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _data_alloc(size, headroom);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _snip_free(pkt);
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+            GNRC_PKTBUF_COUNT(copied, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+/** @} */
@@ -47,6 +47,9 @@ static _unused_t *_first_unused;
 #ifdef DEVELHELP
 /* maximum number of bytes allocated */
 static uint16_t max_byte_count = 0;
+/* number of bytes in use and its high-water mark */
+static uint16_t _used = 0;
+static uint16_t _max_used = 0;
 #endif
 
 /* internal gnrc_pktbuf functions */
@@ -104,6 +107,27 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t s
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, const void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type)
+{
+    /* chunks can't grow downwards, so there is no point in reserving any */
+    (void)headroom;
+    return gnrc_pktbuf_add(next, data, size, type);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add_header(gnrc_pktsnip_t *next, const void *data,
+                                       size_t size, gnrc_nettype_t type)
+{
+    return gnrc_pktbuf_add(next, data, size, type);
+}
+
+size_t gnrc_pktbuf_headroom(const gnrc_pktsnip_t *pkt)
+{
+    (void)pkt;
+    return 0;
+}
+
 gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
 {
     gnrc_pktsnip_t *marked_snip;
@@ -148,6 +172,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         }
         memcpy(new_data_marked, pkt->data, size);
         memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+        GNRC_PKTBUF_COUNT(copied, pkt->size);
         _pktbuf_free(pkt->data, pkt->size);
         marked_snip->data = new_data_marked;
         pkt->data = new_data_rest;
@@ -195,6 +220,7 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         }
         if (pkt->data != NULL) {            /* if old data exist */
             memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+            GNRC_PKTBUF_COUNT(copied, (pkt->size < size) ? pkt->size : size);
         }
         _pktbuf_free(pkt->data, pkt->size);
         pkt->data = new_data;
@@ -284,6 +310,21 @@ static inline void _print_unused(_unused_t *ptr)
 
 void gnrc_pktbuf_stats(void)
 {
+    unsigned free_bytes = 0, largest = 0;
+
+    for (_unused_t *ptr = _first_unused; ptr; ptr = ptr->next) {
+        free_bytes += ptr->size;
+        if (ptr->size > largest) {
+            largest = ptr->size;
+        }
+    }
+    printf("packet buffer: %u/%u bytes used, max used: %" PRIu16 "\n",
+           (unsigned)_used, GNRC_PKTBUF_SIZE, _max_used);
+    /* external fragmentation: share of the free bytes not in the largest
+     * free chunk */
+    printf("  free: %u bytes, largest free chunk: %u bytes, "
+           "fragmentation: %u%%\n", free_bytes, largest,
+           free_bytes ? ((free_bytes - largest) * 100) / free_bytes : 0);
 #ifdef MODULE_OD
     _unused_t *ptr = _first_unused;
     uint8_t *chunk = &_pktbuf[0];
@@ -382,6 +423,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
         }
         if (data != NULL) {
             memcpy(_data, data, size);
+            GNRC_PKTBUF_COUNT(copied, size);
         }
     }
     _set_pktsnip(pkt, next, _data, size, type);
@@ -431,7 +473,12 @@ static void *_pktbuf_alloc(size_t size)
     if (last_byte > max_byte_count) {
         max_byte_count = last_byte;
     }
+    _used += size;
+    if (_used > _max_used) {
+        _max_used = _used;
+    }
 #endif
+    GNRC_PKTBUF_COUNT(allocs, 1);
     return (void *)ptr;
 }
 
@@ -457,6 +504,9 @@ static void _pktbuf_free(void *data, size_t size)
     if (!_pktbuf_contains(data)) {
         return;
     }
+#ifdef DEVELHELP
+    _used -= _align(size);
+#endif
     while (ptr && (((void *)ptr) < data)) {
         prev = ptr;
         ptr = ptr->next;
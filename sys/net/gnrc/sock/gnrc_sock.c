@@ -15,6 +15,7 @@
 
 #include <errno.h>
 
+#include "irq.h"
 #include "net/af.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/ipv6.h"
@@ -44,11 +45,66 @@ static void _callback_put(void *arg)
 }
 #endif
 
-void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
+#ifdef MODULE_SOCK_ASYNC
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    msg_t msg = { .type = cmd, .content = { .ptr = pkt } };
+    gnrc_sock_reg_t *reg = ctx;
+
+    if (mbox_try_put(&reg->mbox, &msg) < 1) {
+        /* unable to dispatch packet */
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if ((cmd == GNRC_NETAPI_MSG_TYPE_RCV) && (reg->async_cb != NULL)) {
+        reg->async_cb(reg, SOCK_ASYNC_MSG_RECV, reg->async_cb_arg);
+    }
+}
+
+/* counts the received packets in the mbox, skipping e.g. timeout messages.
+ * Must be called with IRQs disabled */
+static unsigned _waiting_rcv(mbox_t *mbox)
+{
+    unsigned res = 0;
+
+    for (unsigned i = mbox->cib.read_count; i != mbox->cib.write_count; i++) {
+        if (mbox->msg_array[i & mbox->cib.mask].type ==
+            GNRC_NETAPI_MSG_TYPE_RCV) {
+            res++;
+        }
+    }
+    return res;
+}
+
+void gnrc_sock_set_cb(gnrc_sock_reg_t *reg, gnrc_sock_reg_cb_t cb,
+                      void *cb_arg, bool registered)
+{
+    unsigned state = irq_disable();
+    /* the network stack runs in thread context, so with IRQs disabled no
+     * message can be put into the mbox between counting the waiting
+     * packets and setting the callback */
+    unsigned waiting = (registered) ? _waiting_rcv(&reg->mbox) : 0;
+
+    reg->async_cb = cb;
+    reg->async_cb_arg = cb_arg;
+    irq_restore(state);
+    while ((cb != NULL) && (waiting-- > 0)) {
+        cb(reg, SOCK_ASYNC_MSG_RECV, cb_arg);
+    }
+}
+#endif  /* MODULE_SOCK_ASYNC */
+
+int gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
 {
     mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
+#ifdef MODULE_SOCK_ASYNC
+    reg->netreg_cb.cb = _netapi_cb;
+    reg->netreg_cb.ctx = reg;
+    gnrc_netreg_entry_init_cb(&reg->entry, demux_ctx, &reg->netreg_cb);
+#else
     gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
-    gnrc_netreg_register(type, &reg->entry);
+#endif
+    return gnrc_netreg_register(type, &reg->entry);
 }
 
 ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
@@ -78,7 +134,10 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
         }
     }
 #ifdef MODULE_XTIMER
-    xtimer_remove(&timeout_timer);
+    /* the timer is only initialized when it was set */
+    if ((timeout != SOCK_NO_TIMEOUT) && (timeout != 0)) {
+        xtimer_remove(&timeout_timer);
+    }
 #endif
     switch (msg.type) {
         case GNRC_NETAPI_MSG_TYPE_RCV:
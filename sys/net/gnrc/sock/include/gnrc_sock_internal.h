@@ -116,8 +116,28 @@ static inline void gnrc_ep_set(sock_ip_ep_t *out, const sock_ip_ep_t *in,
 /**
  * @brief   Create a sock internally
  * @internal
+ *
+ * @return  0 on success.
+ * @return  -ENOMEM, if the sock could not be registered with
+ *          @ref net_gnrc_netreg.
  */
-void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx);
+int gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx);
+
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Sets the asynchronous event callback of a sock internally
+ * @internal
+ *
+ * @param[in] reg           The sock's registry entry.
+ * @param[in] cb            The new callback. May be NULL.
+ * @param[in] cb_arg        Argument for @p cb.
+ * @param[in] registered    The sock was already created with
+ *                          gnrc_sock_create(), so messages waiting in its
+ *                          mailbox are reported to @p cb.
+ */
+void gnrc_sock_set_cb(gnrc_sock_reg_t *reg, gnrc_sock_reg_cb_t cb,
+                      void *cb_arg, bool registered);
+#endif
 
 /**
  * @brief   Receive a packet internally
@@ -29,6 +29,9 @@
 #include "net/af.h"
 #include "net/gnrc.h"
 #include "net/gnrc/netreg.h"
+#ifdef MODULE_SOCK_ASYNC
+#include "net/sock/async/types.h"
+#endif
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
 
@@ -40,18 +43,49 @@ extern "C" {
 #define SOCK_MBOX_SIZE      (8)         /**< Size for gnrc_sock_reg_t::mbox_queue */
 #endif
 
+/**
+ * @brief   Forward declaration
+ * @internal
+ */
+typedef struct gnrc_sock_reg gnrc_sock_reg_t;
+
+#ifdef MODULE_SOCK_ASYNC
+/**
+ * @brief   Event callback for @ref gnrc_sock_reg_t
+ * @internal
+ */
+typedef void (*gnrc_sock_reg_cb_t)(gnrc_sock_reg_t *sock,
+                                   sock_async_flags_t flags,
+                                   void *arg);
+#endif  /* MODULE_SOCK_ASYNC */
+
 /**
  * @brief   sock @ref net_gnrc_netreg info
  * @internal
  */
-typedef struct gnrc_sock_reg {
+struct gnrc_sock_reg {
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
     struct gnrc_sock_reg *next;         /**< list-like for internal storage */
 #endif
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
-} gnrc_sock_reg_t;
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+    /**
+     * @brief   @ref net_gnrc_netreg callback that fills
+     *          gnrc_sock_reg_t::mbox and calls gnrc_sock_reg_t::async_cb
+     */
+    gnrc_netreg_entry_cbd_t netreg_cb;
+    /**
+     * @brief   Event callback of the sock, see @ref net_sock_async
+     *
+     * The sock types start with their gnrc_sock_reg_t, so the callback of
+     * each sock type can be called as gnrc_sock_reg_cb_t.
+     */
+    gnrc_sock_reg_cb_t async_cb;
+    void *async_cb_arg;                 /**< argument for async_cb */
+#endif
+};
 
 /**
  * @brief   Raw IP sock type
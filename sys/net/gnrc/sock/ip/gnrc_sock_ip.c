@@ -22,6 +22,9 @@
 #include "net/af.h"
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
+#ifdef MODULE_SOCK_ASYNC
+#include "net/sock/async.h"
+#endif
 #include "net/sock/ip.h"
 #include "random.h"
 
@@ -54,8 +57,13 @@ int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
         }
         gnrc_ep_set(&sock->remote, remote, sizeof(sock_ip_ep_t));
     }
-    gnrc_sock_create(&sock->reg, GNRC_NETTYPE_IPV6,
-                     proto);
+#ifdef MODULE_SOCK_ASYNC
+    sock->reg.async_cb = NULL;
+#endif
+    int res = gnrc_sock_create(&sock->reg, GNRC_NETTYPE_IPV6, proto);
+    if (res < 0) {
+        return res;
+    }
     sock->flags = flags;
     return 0;
 }
@@ -187,7 +195,8 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
          * there was no remote given on create, take from local */
         rem.family = local.family;
     }
-    pkt = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    pkt = gnrc_pktbuf_add_headroom(NULL, (void *)data, len,
+                                   GNRC_PKTBUF_TX_HEADROOM, GNRC_NETTYPE_UNDEF);
     if (pkt == NULL) {
         return -ENOMEM;
     }
@@ -195,7 +204,21 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
     if (res <= 0) {
         return res;
     }
+#ifdef MODULE_SOCK_ASYNC
+    if ((sock != NULL) && (sock->reg.async_cb != NULL)) {
+        sock->reg.async_cb(&sock->reg, SOCK_ASYNC_MSG_SENT,
+                           sock->reg.async_cb_arg);
+    }
+#endif
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    gnrc_sock_set_cb(&sock->reg, (gnrc_sock_reg_cb_t)cb, cb_arg, true);
+}
+#endif
+
 /** @} */
@@ -19,10 +19,14 @@
 #include <string.h>
 
 #include "byteorder.h"
+#include "iolist.h"
 #include "net/af.h"
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
+#ifdef MODULE_SOCK_ASYNC
+#include "net/sock/async.h"
+#endif
 #include "net/sock/udp.h"
 #include "net/udp.h"
 
@@ -96,6 +100,9 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         return -EINVAL;
     }
     memset(&sock->local, 0, sizeof(sock_udp_ep_t));
+#ifdef MODULE_SOCK_ASYNC
+    sock->reg.async_cb = NULL;
+#endif
     if (local != NULL) {
         uint16_t port = local->port;
 
@@ -137,7 +144,15 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
     }
     if (local != NULL) {
         /* listen only with local given */
-        gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, sock->local.port);
+        int res = gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP,
+                                   sock->local.port);
+        if (res < 0) {
+#ifdef MODULE_GNRC_SOCK_CHECK_REUSE
+            /* sock was prepended above */
+            _udp_socks = (sock_udp_t *)sock->reg.next;
+#endif
+            return res;
+        }
     }
     sock->flags = flags;
     return 0;
@@ -175,15 +190,20 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
     return 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+/**
+ * @brief   Receives a UDP packet and checks it against the remote of @p sock
+ *
+ * @return  Size of the payload on success, @p pkt is the payload snip then.
+ * @return  Negative errno on error, @p pkt was already released then.
+ */
+static ssize_t _recv(sock_udp_t *sock, gnrc_pktsnip_t **pkt_out,
+                     uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -192,10 +212,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -214,14 +230,80 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
+    *pkt_out = pkt;
+    return (ssize_t)pkt->size;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if (pkt->size > max_len) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
     memcpy(data, pkt->data, pkt->size);
-    res = (int)pkt->size;
     gnrc_pktbuf_release(pkt);
     return res;
 }
 
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* continue with the payload snip following the current one */
+        pkt = *buf_ctx;
+        for (gnrc_pktsnip_t *snip = pkt; snip != NULL; snip = snip->next) {
+            if ((snip->data == *data) && (snip->next != NULL) &&
+                (snip->next->type == GNRC_NETTYPE_UNDEF)) {
+                *data = snip->next->data;
+                return (ssize_t)snip->next->size;
+            }
+        }
+        /* end of payload: hand buffer back to the packet buffer */
+        *data = NULL;
+        *buf_ctx = NULL;
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if (res == 0) {
+        /* empty datagram: 0 already signals the end, so nothing is lent */
+        gnrc_pktbuf_release(pkt);
+        *data = NULL;
+        *buf_ctx = NULL;
+        return 0;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return res;
+}
+
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
+{
+    const iolist_t snip = { NULL, (void *)data, len };
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+    return sock_udp_sendv(sock, &snip, remote);
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
 {
     int res;
     gnrc_pktsnip_t *payload, *pkt;
@@ -231,7 +313,6 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     sock_ip_ep_t *rem;
 
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -274,7 +355,12 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
             else {
                 sock->local.family = remote->family;
             }
-            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, src_port);
+            if ((res = gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP,
+                                        src_port)) < 0) {
+                sock->local.family = AF_UNSPEC;
+                sock->local.port = 0;
+                return res;
+            }
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
             /* prepend to current socks */
             sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
@@ -303,11 +389,20 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     else if (local.family != rem->family) {
         return -EINVAL;
     }
-    /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    /* generate payload and header snips, the payload is gathered from the
+     * caller's buffers directly into the packet buffer, with room for the
+     * headers in front of it */
+    payload = gnrc_pktbuf_add_headroom(NULL, NULL, iolist_size(snips),
+                                       GNRC_PKTBUF_TX_HEADROOM,
+                                       GNRC_NETTYPE_UNDEF);
     if (payload == NULL) {
         return -ENOMEM;
     }
+    uint8_t *pos = payload->data;
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        memcpy(pos, snip->iol_base, snip->iol_len);
+        pos += snip->iol_len;
+    }
     pkt = gnrc_udp_hdr_build(payload, src_port, dst_port);
     if (pkt == NULL) {
         gnrc_pktbuf_release(payload);
@@ -316,8 +411,24 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
+#ifdef MODULE_SOCK_ASYNC
+        if ((sock != NULL) && (sock->reg.async_cb != NULL)) {
+            sock->reg.async_cb(&sock->reg, SOCK_ASYNC_MSG_SENT,
+                               sock->reg.async_cb_arg);
+        }
+#endif
     }
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    /* without local end point the sock is only registered on first send */
+    gnrc_sock_set_cb(&sock->reg, (gnrc_sock_reg_cb_t)cb, cb_arg,
+                     sock->local.family != AF_UNSPEC);
+}
+#endif
+
 /** @} */
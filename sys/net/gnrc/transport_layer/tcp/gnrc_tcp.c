@@ -347,8 +347,10 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     xtimer_t probe_timeout;
     cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
     uint32_t probe_timeout_duration_us = 0;
+    uint32_t snd_una_start;
     ssize_t ret = 0;
     bool probing_mode = false;
+    bool timed_out = false;
 
     /* Lock the TCB for this function call */
     mutex_lock(&(tcb->function_lock));
@@ -358,6 +360,7 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         mutex_unlock(&(tcb->function_lock));
         return -ENOTCONN;
     }
+    snd_una_start = tcb->snd_una;
 
     /* Mark TCB as waiting for incomming messages */
     tcb->status |= STATUS_WAIT_FOR_MSG;
@@ -375,8 +378,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until everything was sent and acked or an error occurred */
+    while (!timed_out && (ret == 0 || (size_t) ret < len || tcb->rtx_len > 0)) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -395,9 +398,10 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                            &probe_timeout_arg);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
-            ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+        /* Try to send remaining data, as long as we are not probing. The FSM sends as
+         * many segments as the send and congestion windows allow. */
+        if (ret >= 0 && (size_t) ret < len && !probing_mode) {
+            ret += _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (uint8_t *) data + ret, len - ret);
         }
 
         /* Wait for responses */
@@ -411,8 +415,13 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
+                /* Report what the peer acknowledged so far, drop the rest */
+                ret = (ssize_t) (tcb->snd_una - snd_una_start);
+                if (ret == 0) {
+                    ret = -ETIMEDOUT;
+                }
                 _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
-                ret = -ETIMEDOUT;
+                timed_out = true;
                 break;
 
             case MSG_TYPE_PROBE_TIMEOUT:
@@ -618,6 +627,32 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
     mutex_unlock(&(tcb->function_lock));
 }
 
+#ifdef MODULE_SOCK_ASYNC
+void gnrc_tcp_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cb_t cb, void *arg)
+{
+    assert(tcb != NULL);
+
+    sock_async_flags_t flags = 0;
+
+    /* Synchronize with the FSM, that calls the callback */
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->async_cb = cb;
+    tcb->async_cb_arg = arg;
+    if ((tcb->rcv_buf_raw != NULL) && (tcb->rcv_buf.avail > 0)) {
+        flags |= SOCK_ASYNC_MSG_RECV;
+    }
+    if (tcb->state == FSM_STATE_CLOSE_WAIT) {
+        flags |= SOCK_ASYNC_CONN_FIN;
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+
+    /* Report what happened before the callback was set */
+    if ((cb != NULL) && flags) {
+        cb(tcb, flags, arg);
+    }
+}
+#endif
+
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
 {
     uint16_t csum;
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ * @}
+ */
+#include "internal/common.h"
+#include "internal/cc.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Lowers the slow start threshold after a loss (see RFC 5681, section 3.1).
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+static void _cc_loss(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t flight_size = tcb->snd_nxt - tcb->snd_una;
+    uint32_t min_ssthresh = 2 * _cc_smss(tcb);
+
+    tcb->ssthresh = (flight_size / 2 > min_ssthresh) ? flight_size / 2 : min_ssthresh;
+}
+
+uint32_t _cc_smss(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t mss = (tcb->mss > 0) ? tcb->mss : MSS_DEFAULT;
+    return (mss < GNRC_TCP_MSS) ? mss : GNRC_TCP_MSS;
+}
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_smss(tcb);
+
+    /* Initial window */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    tcb->ssthresh = UINT32_MAX;
+    tcb->dup_acks = 0;
+}
+
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked)
+{
+    uint32_t smss = _cc_smss(tcb);
+
+    /* Leaving fast recovery: Deflate the window */
+    if (tcb->dup_acks >= GNRC_TCP_DUP_ACK_THRESHOLD) {
+        tcb->cwnd = tcb->ssthresh;
+    }
+    /* Slow start: Grow by up to one SMSS per ACK */
+    else if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    /* Congestion avoidance: Grow by about one SMSS per round trip */
+    else {
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+
+    /* Without window scaling, more than UINT16_MAX bytes are never in flight */
+    if (tcb->cwnd > UINT16_MAX) {
+        tcb->cwnd = UINT16_MAX;
+    }
+    tcb->dup_acks = 0;
+}
+
+bool _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_smss(tcb);
+
+    if (tcb->dup_acks < UINT8_MAX) {
+        tcb->dup_acks += 1;
+    }
+
+    /* The oldest segment is considered lost: Retransmit it right away */
+    if (tcb->dup_acks == GNRC_TCP_DUP_ACK_THRESHOLD) {
+        DEBUG("gnrc_tcp_cc.c : _cc_dup_ack() : Fast retransmit\n");
+        _cc_loss(tcb);
+        tcb->cwnd = tcb->ssthresh + GNRC_TCP_DUP_ACK_THRESHOLD * smss;
+        return true;
+    }
+    /* Each further duplicate ACK signals a segment that left the network */
+    if (tcb->dup_acks > GNRC_TCP_DUP_ACK_THRESHOLD) {
+        tcb->cwnd += smss;
+    }
+    return false;
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    /* Only the first timeout of a segment lowers the threshold, retransmissions
+     * of the same segment would halve it again and again */
+    if (tcb->retries == 0) {
+        _cc_loss(tcb);
+    }
+    tcb->cwnd = _cc_smss(tcb);
+    tcb->dup_acks = 0;
+}
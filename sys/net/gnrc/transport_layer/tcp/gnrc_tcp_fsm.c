@@ -26,6 +26,7 @@
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
+#include "internal/cc.h"
 #include "internal/fsm.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -83,11 +84,20 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->rtx_len > 0) {
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        while (tcb->rtx_len > 0) {
+            gnrc_pktbuf_release(tcb->rtx_queue[tcb->rtx_head]);
+            tcb->rtx_queue[tcb->rtx_head] = NULL;
+            tcb->rtx_head = (tcb->rtx_head + 1) % GNRC_TCP_SND_QUEUE_SIZE;
+            tcb->rtx_len -= 1;
+        }
     }
+    tcb->rtx_head = 0;
+    tcb->retries = 0;
+    tcb->dup_acks = 0;
+    /* Karns Algorithm: The timed segment is gone */
+    tcb->status &= ~STATUS_RTT_PENDING;
     return 0;
 }
 
@@ -123,8 +133,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 
     switch (state) {
         case FSM_STATE_CLOSED:
-            /* Clear retransmit queue */
+            /* Clear retransmit queue and out of order packets */
             _clear_retransmit(tcb);
+            _rcvbuf_ooo_clear(tcb);
 
             /* Remove connection from active connections */
             mutex_lock(&_list_tcb_lock);
@@ -191,8 +202,13 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             mutex_unlock(&_list_tcb_lock);
             break;
 
-        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_ESTABLISHED:
+            /* The peers MSS is known now */
+            _cc_init(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            break;
+
+        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
             break;
@@ -257,6 +273,9 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 /**
  * @brief FSM Handling function for sending data.
  *
+ * Sends segments as long as the send window, the congestion window and the
+ * retransmission queue allow it.
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in,out] buf   Buffer containing data to send.
  * @param[in]     len   Maximum Number of Bytes to send from @p buf.
@@ -267,24 +286,40 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    uint32_t smss = _cc_smss(tcb);
+    uint32_t wnd = (tcb->snd_wnd < tcb->cwnd) ? tcb->snd_wnd : tcb->cwnd;
+    size_t sent = 0;
+
+    while (sent < len && tcb->rtx_len < GNRC_TCP_SND_QUEUE_SIZE) {
+        uint32_t flight_size = tcb->snd_nxt - tcb->snd_una;
+
+        /* Check if window is open */
+        if (flight_size >= wnd) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = wnd - flight_size;
+        payload = (payload < smss) ? payload : smss;
+        payload = (payload < (len - sent)) ? payload : (len - sent);
+
+        /* Avoid small segments while the window is just a bit open and
+         * there are ACKs to come, that open it further (see RFC 1122, 4.2.3.4) */
+        if (payload < smss && payload < (len - sent) && flight_size > 0) {
+            break;
+        }
 
-        /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -632,8 +667,26 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    _cc_ack(tcb, seg_ack - tcb->snd_una);
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+
+                    /* Signal user, the window for new data moved */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK: Nothing new is acknowledged while data is outstanding */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 && seg_wnd == tcb->snd_wnd &&
+                         tcb->rtx_len > 0 && !(ctl & MSK_FIN)) {
+                    /* The peer is alive, even if it does not acknowledge new data */
+                    tcb->status |= STATUS_NOTIFY_USER;
+
+                    /* Fast retransmit: This is no timeout, so retries and RTO stay untouched */
+                    if (_cc_dup_ack(tcb)) {
+                        gnrc_pktsnip_t *pkt = tcb->rtx_queue[tcb->rtx_head];
+
+                        gnrc_pktbuf_hold(pkt, 1);
+                        _pkt_send(tcb, pkt, 0, true);
+                    }
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -657,25 +710,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_len == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -690,21 +743,21 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             /* Check if state is valid for payload receiving */
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2) {
-                /* Search for begin of payload */
-                LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
-
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
+                /* Data is in order (or partially received before): Copy into receive buffer */
+                if (LEQ_32_BIT(seg_seq, tcb->rcv_nxt)) {
+                    _rcvbuf_add_payload(tcb, in_pkt, seg_seq);
+                    /* Packets received out of order might follow now */
+                    _rcvbuf_ooo_drain(tcb);
                     /* Shrink receive window */
                     tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
+                /* Data is out of order: Keep it until the gap is closed. The ACK sent below
+                 * is a duplicate ACK, that signals the gap to the peer. */
+                else if (!(ctl & MSK_FIN)) {
+                    _rcvbuf_ooo_add(tcb, in_pkt, seg_seq);
+                }
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
                 if (!(ctl & MSK_FIN)) {
@@ -720,6 +773,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
             }
+            /* Data in front of the FIN is missing: Ignore FIN, the peer retransmits it */
+            if (seg_seq + pay_len != tcb->rcv_nxt) {
+                _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
+                _pkt_send(tcb, out_pkt, seq_con, false);
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
@@ -729,7 +788,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->rtx_len == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -771,9 +830,12 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->rtx_len > 0) {
+        gnrc_pktsnip_t *pkt = tcb->rtx_queue[tcb->rtx_head];
+
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, pkt, true);
+        _pkt_send(tcb, pkt, 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -887,11 +949,32 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
     return ret;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+/**
+ * @brief Number of bytes waiting in the receive buffer.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Number of bytes the user can read.
+ */
+static size_t _rcv_avail(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->rcv_buf_raw != NULL) ? tcb->rcv_buf.avail : 0;
+}
+#endif
+
 int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *buf, size_t len)
 {
     /* Lock FSM */
     mutex_lock(&(tcb->fsm_lock));
 
+#ifdef MODULE_SOCK_ASYNC
+    uint8_t state = tcb->state;
+    uint32_t snd_una = tcb->snd_una;
+    size_t rcv_avail = _rcv_avail(tcb);
+    sock_async_flags_t flags = 0;
+#endif
+
     /* Call FSM */
     tcb->status &= ~STATUS_NOTIFY_USER;
     int32_t result = _fsm_unprotected(tcb, event, in_pkt, buf, len);
@@ -902,7 +985,35 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
         msg.type = MSG_TYPE_NOTIFY_USER;
         mbox_try_put(&(tcb->mbox), &msg);
     }
+#ifdef MODULE_SOCK_ASYNC
+    /* Tell the event callback what exactly happened */
+    gnrc_tcp_cb_t cb = tcb->async_cb;
+    void *cb_arg = tcb->async_cb_arg;
+
+    if ((cb != NULL) && (tcb->status & STATUS_NOTIFY_USER)) {
+        if (tcb->state != state) {
+            if (tcb->state == FSM_STATE_ESTABLISHED) {
+                flags |= SOCK_ASYNC_CONN_RDY;
+            }
+            else if ((tcb->state == FSM_STATE_CLOSE_WAIT) ||
+                     (tcb->state == FSM_STATE_CLOSED)) {
+                flags |= SOCK_ASYNC_CONN_FIN;
+            }
+        }
+        if (_rcv_avail(tcb) > rcv_avail) {
+            flags |= SOCK_ASYNC_MSG_RECV;
+        }
+        if (tcb->snd_una != snd_una) {
+            flags |= SOCK_ASYNC_MSG_SENT;
+        }
+    }
+#endif
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
+#ifdef MODULE_SOCK_ASYNC
+    if (flags) {
+        cb(tcb, flags, cb_arg);
+    }
+#endif
     return result;
 }
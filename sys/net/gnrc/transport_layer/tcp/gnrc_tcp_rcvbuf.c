@@ -16,6 +16,10 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <utlist.h>
+#include "net/gnrc/pktbuf.h"
+#include "internal/common.h"
+#include "internal/pkt.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
@@ -99,3 +103,105 @@ void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
         tcb->rcv_buf_raw = NULL;
     }
 }
+
+void _rcvbuf_add_payload(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seg_seq)
+{
+    gnrc_pktsnip_t *snp = NULL;
+    uint32_t skip = tcb->rcv_nxt - seg_seq;
+
+    /* Search for begin of payload */
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_UNDEF);
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        if (skip >= snp->size) {
+            skip -= snp->size;
+        }
+        else {
+            unsigned len = snp->size - skip;
+            unsigned added = ringbuffer_add(&(tcb->rcv_buf), (char *) snp->data + skip, len);
+
+            tcb->rcv_nxt += added;
+            /* Stop if the receive buffer is full */
+            if (added < len) {
+                break;
+            }
+            skip = 0;
+        }
+        snp = snp->next;
+    }
+}
+
+void _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seg_seq)
+{
+    unsigned pos = GNRC_TCP_RCV_OOO_QUEUE_SIZE;
+
+    for (unsigned i = 0; i < GNRC_TCP_RCV_OOO_QUEUE_SIZE; ++i) {
+        if (tcb->rcv_ooo[i] == NULL) {
+            pos = i;
+        }
+        else if (_pkt_get_seq_num(tcb->rcv_ooo[i]) == seg_seq) {
+            /* Packet was already received */
+            return;
+        }
+    }
+
+    /* Queue is full: Replace the packet that is needed last */
+    if (pos == GNRC_TCP_RCV_OOO_QUEUE_SIZE) {
+        uint32_t last = seg_seq;
+
+        for (unsigned i = 0; i < GNRC_TCP_RCV_OOO_QUEUE_SIZE; ++i) {
+            uint32_t seq = _pkt_get_seq_num(tcb->rcv_ooo[i]);
+            if (GRT_32_BIT(seq, last)) {
+                last = seq;
+                pos = i;
+            }
+        }
+        if (pos == GNRC_TCP_RCV_OOO_QUEUE_SIZE) {
+            return;
+        }
+        gnrc_pktbuf_release(tcb->rcv_ooo[pos]);
+    }
+
+    /* Keep packet, the receive path releases it after processing */
+    gnrc_pktbuf_hold(pkt, 1);
+    tcb->rcv_ooo[pos] = pkt;
+}
+
+void _rcvbuf_ooo_drain(gnrc_tcp_tcb_t *tcb)
+{
+    bool progress = true;
+
+    while (progress) {
+        progress = false;
+        for (unsigned i = 0; i < GNRC_TCP_RCV_OOO_QUEUE_SIZE; ++i) {
+            gnrc_pktsnip_t *pkt = tcb->rcv_ooo[i];
+            if (pkt == NULL) {
+                continue;
+            }
+
+            /* There is still data missing in front of this packet */
+            uint32_t seg_seq = _pkt_get_seq_num(pkt);
+            if (GRT_32_BIT(seg_seq, tcb->rcv_nxt)) {
+                continue;
+            }
+
+            /* Copy what was not received otherwise, release packet */
+            uint32_t rcv_nxt = tcb->rcv_nxt;
+            _rcvbuf_add_payload(tcb, pkt, seg_seq);
+            gnrc_pktbuf_release(pkt);
+            tcb->rcv_ooo[i] = NULL;
+            if (tcb->rcv_nxt != rcv_nxt) {
+                progress = true;
+            }
+        }
+    }
+}
+
+void _rcvbuf_ooo_clear(gnrc_tcp_tcb_t *tcb)
+{
+    for (unsigned i = 0; i < GNRC_TCP_RCV_OOO_QUEUE_SIZE; ++i) {
+        if (tcb->rcv_ooo[i] != NULL) {
+            gnrc_pktbuf_release(tcb->rcv_ooo[i]);
+            tcb->rcv_ooo[i] = NULL;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       TCP congestion control declarations (see RFC 5681).
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sender maximum segment size (SMSS) of a connection.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Maximum payload size of a segment sent on this connection.
+ */
+uint32_t _cc_smss(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Initializes congestion control (see RFC 5681, section 3.1).
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Grows congestion window on ACKs for new data (see RFC 5681, section 3).
+ *
+ * @param[in,out] tcb     TCB holding the congestion control state.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked);
+
+/**
+ * @brief Handles duplicate ACKs: Fast retransmit and fast recovery (see RFC 5681, section 3.2).
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ *
+ * @returns   true, if the oldest unacknowledged segment must be retransmitted.
+ *            false otherwise.
+ */
+bool _cc_dup_ack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Handles a retransmission timeout: Continues with slow start (see RFC 5681, section 3.1).
+ *
+ * @note Must be called before the retransmission is set up.
+ *
+ * @param[in,out] tcb   TCB holding the congestion control state.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
@@ -47,6 +47,7 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_RTT_PENDING    (1 << 4)
 /** @} */
 
 /**
@@ -89,6 +90,11 @@ extern "C" {
 #define MSG_TYPE_NOTIFY_USER        (GNRC_NETAPI_MSG_TYPE_ACK + 106)
 /** @} */
 
+/**
+ * @brief MSS assumed if the peer did not send a MSS option (see RFC 1122).
+ */
+#define MSS_DEFAULT (536U)
+
 /**
  * @brief Define for marking that time measurement is uninitialized.
  */
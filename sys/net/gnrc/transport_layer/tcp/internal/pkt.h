@@ -96,6 +96,15 @@ int _pkt_chk_seq_num(const gnrc_tcp_tcb_t *tcb, const uint32_t seq_num, const ui
  */
 uint32_t _pkt_get_seg_len(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief Extracts the sequence number of a segment.
+ *
+ * @param[in] pkt   Packet containing a TCP header.
+ *
+ * @returns   Sequence number from the TCP header of @p pkt.
+ */
+uint32_t _pkt_get_seq_num(gnrc_pktsnip_t *pkt);
+
 /**
  * @brief Calculates a packets payload length.
  *
@@ -108,18 +117,24 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * Packets are appended to the retransmission queue of @p tcb. The
+ * retransmission timer runs for the oldest packet in the queue.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
  * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
+ *                             @p pkt must be the oldest packet in the queue then.
  *
  * @returns   Zero on success.
  *            -ENOMEM if the retransmission queue is full.
- *            -EINVAL if pkt is null.
+ *            -EINVAL if pkt is null or a retransmit of another than the oldest packet.
  */
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
+ *
+ * All packets that are acknowledged completely by @p ack are removed.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include "mutex.h"
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
 
@@ -67,6 +68,42 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Copies payload of a packet into the receive buffer.
+ *
+ * Only payload starting from rcv_nxt is copied, bytes received before are skipped.
+ *
+ * @param[in,out] tcb       TCB holding the receive buffer.
+ * @param[in]     pkt       Packet containing the payload.
+ * @param[in]     seg_seq   Sequence number of @p pkt, must not be greater than rcv_nxt.
+ */
+void _rcvbuf_add_payload(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seg_seq);
+
+/**
+ * @brief Stores a packet received out of order until the data in front of it arrived.
+ *
+ * If the queue is full, the packet with the highest sequence number is dropped.
+ *
+ * @param[in,out] tcb       TCB holding the queue.
+ * @param[in]     pkt       Packet received out of order.
+ * @param[in]     seg_seq   Sequence number of @p pkt.
+ */
+void _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seg_seq);
+
+/**
+ * @brief Moves packets received out of order into the receive buffer, once they are in order.
+ *
+ * @param[in,out] tcb   TCB holding the queue.
+ */
+void _rcvbuf_ooo_drain(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Clears queue of packets received out of order.
+ *
+ * @param[in,out] tcb   TCB holding the queue.
+ */
+void _rcvbuf_ooo_clear(gnrc_tcp_tcb_t *tcb);
+
 #ifdef __cplusplus
 }
 #endif
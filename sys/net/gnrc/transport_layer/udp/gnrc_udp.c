@@ -289,7 +289,8 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
     udp_hdr_t *hdr;
 
     /* allocate header */
-    res = gnrc_pktbuf_add(payload, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
+    res = gnrc_pktbuf_add_header(payload, NULL, sizeof(udp_hdr_t),
+                                 GNRC_NETTYPE_UDP);
     if (res == NULL) {
         return NULL;
     }
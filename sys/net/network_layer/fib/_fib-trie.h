@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_fib
+ * @{
+ *
+ * @file
+ * @brief       Prefix trie index for single hop FIB tables
+ * @internal
+ *
+ * The functions below expect the table's access mutex to be held.
+ */
+#ifndef FIB_TRIE_H
+#define FIB_TRIE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/fib/table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Adds an entry to the trie of @p table
+ *
+ * @pre `entry->global != NULL`
+ *
+ * @param[in] table the FIB table @p entry belongs to
+ * @param[in] entry the entry to add
+ *
+ * @return 0 on success
+ * @return -ENOMEM if the trie ran out of nodes
+ */
+int fib_trie_add(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief   Removes an entry from the trie of @p table
+ *
+ * Does nothing if @p entry is not in the trie.
+ *
+ * @param[in] table the FIB table @p entry belongs to
+ * @param[in] entry the entry to remove
+ */
+void fib_trie_remove(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief   Looks up the entry for @p dst
+ *
+ * An entry holding exactly @p dst is preferred, otherwise the entry with the
+ * longest prefix (set via @ref FIB_FLAG_NET_PREFIX_MASK) covering @p dst is
+ * chosen. The all-zero address is the default route with a prefix length of
+ * 0. The lookup visits at most one node per bit of @p dst.
+ *
+ * @param[in] table     the FIB table to search in
+ * @param[in] dst       the destination address
+ * @param[in] dst_size  the destination address size
+ * @param[out] entry    the matching entry
+ *
+ * @return 1 if an entry with the exact address was found
+ * @return 0 if an entry with a matching prefix was found
+ * @return -EHOSTUNREACH if no entry matches
+ */
+int fib_trie_find(fib_table_t *table, const uint8_t *dst, size_t dst_size,
+                  fib_entry_t **entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIB_TRIE_H */
+/** @} */
@@ -37,6 +37,10 @@
 #include "net/fib.h"
 #include "net/fib/table.h"
 
+#ifdef MODULE_FIB_TRIE
+#include "_fib-trie.h"
+#endif
+
 #ifdef MODULE_IPV6_ADDR
 #include "net/ipv6/addr.h"
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
@@ -65,6 +69,50 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+#ifdef MODULE_FIB_TRIE
+/**
+ * @brief removes all entries with an expired lifetime and computes the point
+ *        in time the next entry expires
+ *
+ * @param[in] table     the FIB table to sweep
+ * @param[in] now       the current time in us
+ */
+static void fib_sweep_lifetimes(fib_table_t *table, uint64_t now)
+{
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        if ((entry->lifetime == 0) ||
+            (entry->lifetime == FIB_LIFETIME_NO_EXPIRE)) {
+            continue;
+        }
+        if (entry->lifetime < now) {
+            fib_remove(table, entry);
+        }
+        else if (entry->lifetime < table->next_expiry) {
+            table->next_expiry = entry->lifetime;
+        }
+    }
+}
+
+/**
+ * @brief notes the lifetime of a new or updated entry for the next sweep
+ *
+ * @param[in] table     the FIB table of the entry
+ * @param[in] entry     the new or updated entry
+ */
+static inline void fib_schedule_sweep(fib_table_t *table, fib_entry_t *entry)
+{
+    if (entry->lifetime < table->next_expiry) {
+        table->next_expiry = entry->lifetime;
+    }
+}
+#endif
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -83,6 +131,18 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
     uint64_t now = xtimer_now_usec64();
 
+#ifdef MODULE_FIB_TRIE
+    /* expired entries are swept once the earliest lifetime passed instead of
+     * checking every entry on each lookup */
+    if (now >= table->next_expiry) {
+        fib_sweep_lifetimes(table, now);
+    }
+
+    int res = fib_trie_find(table, dst, dst_size, entry_arr);
+    *entry_arr_size = (res >= 0) ? 1 : 0;
+    return res;
+#else
+
     size_t count = 0;
     size_t prefix_size = 0;
     size_t match_size = dst_size << 3;
@@ -187,11 +247,13 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
     *entry_arr_size = count;
     return ret;
+#endif
 }
 
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table the entry belongs to
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,7 +263,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry, uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
@@ -222,6 +284,12 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
     }
 
+#ifdef MODULE_FIB_TRIE
+    fib_schedule_sweep(table, entry);
+#else
+    (void)table;
+#endif
+
     return 0;
 }
 
@@ -268,6 +336,14 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+#ifdef MODULE_FIB_TRIE
+                if (fib_trie_add(table, &table->data.entries[i]) < 0) {
+                    fib_remove(table, &table->data.entries[i]);
+                    return -ENOMEM;
+                }
+                fib_schedule_sweep(table, &table->data.entries[i]);
+#endif
+
                 return 0;
             }
         }
@@ -279,12 +355,19 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table the entry belongs to
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+#ifdef MODULE_FIB_TRIE
+    fib_trie_remove(table, entry);
+#else
+    (void)table;
+#endif
+
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -403,7 +486,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,7 +516,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +540,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +560,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -597,6 +680,11 @@ void fib_init(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+#ifdef MODULE_FIB_TRIE
+    /* the trie nodes are stored in the entries cleared above */
+    table->trie_root = NULL;
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+#endif
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -622,6 +710,10 @@ void fib_deinit(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+#ifdef MODULE_FIB_TRIE
+    table->trie_root = NULL;
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+#endif
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_fib
+ * @{
+ *
+ * @file
+ * @brief       Path compressed binary trie over the prefixes of a FIB table
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/fib.h"
+
+#include "_fib-trie.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static inline unsigned _bit(const uint8_t *key, unsigned pos)
+{
+    return (key[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+/* returns the position of the first bit in [from, to) where a and b differ,
+ * or to if they are equal in that range */
+static unsigned _match_bits(const uint8_t *a, const uint8_t *b,
+                            unsigned from, unsigned to)
+{
+    unsigned i = from;
+
+    while ((i < to) && (i & 0x7)) {
+        if (_bit(a, i) != _bit(b, i)) {
+            return i;
+        }
+        i++;
+    }
+    while (((i + 8) <= to) && (a[i >> 3] == b[i >> 3])) {
+        i += 8;
+    }
+    while ((i < to) && (_bit(a, i) == _bit(b, i))) {
+        i++;
+    }
+    return i;
+}
+
+static bool _is_all_zero(const universal_address_container_t *addr)
+{
+    for (size_t i = 0; i < addr->address_size; i++) {
+        if (addr->address[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* entries without prefix length only ever match exactly, so they are indexed
+ * with their full address length */
+static unsigned _prefix_len(const fib_entry_t *entry)
+{
+    unsigned addr_len = entry->global->address_size << 3;
+
+    if (_is_all_zero(entry->global)) {
+        return 0;
+    }
+    if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        unsigned prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                              >> FIB_FLAG_NET_PREFIX_SHIFT;
+        return (prefix_len < addr_len) ? prefix_len : addr_len;
+    }
+    return addr_len;
+}
+
+static inline bool _is_prefix_route(const fib_entry_t *entry)
+{
+    return (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) ||
+           (entry->trie_node->prefix_len == 0);
+}
+
+static fib_trie_node_t *_node_alloc(fib_table_t *table, const uint8_t *key,
+                                    unsigned prefix_len)
+{
+    for (size_t i = 0; i < table->size; i++) {
+        for (unsigned j = 0; j < 2; j++) {
+            fib_trie_node_t *node = &table->data.entries[i].trie_nodes[j];
+
+            if (!node->in_use) {
+                unsigned bytes = (prefix_len + 7) >> 3;
+
+                memset(node, 0, sizeof(*node));
+                node->in_use = 1;
+                node->prefix_len = prefix_len;
+                memcpy(node->key, key, bytes);
+                if (prefix_len & 0x7) {
+                    node->key[bytes - 1] &= 0xff << (8 - (prefix_len & 0x7));
+                }
+                return node;
+            }
+        }
+    }
+    return NULL;
+}
+
+static inline fib_trie_node_t **_link(fib_table_t *table,
+                                      fib_trie_node_t *node)
+{
+    if (node->parent == NULL) {
+        return &table->trie_root;
+    }
+    return &node->parent->child[node->parent->child[1] == node];
+}
+
+static void _attach(fib_trie_node_t *node, fib_entry_t *entry)
+{
+    entry->trie_node = node;
+    entry->trie_next = node->entries;
+    node->entries = entry;
+}
+
+int fib_trie_add(fib_table_t *table, fib_entry_t *entry)
+{
+    const uint8_t *key = entry->global->address;
+    unsigned prefix_len = _prefix_len(entry);
+    fib_trie_node_t **link = &table->trie_root;
+    fib_trie_node_t *parent = NULL;
+    fib_trie_node_t *leaf;
+
+    while (*link != NULL) {
+        fib_trie_node_t *node = *link;
+        unsigned max = (node->prefix_len < prefix_len) ? node->prefix_len
+                                                       : prefix_len;
+        unsigned common = _match_bits(node->key, key, 0, max);
+
+        if (common == node->prefix_len) {
+            if (node->prefix_len == prefix_len) {
+                _attach(node, entry);
+                return 0;
+            }
+            /* node is a prefix of key: descend */
+            parent = node;
+            link = &node->child[_bit(key, node->prefix_len)];
+            continue;
+        }
+
+        /* key diverges from node or is a prefix of it: split above node */
+        leaf = _node_alloc(table, key, prefix_len);
+        if (leaf == NULL) {
+            return -ENOMEM;
+        }
+        if (common == prefix_len) {
+            leaf->child[_bit(node->key, prefix_len)] = node;
+            leaf->parent = parent;
+            node->parent = leaf;
+            *link = leaf;
+        }
+        else {
+            fib_trie_node_t *branch = _node_alloc(table, key, common);
+
+            if (branch == NULL) {
+                leaf->in_use = 0;
+                return -ENOMEM;
+            }
+            branch->child[_bit(node->key, common)] = node;
+            branch->child[_bit(key, common)] = leaf;
+            branch->parent = parent;
+            node->parent = branch;
+            leaf->parent = branch;
+            *link = branch;
+        }
+        _attach(leaf, entry);
+        return 0;
+    }
+
+    leaf = _node_alloc(table, key, prefix_len);
+    if (leaf == NULL) {
+        return -ENOMEM;
+    }
+    leaf->parent = parent;
+    *link = leaf;
+    _attach(leaf, entry);
+    return 0;
+}
+
+void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *node = entry->trie_node;
+
+    if (node == NULL) {
+        return;
+    }
+
+    for (fib_entry_t **ptr = &node->entries; *ptr != NULL;
+         ptr = &(*ptr)->trie_next) {
+        if (*ptr == entry) {
+            *ptr = entry->trie_next;
+            break;
+        }
+    }
+    entry->trie_node = NULL;
+    entry->trie_next = NULL;
+
+    /* release nodes that neither hold entries nor branch any more */
+    while ((node != NULL) && (node->entries == NULL) &&
+           ((node->child[0] == NULL) || (node->child[1] == NULL))) {
+        fib_trie_node_t *child = (node->child[0]) ? node->child[0]
+                                                  : node->child[1];
+        fib_trie_node_t *parent = node->parent;
+
+        *_link(table, node) = child;
+        node->in_use = 0;
+        if (child != NULL) {
+            /* the number of children of parent did not change */
+            child->parent = parent;
+            break;
+        }
+        node = parent;
+    }
+}
+
+int fib_trie_find(fib_table_t *table, const uint8_t *dst, size_t dst_size,
+                  fib_entry_t **entry)
+{
+    unsigned dst_len = dst_size << 3;
+    unsigned matched = 0;
+    fib_trie_node_t *node = table->trie_root;
+    fib_entry_t *best = NULL;
+
+    while ((node != NULL) && (node->prefix_len <= dst_len)) {
+        /* only the bits following the parent's prefix need to be checked */
+        if (_match_bits(node->key, dst, matched,
+                        node->prefix_len) != node->prefix_len) {
+            break;
+        }
+        matched = node->prefix_len;
+
+        for (fib_entry_t *e = node->entries; e != NULL; e = e->trie_next) {
+            if (e->global->address_size != dst_size) {
+                continue;
+            }
+            if (memcmp(e->global->address, dst, dst_size) == 0) {
+                *entry = e;
+                return 1;
+            }
+            if (_is_prefix_route(e)) {
+                best = e;
+            }
+        }
+
+        if (matched == dst_len) {
+            break;
+        }
+        node = node->child[_bit(dst, matched)];
+    }
+
+    if (best != NULL) {
+        DEBUG("fib_trie: found /%u prefix for destination\n",
+              best->trie_node->prefix_len);
+        *entry = best;
+        return 0;
+    }
+    return -EHOSTUNREACH;
+}
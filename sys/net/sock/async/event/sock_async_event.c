@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Posts sock events to an event queue
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "net/sock/async/event.h"
+
+/* called in the network stack's context */
+static void _post(sock_event_t *event, sock_async_flags_t type)
+{
+    unsigned state = irq_disable();
+
+    event->type |= type;
+    irq_restore(state);
+    /* an event still queued is not added a second time */
+    event_post(event->queue, &event->super);
+}
+
+/* called in the queue's thread */
+static sock_async_flags_t _take(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    unsigned state = irq_disable();
+    sock_async_flags_t type = event->type;
+
+    event->type = 0;
+    irq_restore(state);
+    return type;
+}
+
+static void _init(sock_event_t *event, void *sock, event_queue_t *queue,
+                  event_handler_t handler, void *handler_arg)
+{
+    assert((event != NULL) && (queue != NULL));
+    event->super.handler = handler;
+    event->queue = queue;
+    event->sock = sock;
+    event->handler_arg = handler_arg;
+    event->type = 0;
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t type, void *arg)
+{
+    (void)sock;
+    _post(arg, type);
+}
+
+static void _ip_handler(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    sock_async_flags_t type = _take(ev);
+
+    if (type) {
+        event->handler.ip(event->sock, type, event->handler_arg);
+    }
+}
+
+void sock_ip_event_init(sock_ip_t *sock, sock_event_t *event,
+                        event_queue_t *queue, sock_ip_cb_t handler,
+                        void *handler_arg)
+{
+    assert(handler != NULL);
+    _init(event, sock, queue, _ip_handler, handler_arg);
+    event->handler.ip = handler;
+    sock_ip_set_cb(sock, _ip_cb, event);
+}
+#endif  /* MODULE_SOCK_IP */
+
+#ifdef MODULE_SOCK_TCP
+static void _tcp_cb(sock_tcp_t *sock, sock_async_flags_t type, void *arg)
+{
+    (void)sock;
+    _post(arg, type);
+}
+
+static void _tcp_handler(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    sock_async_flags_t type = _take(ev);
+
+    if (type) {
+        event->handler.tcp(event->sock, type, event->handler_arg);
+    }
+}
+
+void sock_tcp_event_init(sock_tcp_t *sock, sock_event_t *event,
+                         event_queue_t *queue, sock_tcp_cb_t handler,
+                         void *handler_arg)
+{
+    assert(handler != NULL);
+    _init(event, sock, queue, _tcp_handler, handler_arg);
+    event->handler.tcp = handler;
+    sock_tcp_set_cb(sock, _tcp_cb, event);
+}
+
+static void _tcp_queue_cb(sock_tcp_queue_t *queue, sock_async_flags_t type,
+                          void *arg)
+{
+    (void)queue;
+    _post(arg, type);
+}
+
+static void _tcp_queue_handler(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    sock_async_flags_t type = _take(ev);
+
+    if (type) {
+        event->handler.tcp_queue(event->sock, type, event->handler_arg);
+    }
+}
+
+void sock_tcp_queue_event_init(sock_tcp_queue_t *tcp_queue,
+                               sock_event_t *event, event_queue_t *queue,
+                               sock_tcp_queue_cb_t handler,
+                               void *handler_arg)
+{
+    assert(handler != NULL);
+    _init(event, tcp_queue, queue, _tcp_queue_handler, handler_arg);
+    event->handler.tcp_queue = handler;
+    sock_tcp_queue_set_cb(tcp_queue, _tcp_queue_cb, event);
+}
+#endif  /* MODULE_SOCK_TCP */
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+{
+    (void)sock;
+    _post(arg, type);
+}
+
+static void _udp_handler(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    sock_async_flags_t type = _take(ev);
+
+    if (type) {
+        event->handler.udp(event->sock, type, event->handler_arg);
+    }
+}
+
+void sock_udp_event_init(sock_udp_t *sock, sock_event_t *event,
+                         event_queue_t *queue, sock_udp_cb_t handler,
+                         void *handler_arg)
+{
+    assert(handler != NULL);
+    _init(event, sock, queue, _udp_handler, handler_arg);
+    event->handler.udp = handler;
+    sock_udp_set_cb(sock, _udp_cb, event);
+}
+#endif  /* MODULE_SOCK_UDP */
+
+#ifdef MODULE_GNRC_TCP
+static void _gnrc_tcp_cb(gnrc_tcp_tcb_t *tcb, sock_async_flags_t type,
+                         void *arg)
+{
+    (void)tcb;
+    _post(arg, type);
+}
+
+static void _gnrc_tcp_handler(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    sock_async_flags_t type = _take(ev);
+
+    if (type) {
+        event->handler.gnrc_tcp(event->sock, type, event->handler_arg);
+    }
+}
+
+void gnrc_tcp_event_init(gnrc_tcp_tcb_t *tcb, sock_event_t *event,
+                         event_queue_t *queue, gnrc_tcp_cb_t handler,
+                         void *handler_arg)
+{
+    assert(handler != NULL);
+    _init(event, tcb, queue, _gnrc_tcp_handler, handler_arg);
+    event->handler.gnrc_tcp = handler;
+    gnrc_tcp_set_cb(tcb, _gnrc_tcp_cb, event);
+}
+#endif  /* MODULE_GNRC_TCP */
+
+/** @} */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_poll
+ * @{
+ */
+
+/**
+ * @file
+ * @brief   POSIX compatible poll.h definitions
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html">
+ *              The Open Group Base Specifications Issue 7, <poll.h>
+ *          </a>
+ */
+
+#if defined(CPU_NATIVE) && !defined(DOXYGEN)
+/* If building on native we need to use the system header instead */
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <poll.h>
+#else
+#ifndef POLL_H
+#define POLL_H
+
+#include "vfs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Events for struct pollfd::events and struct pollfd::revents
+ * @{
+ */
+#define POLLIN      VFS_POLLIN  /**< data can be read without blocking */
+#define POLLPRI     (0x02)      /**< high priority data can be read (never
+                                 *   reported) */
+#define POLLOUT     VFS_POLLOUT /**< data can be written without blocking */
+#define POLLERR     VFS_POLLERR /**< an error occurred (revents only) */
+#define POLLHUP     VFS_POLLHUP /**< the remote end hung up (revents only) */
+#define POLLNVAL    (0x20)      /**< invalid file descriptor (revents only) */
+#define POLLRDNORM  (0x40)      /**< normal data can be read without blocking */
+#define POLLWRNORM  (0x100)     /**< normal data can be written without
+                                 *   blocking */
+/** @} */
+
+/**
+ * @brief   Type for the number of file descriptors given to poll()
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   File descriptor to wait on with poll()
+ */
+struct pollfd {
+    int fd;         /**< file descriptor, ignored if negative */
+    short events;   /**< requested events */
+    short revents;  /**< returned events */
+};
+
+/**
+ * @brief   Waits for events on a set of file descriptors
+ *
+ * @param[in,out] fds   file descriptors and the events to wait for.
+ *                      At most @ref VFS_MAX_OPEN_FILES.
+ * @param[in] nfds      number of entries in @p fds
+ * @param[in] timeout   timeout in milliseconds. 0 returns immediately,
+ *                      a negative value waits forever.
+ *
+ * @return  number of entries in @p fds with non-zero
+ *          struct pollfd::revents on success, 0 on timeout
+ * @return  -1 on error, errno is set accordingly
+ */
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+#endif /* CPU_NATIVE */
+/** @} */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_poll
+ * @{
+ */
+
+/**
+ * @file
+ * @brief   POSIX compatible sys/select.h definitions
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/sys_select.h.html">
+ *              The Open Group Base Specifications Issue 7, <sys/select.h>
+ *          </a>
+ */
+
+#if (defined(CPU_NATIVE) || MODULE_NEWLIB) && !defined(DOXYGEN)
+/* If building on native or newlib we need to use the system header instead */
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <sys/select.h>
+#else
+#ifndef SYS_SELECT_H
+#define SYS_SELECT_H
+
+#include <string.h>
+#include <sys/time.h>   /* for struct timeval */
+
+#include "bitfield.h"
+#include "vfs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of file descriptors in an fd_set
+ */
+#define FD_SETSIZE          VFS_MAX_OPEN_FILES
+
+/**
+ * @brief   Set of file descriptors
+ */
+typedef struct {
+    BITFIELD(fds, FD_SETSIZE);  /**< bit per file descriptor */
+} fd_set;
+
+/**
+ * @name    fd_set manipulation
+ * @{
+ */
+#define FD_CLR(fd, set)     bf_unset((set)->fds, (fd))
+#define FD_ISSET(fd, set)   bf_isset((set)->fds, (fd))
+#define FD_SET(fd, set)     bf_set((set)->fds, (fd))
+#define FD_ZERO(set)        memset((set), 0, sizeof(fd_set))
+/** @} */
+
+/**
+ * @brief   Waits for a set of file descriptors to become ready
+ *
+ * Implemented on top of poll(), errors and hang-ups are reported as
+ * readable.
+ *
+ * @param[in] nfds          highest file descriptor in any of the sets + 1.
+ *                          At most @ref VFS_MAX_OPEN_FILES.
+ * @param[in,out] readfds   file descriptors to check for reading. May be NULL.
+ * @param[in,out] writefds  file descriptors to check for writing. May be NULL.
+ * @param[in,out] errorfds  file descriptors to check for errors. May be NULL.
+ * @param[in] timeout       maximum time to wait. NULL waits forever.
+ *
+ * @return  total number of ready file descriptors in all sets on success,
+ *          0 on timeout
+ * @return  -1 on error, errno is set accordingly
+ */
+int select(int nfds, fd_set *restrict readfds, fd_set *restrict writefds,
+           fd_set *restrict errorfds, struct timeval *restrict timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYS_SELECT_H */
+#endif /* CPU_NATIVE || MODULE_NEWLIB */
+/** @} */
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   poll() and select() on top of the VFS readiness notifications
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <poll.h>
+#include <sys/select.h>
+
+#include "thread_flags.h"
+#include "timex.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#if (POLLIN != VFS_POLLIN) || (POLLOUT != VFS_POLLOUT) || \
+    (POLLERR != VFS_POLLERR) || (POLLHUP != VFS_POLLHUP)
+#error "poll() events do not match the VFS events"
+#endif
+
+#define _NO_TIMEOUT     (UINT32_MAX)
+
+static int _ready(struct pollfd *fds, nfds_t nfds)
+{
+    int ready = 0;
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        struct pollfd *pfd = &fds[i];
+        int events;
+
+        pfd->revents = 0;
+        if (pfd->fd < 0) {
+            continue;
+        }
+        if ((events = vfs_poll_ready(pfd->fd)) < 0) {
+            pfd->revents = POLLNVAL;
+        }
+        else {
+            if (events & POLLIN) {
+                events |= POLLRDNORM;
+            }
+            if (events & POLLOUT) {
+                events |= POLLWRNORM;
+            }
+            /* errors and hang-ups are always reported */
+            pfd->revents = events & (pfd->events | POLLERR | POLLHUP);
+        }
+        if (pfd->revents != 0) {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+static int _poll(struct pollfd *fds, nfds_t nfds, uint32_t timeout)
+{
+    vfs_poll_waiter_t waiters[VFS_MAX_OPEN_FILES];
+    xtimer_t timer;
+    int res;
+
+    if (nfds > VFS_MAX_OPEN_FILES) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (((res = _ready(fds, nfds)) > 0) || (timeout == 0)) {
+        return res;
+    }
+    /* register before checking again, so no notification gets lost */
+    thread_flags_clear(THREAD_FLAG_VFS_POLL | THREAD_FLAG_TIMEOUT);
+    for (nfds_t i = 0; i < nfds; i++) {
+        if (fds[i].fd >= 0) {
+            vfs_poll_add(fds[i].fd, &waiters[i]);
+        }
+    }
+    if (timeout != _NO_TIMEOUT) {
+        xtimer_set_timeout_flag(&timer, timeout);
+    }
+    while ((res = _ready(fds, nfds)) == 0) {
+        thread_flags_t flags = thread_flags_wait_any(THREAD_FLAG_VFS_POLL |
+                                                     THREAD_FLAG_TIMEOUT);
+
+        if (flags & THREAD_FLAG_TIMEOUT) {
+            res = _ready(fds, nfds);
+            break;
+        }
+    }
+    if (timeout != _NO_TIMEOUT) {
+        xtimer_remove(&timer);
+        thread_flags_clear(THREAD_FLAG_TIMEOUT);
+    }
+    for (nfds_t i = 0; i < nfds; i++) {
+        if (fds[i].fd >= 0) {
+            vfs_poll_del(fds[i].fd, &waiters[i]);
+        }
+    }
+    return res;
+}
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+    uint32_t timeout_us = _NO_TIMEOUT;
+
+    if (timeout >= 0) {
+        uint64_t us = (uint64_t)timeout * US_PER_MS;
+
+        timeout_us = (us < _NO_TIMEOUT) ? (uint32_t)us : (_NO_TIMEOUT - 1);
+    }
+    return _poll(fds, nfds, timeout_us);
+}
+
+static int _select_result(int fd, fd_set *set, bool ready)
+{
+    if ((set == NULL) || !FD_ISSET(fd, set)) {
+        return 0;
+    }
+    if (!ready) {
+        FD_CLR(fd, set);
+        return 0;
+    }
+    return 1;
+}
+
+int select(int nfds, fd_set *restrict readfds, fd_set *restrict writefds,
+           fd_set *restrict errorfds, struct timeval *restrict timeout)
+{
+    struct pollfd fds[VFS_MAX_OPEN_FILES];
+    uint32_t timeout_us = _NO_TIMEOUT;
+    nfds_t num = 0;
+    int res;
+
+    if ((nfds < 0) || (nfds > VFS_MAX_OPEN_FILES)) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (timeout != NULL) {
+        uint64_t us;
+
+        if ((timeout->tv_sec < 0) || (timeout->tv_usec < 0)) {
+            errno = EINVAL;
+            return -1;
+        }
+        us = ((uint64_t)timeout->tv_sec * US_PER_SEC) + timeout->tv_usec;
+        timeout_us = (us < _NO_TIMEOUT) ? (uint32_t)us : (_NO_TIMEOUT - 1);
+    }
+    for (int fd = 0; fd < nfds; fd++) {
+        short events = 0;
+
+        if ((readfds != NULL) && FD_ISSET(fd, readfds)) {
+            events |= POLLIN;
+        }
+        if ((writefds != NULL) && FD_ISSET(fd, writefds)) {
+            events |= POLLOUT;
+        }
+        /* POLLERR is always reported, so errorfds needs no extra events */
+        if ((events == 0) && ((errorfds == NULL) || !FD_ISSET(fd, errorfds))) {
+            continue;
+        }
+        fds[num].fd = fd;
+        fds[num].events = events;
+        num++;
+    }
+    if ((res = _poll(fds, num, timeout_us)) < 0) {
+        return res;
+    }
+    res = 0;
+    for (nfds_t i = 0; i < num; i++) {
+        int fd = fds[i].fd;
+        short revents = fds[i].revents;
+
+        if (revents & POLLNVAL) {
+            errno = EBADF;
+            return -1;
+        }
+        res += _select_result(fd, readfds, revents & (POLLIN | POLLERR | POLLHUP));
+        res += _select_result(fd, writefds, revents & (POLLOUT | POLLERR));
+        res += _select_result(fd, errorfds, revents & POLLERR);
+    }
+    return res;
+}
+
+/** @} */
@@ -23,7 +23,16 @@
 #include <stdbool.h>
 #include <string.h>
 
+/* sockets report their readiness to poll() and select() if the network stack
+ * implements the sock_async callbacks, otherwise they never block them */
+#if defined(MODULE_VFS_POLL) && defined(MODULE_SOCK_ASYNC)
+#define _SOCKET_READINESS
+#endif
+
 #include "bitfield.h"
+#ifdef _SOCKET_READINESS
+#include "irq.h"
+#endif
 #include "mutex.h"
 #include "net/ipv4/addr.h"
 #include "net/ipv6/addr.h"
@@ -36,6 +45,9 @@
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
 #include "net/sock/tcp.h"
+#ifdef _SOCKET_READINESS
+#include "net/sock/async.h"
+#endif
 
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
@@ -80,6 +92,14 @@ typedef struct {
     unsigned queue_array_len;
 #endif
     sock_tcp_ep_t local;        /* to store bind before connect/listen */
+#ifdef _SOCKET_READINESS
+    /* received messages or connections not yet taken by recv() or accept().
+     * For SOCK_STREAM it is only known that all data was read when a read
+     * returns less than requested, so poll() may report readiness spuriously
+     * there */
+    unsigned pending;
+    bool hup;                   /* connection was closed by the remote */
+#endif
 } socket_t;
 
 static socket_t _socket_pool[_ACTUAL_SOCKET_POOL_SIZE];
@@ -93,6 +113,12 @@ static mutex_t _socket_pool_mutex = MUTEX_INIT;
 const struct in6_addr in6addr_any = IN6ADDR_ANY_INIT;
 const struct in6_addr in6addr_loopback = IN6ADDR_LOOPBACK_INIT;
 
+#ifdef _SOCKET_READINESS
+static int _bind_connect(socket_t *s, const struct sockaddr *address,
+                         socklen_t address_len);
+static int _getpeername(socket_t *s, struct sockaddr *__restrict address,
+                        socklen_t *__restrict address_len);
+#endif
 static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
                                size_t length, int flags,
                                struct sockaddr *restrict address,
@@ -101,6 +127,97 @@ static ssize_t socket_sendto(socket_t *s, const void *buffer, size_t length,
                              int flags, const struct sockaddr *address,
                              socklen_t address_len);
 
+#ifdef _SOCKET_READINESS
+static void _sock_event(socket_t *s, sock_async_flags_t flags)
+{
+    unsigned state = irq_disable();
+
+    if (flags & (SOCK_ASYNC_MSG_RECV | SOCK_ASYNC_CONN_RECV)) {
+        s->pending++;
+    }
+    if (flags & SOCK_ASYNC_CONN_FIN) {
+        s->hup = true;
+    }
+    irq_restore(state);
+    if (flags & (SOCK_ASYNC_MSG_RECV | SOCK_ASYNC_CONN_RECV |
+                 SOCK_ASYNC_CONN_FIN)) {
+        vfs_poll_notify(s->fd);
+    }
+}
+
+static void _consumed(socket_t *s, bool all)
+{
+    unsigned state = irq_disable();
+
+    if (all) {
+        s->pending = 0;
+    }
+    else if (s->pending > 0) {
+        s->pending--;
+    }
+    irq_restore(state);
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    _sock_event(arg, flags);
+}
+#endif
+
+#ifdef MODULE_SOCK_TCP
+static void _tcp_cb(sock_tcp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    _sock_event(arg, flags);
+}
+
+static void _tcp_queue_cb(sock_tcp_queue_t *queue, sock_async_flags_t flags,
+                          void *arg)
+{
+    (void)queue;
+    _sock_event(arg, flags);
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    _sock_event(arg, flags);
+}
+#endif
+
+static void _set_cb(socket_t *s)
+{
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            sock_ip_set_cb(&s->sock->raw, _ip_cb, s);
+            break;
+#endif
+#ifdef MODULE_SOCK_TCP
+        case SOCK_STREAM:
+            if (s->queue_array == NULL) {
+                sock_tcp_set_cb(&s->sock->tcp.sock, _tcp_cb, s);
+            }
+            else {
+                sock_tcp_queue_set_cb(&s->sock->tcp.queue, _tcp_queue_cb, s);
+            }
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            sock_udp_set_cb(&s->sock->udp, _udp_cb, s);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+#endif /* _SOCKET_READINESS */
+
 static socket_t *_get_free_socket(void)
 {
     for (int i = 0; i < _ACTUAL_SOCKET_POOL_SIZE; i++) {
@@ -247,12 +364,10 @@ static int _sockaddr_to_ep(const struct sockaddr *address, socklen_t address_len
     return 0;
 }
 
-static int socket_close(vfs_file_t *filp)
+static int _sock_release(socket_t *s)
 {
-    socket_t *s = filp->private_data.ptr;
     int res = 0;
 
-    assert((s->domain == AF_INET) || (s->domain == AF_INET6));
     mutex_lock(&_socket_pool_mutex);
     if (s->sock != NULL) {
         int idx = _get_sock_idx(s->sock);
@@ -288,7 +403,23 @@ static int socket_close(vfs_file_t *filp)
     }
     mutex_unlock(&_socket_pool_mutex);
     s->sock = NULL;
+#ifdef _SOCKET_READINESS
+    /* no callbacks anymore, the sock is closed */
+    s->pending = 0;
+    s->hup = false;
+#endif
+    return res;
+}
+
+static int socket_close(vfs_file_t *filp)
+{
+    socket_t *s = filp->private_data.ptr;
+    int res;
+
+    assert((s->domain == AF_INET) || (s->domain == AF_INET6));
+    res = _sock_release(s);
     s->domain = AF_UNSPEC;
+    s->bound = false;
     return res;
 }
 
@@ -319,6 +450,42 @@ static inline ssize_t socket_write(vfs_file_t *filp, const void *buf, size_t n)
     return socket_sendto(filp->private_data.ptr, buf, n, 0, NULL, 0);
 }
 
+#ifdef _SOCKET_READINESS
+static int socket_poll(vfs_file_t *filp)
+{
+    socket_t *s = filp->private_data.ptr;
+    int events = 0;
+    unsigned state;
+
+    if ((s->sock == NULL) && (s->type != SOCK_STREAM)) {
+        /* nothing can be received without a sock, sending creates one */
+        return VFS_POLLOUT;
+    }
+    state = irq_disable();
+    if (s->pending > 0) {
+        events |= VFS_POLLIN;
+    }
+    if (s->hup) {
+        /* reading returns the end of the stream without blocking */
+        events |= VFS_POLLIN | VFS_POLLHUP;
+    }
+    irq_restore(state);
+#ifdef MODULE_SOCK_TCP
+    if (s->type == SOCK_STREAM) {
+        if (s->sock == NULL) {
+            /* not connected */
+            return events | VFS_POLLOUT | VFS_POLLHUP;
+        }
+        if (s->queue_array != NULL) {
+            /* listening, nothing to write */
+            return events;
+        }
+    }
+#endif
+    return events | VFS_POLLOUT;
+}
+#endif
+
 static const vfs_file_ops_t socket_ops = {
     .close = socket_close,
     .fcntl = NULL,          /* TODO: provide when needed */
@@ -326,6 +493,9 @@ static const vfs_file_ops_t socket_ops = {
     .lseek = socket_lseek,
     .read = socket_read,
     .write = socket_write,
+#ifdef _SOCKET_READINESS
+    .poll = socket_poll,
+#endif
 };
 
 int socket(int domain, int type, int protocol)
@@ -364,6 +534,10 @@ int socket(int domain, int type, int protocol)
             }
             s->bound = false;
             s->sock = NULL;
+#ifdef _SOCKET_READINESS
+            s->pending = 0;
+            s->hup = false;
+#endif
 #ifdef POSIX_SETSOCKOPT
             s->recv_timeout = SOCK_NO_TIMEOUT;
 #endif
@@ -463,6 +637,12 @@ int accept(int socket, struct sockaddr *restrict address,
                 new_s->queue_array_len = 0;
                 new_s->sock = (socket_sock_t *)sock;
                 memset(&s->local, 0, sizeof(sock_tcp_ep_t));
+#ifdef _SOCKET_READINESS
+                _consumed(s, false);
+                new_s->pending = 0;
+                new_s->hup = false;
+                _set_cb(new_s);
+#endif
             }
             break;
         default:
@@ -527,6 +707,16 @@ int bind(int socket, const struct sockaddr *address, socklen_t address_len)
         return -1;
     }
     s->bound = true;
+#ifdef _SOCKET_READINESS
+    if (s->type != SOCK_STREAM) {
+        /* create the sock right away, so poll() reports datagrams to the
+         * bound end point */
+        if (_bind_connect(s, NULL, 0) < 0) {
+            s->bound = false;
+            return -1;
+        }
+    }
+#endif
     return 0;
 }
 
@@ -595,6 +785,9 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
         return -1;
     }
     s->sock = sock;
+#ifdef _SOCKET_READINESS
+    _set_cb(s);
+#endif
     return 0;
 }
 
@@ -609,6 +802,17 @@ int connect(int socket, const struct sockaddr *address, socklen_t address_len)
         errno = ENOTSOCK;
         return -1;
     }
+#ifdef _SOCKET_READINESS
+    if ((s->sock != NULL) && (s->type != SOCK_STREAM)) {
+        struct sockaddr_storage sa;
+        socklen_t sa_len = sizeof(sa);
+
+        if (_getpeername(s, (struct sockaddr *)&sa, &sa_len) < 0) {
+            /* only created by bind(), recreate it with the remote */
+            _sock_release(s);
+        }
+    }
+#endif
     if (s->sock != NULL) {
 #ifdef MODULE_SOCK_TCP
         if (s->queue_array != NULL) {
@@ -794,6 +998,9 @@ int listen(int socket, int backlog)
     }
     if (res == 0) {
         s->sock = sock;
+#ifdef _SOCKET_READINESS
+        _set_cb(s);
+#endif
     }
     else {
         errno = -res;
@@ -867,6 +1074,12 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
             res = -EOPNOTSUPP;
             break;
     }
+#ifdef _SOCKET_READINESS
+    if (res >= 0) {
+        /* a stream was drained when less than requested was read */
+        _consumed(s, (s->type == SOCK_STREAM) && ((size_t)res < length));
+    }
+#endif
     if ((res >= 0) && (address != NULL) && (address_len != NULL)) {
         switch (s->type) {
 #ifdef MODULE_SOCK_TCP
@@ -21,15 +21,85 @@
  * @}
  */
 
+#include <errno.h>
+#include <string.h>
+
+#include "irq.h"
 #include "sched.h"
-#include "xtimer.h"
+#include "thread.h"
 #include "schedstatistics.h"
 
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+#include "cpu.h"
+#ifdef CPU_NATIVE
+#include <time.h>
+#include "native_internal.h"
+#include "timex.h"
+#else
+#include "periph_conf.h"
+#endif
+#else
+#include "xtimer.h"
+#endif
+
 schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
 
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+
+#if defined(CPU_NATIVE)
+#define TICKS_PER_SEC       (US_PER_SEC)
+
+static inline uint32_t _now(void)
+{
+    struct timespec ts;
+
+    real_clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint32_t)ts.tv_sec * US_PER_SEC) + (ts.tv_nsec / NS_PER_US);
+}
+
+static void _counter_init(void)
+{
+}
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+#define TICKS_PER_SEC       (CLOCK_CORECLOCK)
+
+static inline uint32_t _now(void)
+{
+    return DWT->CYCCNT;
+}
+
+static void _counter_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#else
+#error "schedstatistics_cycles: no cycle counter available for this CPU"
+#endif
+
+static uint64_t _isr_ticks;
+static uint32_t _isr_start;
+
+static void _ready_cb(kernel_pid_t pid)
+{
+    sched_pidlist[pid].readystart = _now();
+}
+
+#else /* MODULE_SCHEDSTATISTICS_CYCLES */
+
+#define TICKS_PER_SEC       (XTIMER_HZ)
+
+static inline uint32_t _now(void)
+{
+    return xtimer_now().ticks32;
+}
+
+#endif /* MODULE_SCHEDSTATISTICS_CYCLES */
+
 void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
 {
-    uint32_t now = xtimer_now().ticks32;
+    uint32_t now = _now();
 
     /* Update active thread runtime, there is allways an active thread since
        first sched_run happens when main_trampoline gets scheduled */
@@ -40,14 +110,110 @@ void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
     schedstat_t *next_stat = &sched_pidlist[next_thread];
     next_stat->laststart = now;
     next_stat->schedules++;
+
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+    /* a thread that is still on a runqueue was preempted or yielded, it
+     * becomes ready again right now */
+    thread_t *active = (thread_t *)sched_threads[active_thread];
+    if (active && (active->status >= STATUS_ON_RUNQUEUE)) {
+        active_stat->involuntary++;
+        active_stat->readystart = now;
+    }
+    else {
+        active_stat->voluntary++;
+    }
+
+    uint32_t latency = now - next_stat->readystart;
+    if (latency > next_stat->max_latency) {
+        next_stat->max_latency = latency;
+    }
+#endif
 }
 
 void init_schedstatistics(void)
 {
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+    _counter_init();
+    /* threads created before now have never been marked ready */
+    uint32_t now = _now();
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        sched_pidlist[i].readystart = now;
+    }
+    sched_register_ready_cb(_ready_cb);
+#endif
     /* Init laststart for the thread starting schedstatistics since the callback
        wasn't registered when it was first scheduled */
     schedstat_t *active_stat = &sched_pidlist[sched_active_pid];
-    active_stat->laststart = xtimer_now().ticks32;
+    active_stat->laststart = _now();
     active_stat->schedules = 1;
     sched_register_cb(sched_statistics_cb);
 }
+
+uint32_t schedstat_ticks_per_sec(void)
+{
+    return TICKS_PER_SEC;
+}
+
+int schedstat_get(kernel_pid_t pid, schedstat_t *stat)
+{
+    if (!pid_is_valid(pid)) {
+        return -EINVAL;
+    }
+
+    unsigned state = irq_disable();
+    *stat = sched_pidlist[pid];
+    /* account the running thread up to now */
+    if (pid == sched_active_pid) {
+        stat->runtime_ticks += _now() - stat->laststart;
+    }
+    irq_restore(state);
+
+    return 0;
+}
+
+void schedstat_reset(void)
+{
+    unsigned state = irq_disable();
+    uint32_t now = _now();
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        schedstat_t *stat = &sched_pidlist[i];
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+        uint32_t readystart = stat->readystart;
+#endif
+        memset(stat, 0, sizeof(*stat));
+        stat->laststart = now;
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+        stat->readystart = readystart;
+#endif
+    }
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+    _isr_ticks = 0;
+#endif
+    irq_restore(state);
+}
+
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+uint64_t schedstat_isr_ticks(void)
+{
+    unsigned state = irq_disable();
+    uint64_t ticks = _isr_ticks;
+    irq_restore(state);
+
+    return ticks;
+}
+
+void schedstat_isr_enter(void)
+{
+    _isr_start = _now();
+}
+
+void schedstat_isr_exit(void)
+{
+    uint32_t duration = _now() - _isr_start;
+
+    _isr_ticks += duration;
+    /* don't account the ISR to the interrupted thread */
+    sched_pidlist[sched_active_pid].laststart += duration;
+}
+#endif
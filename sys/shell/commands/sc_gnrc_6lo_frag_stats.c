@@ -25,6 +25,9 @@ int _gnrc_6lo_frag_stats(int argc, char **argv)
     (void)argv;
     printf("rbuf full: %u\n", stats->rbuf_full);
     printf("frag full: %u\n", stats->frag_full);
+    printf("rbuf hit: %u\n", stats->rbuf_hit);
+    printf("rbuf miss: %u\n", stats->rbuf_miss);
+    printf("rbuf evict: %u\n", stats->rbuf_evict);
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
     printf("VRB full: %u\n", stats->vrb_full);
 #endif
@@ -130,6 +130,15 @@ static int _netif_stats(kernel_pid_t iface, unsigned module, bool reset)
                (unsigned) stats->tx_bytes,
                (unsigned) stats->tx_success,
                (unsigned) stats->tx_failed);
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+        if (module == NETSTATS_LAYER2) {
+            printf("            RX batches %u (max. size: %u)  "
+                   "budget exhausted %u\n",
+                   (unsigned) stats->rx_batches,
+                   (unsigned) stats->rx_batch_max,
+                   (unsigned) stats->rx_budget_exhausted);
+        }
+#endif
         res = 0;
     }
     return res;
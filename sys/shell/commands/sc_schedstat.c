@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the scheduler statistics
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "sched.h"
+#include "schedstatistics.h"
+#include "thread.h"
+#include "timex.h"
+
+static uint32_t _to_us(uint64_t ticks)
+{
+    return (uint32_t)((ticks * US_PER_SEC) / schedstat_ticks_per_sec());
+}
+
+int _schedstat_handler(int argc, char **argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        schedstat_reset();
+        return 0;
+    }
+    if (argc > 1) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+
+    printf("\tpid | runtime [us] |   switches"
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+           " | voluntary | involuntary | max latency [us]"
+#endif
+           "\n");
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        schedstat_t stat;
+
+        if ((sched_threads[i] == NULL) || (schedstat_get(i, &stat) < 0)) {
+            continue;
+        }
+        printf("\t%3" PRIkernel_pid " | %12" PRIu32 " | %10u"
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+               " | %9u | %11u | %16" PRIu32
+#endif
+               "\n", i, _to_us(stat.runtime_ticks), stat.schedules
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+               , stat.voluntary, stat.involuntary, _to_us(stat.max_latency)
+#endif
+              );
+    }
+#ifdef MODULE_SCHEDSTATISTICS_CYCLES
+    printf("\tisr | %12" PRIu32 "\n", _to_us(schedstat_isr_ticks()));
+#endif
+
+    return 0;
+}
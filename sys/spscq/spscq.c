@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_spscq
+ * @{
+ *
+ * @file
+ * @brief       Lock-free single producer single consumer queue implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "thread.h"
+#include "spscq.h"
+
+/* header of the record that fills the rest of the buffer */
+#define SKIP        (UINT32_MAX)
+
+static inline uint32_t *_hdr(const spscq_t *q, unsigned pos)
+{
+    return (uint32_t *)&q->buf[pos & (q->size - 1)];
+}
+
+void spscq_init(spscq_t *q, void *buf, unsigned size, thread_flags_t flag)
+{
+    /* power of 2, at least one header and 4 byte aligned */
+    assert((size >= SPSCQ_HDR_SIZE) && !(size & (size - 1)));
+    assert(!((uintptr_t)buf & 3));
+
+    q->buf = buf;
+    q->size = size;
+    atomic_init(&q->reads, 0);
+    atomic_init(&q->writes, 0);
+    q->reserved_len = 0;
+    atomic_init(&q->waiter, 0);
+    q->flag = flag;
+}
+
+void *spscq_reserve(spscq_t *q, size_t len)
+{
+    unsigned writes = atomic_load_explicit(&q->writes, memory_order_relaxed);
+    unsigned reads = atomic_load_explicit(&q->reads, memory_order_acquire);
+    unsigned free = q->size - (writes - reads);
+    unsigned tail = q->size - (writes & (q->size - 1));
+    unsigned need = SPSCQ_RECORD_SIZE(len);
+
+    if ((len > q->size) || (need > q->size)) {
+        return NULL;
+    }
+    if (need > tail) {
+        /* doesn't fit in before the end, skip the rest of the buffer. The
+         * skip marker only becomes visible with the record */
+        if (need + tail > free) {
+            return NULL;
+        }
+        *_hdr(q, writes) = SKIP;
+        writes += tail;
+    }
+    else if (need > free) {
+        return NULL;
+    }
+
+    q->reserved = writes;
+    q->reserved_len = len;
+    return _hdr(q, writes) + 1;
+}
+
+static void _wake(spscq_t *q)
+{
+    thread_t *waiter = (thread_t *)atomic_load(&q->waiter);
+
+    if (waiter) {
+        thread_flags_set(waiter, q->flag);
+    }
+}
+
+void spscq_commit(spscq_t *q, size_t len)
+{
+    assert(len <= q->reserved_len);
+
+    *_hdr(q, q->reserved) = len;
+    /* the release makes the record and a skip marker before it visible */
+    atomic_store_explicit(&q->writes, q->reserved + SPSCQ_RECORD_SIZE(len),
+                          memory_order_release);
+    q->reserved_len = 0;
+    _wake(q);
+}
+
+int spscq_put(spscq_t *q, const void *data, size_t len)
+{
+    void *rec = spscq_reserve(q, len);
+
+    if (rec == NULL) {
+        return -ENOBUFS;
+    }
+    memcpy(rec, data, len);
+    spscq_commit(q, len);
+    return 0;
+}
+
+/* position of the oldest record, after a skip marker */
+static int _oldest(spscq_t *q, unsigned *pos)
+{
+    unsigned reads = atomic_load_explicit(&q->reads, memory_order_relaxed);
+    unsigned writes = atomic_load_explicit(&q->writes, memory_order_acquire);
+
+    if (reads == writes) {
+        return -EAGAIN;
+    }
+    if (*_hdr(q, reads) == SKIP) {
+        reads += q->size - (reads & (q->size - 1));
+    }
+    *pos = reads;
+    return 0;
+}
+
+void *spscq_peek(spscq_t *q, size_t *len)
+{
+    unsigned pos;
+
+    if (_oldest(q, &pos) < 0) {
+        return NULL;
+    }
+    *len = *_hdr(q, pos);
+    return _hdr(q, pos) + 1;
+}
+
+void spscq_release(spscq_t *q)
+{
+    unsigned pos;
+    int res = _oldest(q, &pos);
+
+    assert(res == 0);
+    (void)res;
+    /* the release hands the space back to the producer after we are done
+     * reading it */
+    atomic_store_explicit(&q->reads,
+                          pos + SPSCQ_RECORD_SIZE(*_hdr(q, pos)),
+                          memory_order_release);
+}
+
+ssize_t spscq_get(spscq_t *q, void *buf, size_t max_len)
+{
+    size_t len;
+    void *rec = spscq_peek(q, &len);
+
+    if (rec == NULL) {
+        return -EAGAIN;
+    }
+    if (len > max_len) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, rec, len);
+    spscq_release(q);
+    return len;
+}
+
+void *spscq_peek_blocking(spscq_t *q, size_t *len)
+{
+    void *rec;
+
+    /* register before looking, so a record committed in between sets the
+     * flag and the wait returns right away */
+    atomic_store(&q->waiter, (uintptr_t)sched_active_thread);
+    while ((rec = spscq_peek(q, len)) == NULL) {
+        thread_flags_wait_any(q->flag);
+    }
+    atomic_store(&q->waiter, 0);
+    return rec;
+}
+
+ssize_t spscq_get_blocking(spscq_t *q, void *buf, size_t max_len)
+{
+    size_t len;
+    void *rec = spscq_peek_blocking(q, &len);
+
+    if (len > max_len) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, rec, len);
+    spscq_release(q);
+    return len;
+}
+
+int spscq_empty(spscq_t *q)
+{
+    return atomic_load_explicit(&q->reads, memory_order_relaxed) ==
+           atomic_load_explicit(&q->writes, memory_order_relaxed);
+}
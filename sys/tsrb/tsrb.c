@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
 static void _push(tsrb_t *rb, uint8_t c)
@@ -41,22 +43,42 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, uint8_t *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    unsigned reads = rb->reads;
+    unsigned pos = reads & (rb->size - 1);
+    size_t avail = rb->writes - reads;
+    size_t first;
+
+    if (n > avail) {
+        n = avail;
+    }
+    if (n == 1) {
+        /* not worth a call to memcpy() */
+        *dst = rb->buf[pos];
     }
-    return (n - tmp);
+    else {
+        /* copy up to the end of the buffer, then the wrapped around rest */
+        first = rb->size - pos;
+        if (first > n) {
+            first = n;
+        }
+        memcpy(dst, &rb->buf[pos], first);
+        if (n > first) {
+            memcpy(dst + first, rb->buf, n - first);
+        }
+    }
+    rb->reads = reads + n;
+    return n;
 }
 
 int tsrb_drop(tsrb_t *rb, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        _pop(rb);
-        tmp--;
+    size_t avail = tsrb_avail(rb);
+
+    if (n > avail) {
+        n = avail;
     }
-    return (n - tmp);
+    rb->reads += n;
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, uint8_t c)
@@ -72,10 +94,54 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c)
 
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    unsigned writes = rb->writes;
+    unsigned pos = writes & (rb->size - 1);
+    size_t space = rb->size - (writes - rb->reads);
+    size_t first;
+
+    if (n > space) {
+        n = space;
+    }
+    if (n == 1) {
+        rb->buf[pos] = *src;
     }
-    return (n - tmp);
+    else {
+        first = rb->size - pos;
+        if (first > n) {
+            first = n;
+        }
+        memcpy(&rb->buf[pos], src, first);
+        if (n > first) {
+            memcpy(rb->buf, src + first, n - first);
+        }
+    }
+    /* only publish the data once it is in the buffer */
+    rb->writes = writes + n;
+    return n;
+}
+
+unsigned tsrb_get_contig(const tsrb_t *rb, uint8_t **data)
+{
+    unsigned reads = rb->reads;
+    unsigned pos = reads & (rb->size - 1);
+    unsigned avail = rb->writes - reads;
+
+    *data = &rb->buf[pos];
+    return (avail < (rb->size - pos)) ? avail : (rb->size - pos);
+}
+
+unsigned tsrb_add_contig(const tsrb_t *rb, uint8_t **data)
+{
+    unsigned writes = rb->writes;
+    unsigned pos = writes & (rb->size - 1);
+    unsigned space = rb->size - (writes - rb->reads);
+
+    *data = &rb->buf[pos];
+    return (space < (rb->size - pos)) ? space : (rb->size - pos);
+}
+
+void tsrb_add_commit(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_free(rb));
+    rb->writes += n;
 }
@@ -26,6 +26,9 @@
 #include "vfs.h"
 #include "mutex.h"
 #include "thread.h"
+#ifdef MODULE_VFS_POLL
+#include "thread_flags.h"
+#endif
 #include "kernel_types.h"
 #include "clist.h"
 
@@ -131,6 +134,20 @@ static inline int _fd_is_valid(int fd);
 
 static mutex_t _mount_mutex = MUTEX_INIT;
 static mutex_t _open_mutex = MUTEX_INIT;
+#ifdef MODULE_VFS_POLL
+/* protects the poll_waiters lists of all open files */
+static mutex_t _poll_mutex = MUTEX_INIT;
+
+/**
+ * @internal
+ * @brief Set @ref THREAD_FLAG_VFS_POLL on all threads waiting on @p filp
+ *
+ * Must be called with _poll_mutex locked.
+ *
+ * @param[in]  filp     pointer to open file
+ */
+static void _poll_wake(vfs_file_t *filp);
+#endif
 
 int vfs_close(int fd)
 {
@@ -145,7 +162,17 @@ int vfs_close(int fd)
          * system driver close() call below */
         res = filp->f_op->close(filp);
     }
+#ifdef MODULE_VFS_POLL
+    /* invalidate the fd before waking up the waiting threads, so they find
+     * out the file was closed (POLLNVAL) */
+    mutex_lock(&_poll_mutex);
+    _free_fd(fd);
+    _poll_wake(filp);
+    filp->poll_waiters = NULL;
+    mutex_unlock(&_poll_mutex);
+#else
     _free_fd(fd);
+#endif
     return res;
 }
 
@@ -777,6 +804,90 @@ int vfs_bind(int fd, int flags, const vfs_file_ops_t *f_op, void *private_data)
     return fd;
 }
 
+#ifdef MODULE_VFS_POLL
+int vfs_poll_ready(int fd)
+{
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (filp->f_op->poll != NULL) {
+        return filp->f_op->poll(filp);
+    }
+    /* driver does not implement poll(), so it never blocks */
+    switch (filp->flags & O_ACCMODE) {
+        case O_RDONLY:
+            return VFS_POLLIN;
+        case O_WRONLY:
+            return VFS_POLLOUT;
+        default:
+            return VFS_POLLIN | VFS_POLLOUT;
+    }
+}
+
+int vfs_poll_add(int fd, vfs_poll_waiter_t *waiter)
+{
+    DEBUG("vfs_poll_add: %d, %p\n", fd, (void *)waiter);
+    waiter->pid = thread_getpid();
+    /* check under the lock, so vfs_close() can't drop the waiters in
+     * between and leave this one linked to a closed file */
+    mutex_lock(&_poll_mutex);
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        mutex_unlock(&_poll_mutex);
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    waiter->next = filp->poll_waiters;
+    filp->poll_waiters = waiter;
+    mutex_unlock(&_poll_mutex);
+    return 0;
+}
+
+void vfs_poll_del(int fd, vfs_poll_waiter_t *waiter)
+{
+    DEBUG("vfs_poll_del: %d, %p\n", fd, (void *)waiter);
+    /* check under the lock, vfs_close() might still be walking the waiters */
+    mutex_lock(&_poll_mutex);
+    if (_fd_is_valid(fd) < 0) {
+        /* waiters are dropped when the file is closed */
+        mutex_unlock(&_poll_mutex);
+        return;
+    }
+    for (vfs_poll_waiter_t **ptr = &_vfs_open_files[fd].poll_waiters;
+         *ptr != NULL; ptr = &(*ptr)->next) {
+        if (*ptr == waiter) {
+            *ptr = waiter->next;
+            break;
+        }
+    }
+    mutex_unlock(&_poll_mutex);
+}
+
+void vfs_poll_notify(int fd)
+{
+    if ((fd < 0) || (fd >= VFS_MAX_OPEN_FILES)) {
+        return;
+    }
+    mutex_lock(&_poll_mutex);
+    _poll_wake(&_vfs_open_files[fd]);
+    mutex_unlock(&_poll_mutex);
+}
+
+static void _poll_wake(vfs_file_t *filp)
+{
+    for (vfs_poll_waiter_t *waiter = filp->poll_waiters;
+         waiter != NULL; waiter = waiter->next) {
+        thread_t *thread = (thread_t *)thread_get(waiter->pid);
+
+        if (thread != NULL) {
+            thread_flags_set(thread, THREAD_FLAG_VFS_POLL);
+        }
+    }
+}
+#endif /* MODULE_VFS_POLL */
+
 int vfs_normalize_path(char *buf, const char *path, size_t buflen)
 {
     DEBUG("vfs_normalize_path: %p, \"%s\" (%p), %lu\n",
@@ -919,6 +1030,9 @@ static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *moun
     filp->flags = flags;
     filp->pos = 0;
     filp->private_data.ptr = private_data;
+#ifdef MODULE_VFS_POLL
+    filp->poll_waiters = NULL;
+#endif
     return fd;
 }
 
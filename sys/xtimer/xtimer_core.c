@@ -28,6 +28,9 @@
 
 #include "xtimer.h"
 #include "irq.h"
+#ifdef MODULE_XTIMER_WHEEL
+#include "bitarithm.h"
+#endif
 
 /* WARNING! enabling this will have side effects and can lead to timer underflows. */
 #define ENABLE_DEBUG 0
@@ -42,12 +45,39 @@ volatile uint32_t _xtimer_high_cnt = 0;
 
 static inline void xtimer_spin_until(uint32_t value);
 
+#ifdef MODULE_XTIMER_WHEEL
+#if (XTIMER_WHEEL_LEVELS < 1) || (XTIMER_WHEEL_LEVELS > 15)
+#error "XTIMER_WHEEL_LEVELS must be between 1 and 15"
+#endif
+
+#define WHEEL_BITS      (4U)
+#define WHEEL_SLOTS     (1U << WHEEL_BITS)
+#define WHEEL_SPAN      (WHEEL_BITS * XTIMER_WHEEL_LEVELS)
+#define WHEEL_FAR       (0xff)
+#define WHEEL_NONE      (UINT64_MAX)
+
+/* slot lists, level by level */
+static xtimer_t *_wheel[XTIMER_WHEEL_LEVELS * WHEEL_SLOTS];
+/* one bit per non-empty slot */
+static uint16_t _wheel_used[XTIMER_WHEEL_LEVELS];
+/* timers beyond the range of the wheel */
+static xtimer_t *_wheel_far = NULL;
+/* time the wheel positions are relative to */
+static uint64_t _wheel_now = 0;
+/* wheel event the low-level timer was last set for */
+static uint64_t _wheel_armed = WHEEL_NONE;
+/* the low-level timer is set to the end of the current period */
+static int _wheel_overflow = 1;
+
+static void _wheel_add(xtimer_t *timer);
+#else
 static xtimer_t *timer_list_head = NULL;
 static xtimer_t *overflow_list_head = NULL;
 static xtimer_t *long_list_head = NULL;
 
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
+#endif
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
@@ -126,7 +156,11 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
             timer->long_target++;
         }
 
+#ifdef MODULE_XTIMER_WHEEL
+        _wheel_add(timer);
+#else
         _add_timer_to_long_list(&long_list_head, timer);
+#endif
         irq_restore(state);
         DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
               timer->long_target, timer->target);
@@ -180,7 +214,9 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     uint32_t now = _xtimer_now();
     int res = 0;
 
+#ifndef MODULE_XTIMER_WHEEL
     timer->next = NULL;
+#endif
 
     /* Ensure that offset is bigger than 'XTIMER_BACKOFF',
      * 'target - now' will allways be the offset no matter if target < or > now.
@@ -227,6 +263,9 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
         timer->long_target++;
     }
 
+#ifdef MODULE_XTIMER_WHEEL
+    _wheel_add(timer);
+#else
     if ((timer->long_target > _long_cnt) || !_this_high_period(target)) {
         DEBUG("xtimer_set_absolute(): the timer doesn't fit into the low-level timer's mask.\n");
         _add_timer_to_long_list(&long_list_head, timer);
@@ -246,12 +285,228 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
             }
         }
     }
+#endif
 
     irq_restore(state);
 
     return res;
 }
 
+#ifdef MODULE_XTIMER_WHEEL
+/**
+ * @brief   start of the current low-level timer period as 64bit time
+ */
+static inline uint64_t _wheel_base(void)
+{
+#if XTIMER_MASK
+    return ((uint64_t)_long_cnt << 32) | _xtimer_high_cnt;
+#else
+    return (uint64_t)_long_cnt << 32;
+#endif
+}
+
+/**
+ * @brief   check if @p event lies in the current (or a past) period
+ */
+static inline int _wheel_in_period(uint64_t event)
+{
+    uint64_t base = _wheel_base();
+
+    return (event < base) ||
+           ((event - base) <= _xtimer_lltimer_mask(0xFFFFFFFF));
+}
+
+/**
+ * @brief   time the timer callback has to run for @p timer
+ */
+static inline uint64_t _wheel_key(const xtimer_t *timer)
+{
+    return ((((uint64_t)timer->long_target) << 32) | timer->target) -
+           XTIMER_OVERHEAD;
+}
+
+static void _wheel_insert(xtimer_t *timer)
+{
+    xtimer_t **head;
+    uint64_t key = _wheel_key(timer);
+
+    if (key < _wheel_now) {
+        key = _wheel_now;
+    }
+
+    /* the level is given by the highest bit key and _wheel_now differ in */
+    uint64_t diff = key ^ _wheel_now;
+
+    if (diff >> WHEEL_SPAN) {
+        timer->wheel_slot = WHEEL_FAR;
+        head = &_wheel_far;
+    }
+    else {
+        unsigned level = 0;
+
+        while ((diff >>= WHEEL_BITS)) {
+            level++;
+        }
+
+        unsigned idx = (key >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+
+        timer->wheel_slot = level * WHEEL_SLOTS + idx;
+        _wheel_used[level] |= (1U << idx);
+        head = &_wheel[timer->wheel_slot];
+    }
+
+    timer->prev = NULL;
+    timer->next = *head;
+    if (*head) {
+        (*head)->prev = timer;
+    }
+    *head = timer;
+}
+
+static void _wheel_unlink(xtimer_t *timer)
+{
+    xtimer_t **head = (timer->wheel_slot == WHEEL_FAR) ?
+                      &_wheel_far : &_wheel[timer->wheel_slot];
+
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    }
+    else {
+        *head = timer->next;
+    }
+    if (timer->next) {
+        timer->next->prev = timer->prev;
+    }
+
+    if (!*head && (timer->wheel_slot != WHEEL_FAR)) {
+        _wheel_used[timer->wheel_slot / WHEEL_SLOTS] &=
+            ~(1U << (timer->wheel_slot % WHEEL_SLOTS));
+    }
+}
+
+/**
+ * @brief   get the next wheel event
+ *
+ * This is either the target of the earliest timers, or the time a slot of a
+ * coarser level has to be spread over the finer levels.
+ */
+static uint64_t _wheel_next(void)
+{
+    for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+        if (_wheel_used[level]) {
+            unsigned shift = level * WHEEL_BITS;
+            uint64_t idx = bitarithm_lsb(_wheel_used[level]);
+
+            return ((_wheel_now >> (shift + WHEEL_BITS)) << (shift + WHEEL_BITS))
+                   | (idx << shift);
+        }
+    }
+
+    if (_wheel_far) {
+        return ((_wheel_now >> WHEEL_SPAN) + 1) << WHEEL_SPAN;
+    }
+
+    return WHEEL_NONE;
+}
+
+/**
+ * @brief   advance the wheel to the event @p event
+ *
+ * @return  a timer that expires at @p event, or NULL if there is none
+ */
+static xtimer_t *_wheel_advance(uint64_t event)
+{
+    xtimer_t *list = NULL;
+
+    if ((event >> WHEEL_SPAN) != (_wheel_now >> WHEEL_SPAN)) {
+        list = _wheel_far;
+        _wheel_far = NULL;
+    }
+    _wheel_now = event;
+
+    /* timers further away may now fit into the wheel */
+    while (list) {
+        xtimer_t *next = list->next;
+        _wheel_insert(list);
+        list = next;
+    }
+
+    /* cascade the slots @p event reached down to the finer levels */
+    for (unsigned level = XTIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+        unsigned idx = (event >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+
+        if (_wheel_used[level] & (1U << idx)) {
+            list = _wheel[level * WHEEL_SLOTS + idx];
+            _wheel[level * WHEEL_SLOTS + idx] = NULL;
+            _wheel_used[level] &= ~(1U << idx);
+            while (list) {
+                xtimer_t *next = list->next;
+                _wheel_insert(list);
+                list = next;
+            }
+        }
+    }
+
+    xtimer_t *timer = _wheel[event & (WHEEL_SLOTS - 1)];
+    if (timer) {
+        _wheel_unlink(timer);
+    }
+    return timer;
+}
+
+/**
+ * @brief   set the low-level timer for the next wheel event
+ */
+static void _wheel_arm(void)
+{
+    if (_in_handler) {
+        return;
+    }
+
+    uint64_t soon = (((uint64_t)_long_cnt << 32) | _xtimer_now()) + XTIMER_BACKOFF;
+    uint64_t next = _wheel_next();
+
+    _wheel_armed = next;
+    /* events may lie in the past if the wheel was idle for a while */
+    if (next < soon) {
+        next = soon;
+    }
+    if (_wheel_in_period(next)) {
+        _wheel_overflow = 0;
+        _lltimer_set((uint32_t)next);
+    }
+    else {
+        _wheel_overflow = 1;
+        _lltimer_set(0xFFFFFFFF);
+    }
+}
+
+static void _wheel_add(xtimer_t *timer)
+{
+    if (_wheel_next() == WHEEL_NONE) {
+        /* wheel is empty, move it to the current time */
+        uint32_t short_term, long_term;
+        _xtimer_now_internal(&short_term, &long_term);
+        _wheel_now = ((uint64_t)long_term << 32) | short_term;
+    }
+
+    _wheel_insert(timer);
+    if (_wheel_next() != _wheel_armed) {
+        _wheel_arm();
+    }
+}
+
+static void _remove(xtimer_t *timer)
+{
+    _wheel_unlink(timer);
+    /* unlinking twice would corrupt the wheel, so mark it as not set */
+    timer->target = 0;
+    timer->long_target = 0;
+    if (_wheel_next() != _wheel_armed) {
+        _wheel_arm();
+    }
+}
+#else /* MODULE_XTIMER_WHEEL */
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head && (*list_head)->target <= timer->target) {
@@ -309,6 +564,7 @@ static void _remove(xtimer_t *timer)
         }
     }
 }
+#endif /* MODULE_XTIMER_WHEEL */
 
 void xtimer_remove(xtimer_t *timer)
 {
@@ -346,6 +602,7 @@ static inline int _this_high_period(uint32_t target)
 #endif
 }
 
+#ifndef MODULE_XTIMER_WHEEL
 /**
  * @brief compare two timers' target values, return the one with lower value.
  *
@@ -435,6 +692,7 @@ static void _select_long_timers(void)
         }
     }
 }
+#endif /* MODULE_XTIMER_WHEEL */
 
 /**
  * @brief handle low-level timer overflow, advance to next short timer period
@@ -453,12 +711,141 @@ static void _next_period(void)
     _long_cnt++;
 #endif
 
+#ifndef MODULE_XTIMER_WHEEL
     /* swap overflow list to current timer list */
     timer_list_head = overflow_list_head;
     overflow_list_head = NULL;
 
     _select_long_timers();
+#endif
+}
+
+#ifdef MODULE_XTIMER_WHEEL
+/**
+ * @brief   check if the wheel event @p event has to be handled now
+ */
+static int _wheel_due(uint64_t event, uint32_t reference)
+{
+    uint64_t base = _wheel_base();
+
+    if (event < base) {
+        return 1;
+    }
+    if ((event - base) > _xtimer_lltimer_mask(0xFFFFFFFF)) {
+        return 0;
+    }
+    return _time_left(_xtimer_lltimer_mask((uint32_t)event), reference) <
+           XTIMER_ISR_BACKOFF;
+}
+
+/**
+ * @brief main xtimer callback function, timer wheel version
+ */
+static void _timer_callback(void)
+{
+    uint32_t next_target;
+    uint32_t reference;
+    uint64_t next;
+
+    _in_handler = 1;
+
+    if (_wheel_overflow) {
+        DEBUG("_timer_callback(): tick\n");
+        /* the low-level timer was set to the end of the timer period,
+         * advance to the next timer period. */
+        _next_period();
+
+        reference = 0;
+
+        /* make sure the timer counter also arrived
+         * in the next timer period */
+        while (_xtimer_lltimer_now() == _xtimer_lltimer_mask(0xFFFFFFFF)) {}
+    }
+    else {
+        /* set our period reference to the current time. */
+        reference = _xtimer_lltimer_now();
+    }
+
+overflow:
+    /* handle all wheel events that are close */
+    while (((next = _wheel_next()) != WHEEL_NONE) && _wheel_due(next, reference)) {
+        xtimer_t *timer = _wheel_advance(next);
+
+        if (!timer) {
+            /* timers were only moved to a finer level */
+            continue;
+        }
+
+        /* make sure we don't fire too early, unless the timer is from a
+         * past period already */
+        if (_wheel_key(timer) >= _wheel_base()) {
+            while (_time_left(_xtimer_lltimer_mask(timer->target), reference)) {}
+        }
+
+        /* make sure timer is recognized as being already fired */
+        timer->target = 0;
+        timer->long_target = 0;
+
+        /* fire timer */
+        _shoot(timer);
+    }
+
+    /* possibly executing all callbacks took enough
+     * time to overflow.  In that case we advance to
+     * next timer period and check again for expired
+     * timers.*/
+    uint32_t now = _xtimer_lltimer_now() + XTIMER_ISR_BACKOFF;
+    if (now < reference) {
+        DEBUG("_timer_callback: overflowed while executing callbacks.\n");
+        _next_period();
+        /* wait till overflow */
+        while (reference < _xtimer_lltimer_now()) {}
+        reference = 0;
+        goto overflow;
+    }
+
+    if (_wheel_in_period(next)) {
+        /* schedule callback on next wheel event */
+        next_target = (uint32_t)next;
+
+        /* make sure we're not setting a time in the past */
+        if (next_target < (_xtimer_now() + XTIMER_ISR_BACKOFF)) {
+            goto overflow;
+        }
+        _wheel_overflow = 0;
+    }
+    else {
+        /* there's no event planned for this timer period */
+        /* schedule callback on next overflow */
+        next_target = _xtimer_lltimer_mask(0xFFFFFFFF);
+        uint32_t now = _xtimer_lltimer_now();
+
+        /* check for overflow again */
+        if (now < reference) {
+            _next_period();
+            reference = 0;
+            goto overflow;
+        }
+        else {
+            /* check if the end of this period is very soon */
+            if (_xtimer_lltimer_mask(now + XTIMER_ISR_BACKOFF) < now) {
+                /* spin until next period, then advance */
+                while (_xtimer_lltimer_now() >= now) {}
+                _next_period();
+                reference = 0;
+                goto overflow;
+            }
+        }
+        _wheel_overflow = 1;
+    }
+
+    _wheel_armed = next;
+    _in_handler = 0;
+
+    /* set low level timer */
+    _lltimer_set(next_target);
 }
+#else /* MODULE_XTIMER_WHEEL */
 
 /**
  * @brief main xtimer callback function
@@ -571,3 +958,4 @@ overflow:
     /* set low level timer */
     _lltimer_set(next_target);
 }
+#endif /* MODULE_XTIMER_WHEEL */
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the frames per second dispatched by the CAN router,
+ *              fed by the test script through the native SocketCAN backend
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "can/can.h"
+#include "can/common.h"
+#include "can/raw.h"
+#include "can/router.h"
+#include "kernel_defines.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_IFNUM          (0)
+#define TEST_MSG_QUEUE_SIZE (64U)
+
+/* the test script sends data frames with the IDs 0 to TEST_ID_SPAN - 1 */
+#define TEST_ID_SPAN        (0x300U)
+#define TEST_ID_START       (0x7feU)
+#define TEST_ID_END         (0x7ffU)
+#define TEST_ID_SYNC        (0x7fdU)
+#define TEST_ID_ACK         (0x7fcU)
+
+/* the even IDs from 0x100 to 0x15e */
+#define TEST_EXACT_FILTERS  (48U)
+#define TEST_EXACT_BASE     (0x100U)
+/* 4 ranges of 16 IDs from 0x200 to 0x2cf */
+#define TEST_MASK_FILTERS   (4U)
+#define TEST_MASK_BASE      (0x200U)
+#define TEST_MASK           (0x7f0U)
+
+/* plus the start, end and sync filters */
+#define TEST_FILTERS        (TEST_EXACT_FILTERS + TEST_MASK_FILTERS + 3)
+
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static struct can_filter _filters[TEST_FILTERS];
+
+static unsigned _init_filters(void)
+{
+    const canid_t control[] = { TEST_ID_START, TEST_ID_END, TEST_ID_SYNC };
+    unsigned num = 0;
+
+    for (unsigned i = 0; i < TEST_EXACT_FILTERS; i++, num++) {
+        _filters[num].can_id = TEST_EXACT_BASE + (2 * i);
+        _filters[num].can_mask = 0xffffffff;
+    }
+    for (unsigned i = 0; i < TEST_MASK_FILTERS; i++, num++) {
+        _filters[num].can_id = TEST_MASK_BASE + (0x40 * i);
+        _filters[num].can_mask = TEST_MASK;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(control); i++, num++) {
+        _filters[num].can_id = control[i];
+        _filters[num].can_mask = 0xffffffff;
+    }
+    return num;
+}
+
+static int _register_filters(unsigned num)
+{
+    can_reg_entry_t entry = { .ifnum = TEST_IFNUM };
+
+    entry.target.pid = thread_getpid();
+#ifdef MODULE_CAN_MBOX
+    entry.type = CAN_TYPE_DEFAULT;
+#endif
+    /* straight to the router, the 16 filters of the SocketCAN backend would
+     * not be enough and filter the frames before they reach the router */
+    for (unsigned i = 0; i < num; i++) {
+        if (can_router_register(&entry, _filters[i].can_id,
+                                _filters[i].can_mask, NULL) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* number of filters frame i of the test script is delivered to */
+static unsigned _expected(uint32_t frames, unsigned filters)
+{
+    unsigned res = 0;
+
+    for (uint32_t i = 0; i < frames; i++) {
+        canid_t can_id = i % TEST_ID_SPAN;
+
+        for (unsigned f = 0; f < filters; f++) {
+            if ((can_id & _filters[f].can_mask) == _filters[f].can_id) {
+                res++;
+            }
+        }
+    }
+    return res;
+}
+
+static void _ack(void)
+{
+    struct can_frame frame = { .can_id = TEST_ID_ACK };
+
+    if (raw_can_send(TEST_IFNUM, &frame, KERNEL_PID_UNDEF) < 0) {
+        puts("unable to acknowledge burst");
+    }
+}
+
+int main(void)
+{
+    unsigned filters = _init_filters();
+    unsigned deliveries = 0;
+    uint32_t start = 0, duration = 0, frames = 0;
+    bool done = false;
+
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    if (_register_filters(filters) < 0) {
+        puts("[FAILED] unable to register filters");
+        return 1;
+    }
+    puts("ready");
+
+    while (!done) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type != CAN_MSG_RX_INDICATION) {
+            continue;
+        }
+        can_rx_data_t *rx = msg.content.ptr;
+        struct can_frame *frame = rx->data.iov_base;
+
+        switch (frame->can_id) {
+        case TEST_ID_START:
+            start = xtimer_now_usec();
+            deliveries = 0;
+            break;
+        case TEST_ID_SYNC:
+            _ack();
+            break;
+        case TEST_ID_END:
+            duration = xtimer_now_usec() - start;
+            memcpy(&frames, frame->data, sizeof(frames));
+            done = true;
+            break;
+        default:
+            deliveries++;
+            break;
+        }
+        raw_can_free_frame(rx);
+    }
+
+    unsigned expected = _expected(frames, TEST_EXACT_FILTERS +
+                                          TEST_MASK_FILTERS);
+
+    printf("frames: %" PRIu32 ", filters: %u, deliveries: %u/%u, "
+           "time: %" PRIu32 " us, frames/s: %" PRIu32 "\n", frames, filters,
+           deliveries, expected, duration,
+           (uint32_t)(((uint64_t)frames * US_PER_SEC) / (duration ? duration : 1)));
+    if (deliveries != expected) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
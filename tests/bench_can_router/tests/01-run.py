@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import socket
+import struct
+import sys
+from testrunner import run
+
+IFACE = "vcan0"
+FRAMES = 20000
+BURST = 32
+
+# must match main.c
+ID_SPAN = 0x300
+ID_START = 0x7fe
+ID_END = 0x7ff
+ID_SYNC = 0x7fd
+ID_ACK = 0x7fc
+
+FRAME_FMT = "=IB3x8s"
+
+
+def send(sock, can_id, data=b""):
+    sock.send(struct.pack(FRAME_FMT, can_id, len(data), data))
+
+
+def wait_ack(sock):
+    while True:
+        can_id, _, _ = struct.unpack(FRAME_FMT, sock.recv(16))
+        if can_id == ID_ACK:
+            return
+
+
+def testfunc(child):
+    sock = socket.socket(socket.PF_CAN, socket.SOCK_RAW, socket.CAN_RAW)
+    sock.bind((IFACE,))
+    sock.settimeout(5)
+    child.expect_exact("ready")
+
+    send(sock, ID_START)
+    for i in range(FRAMES):
+        send(sock, i % ID_SPAN, struct.pack("<I", i))
+        if (i % BURST) == (BURST - 1):
+            send(sock, ID_SYNC)
+            wait_ack(sock)
+    send(sock, ID_END, struct.pack("<I", FRAMES))
+
+    child.expect(r"frames: {}, filters: \d+, deliveries: (\d+)/(\d+), "
+                 r"time: \d+ us, frames/s: \d+".format(FRAMES))
+    assert child.match.group(1) == child.match.group(2)
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
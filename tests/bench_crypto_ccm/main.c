@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures how many IEEE 802.15.4 sized frames AES-CCM can
+ *              secure per second
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "kernel_defines.h"
+#include "byteorder.h"
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/ccm.h"
+#include "xtimer.h"
+
+#ifndef TEST_FRAMES
+#define TEST_FRAMES         (1000U)
+#endif
+
+/* CCM* as used by IEEE 802.15.4 security level 6 (ENC-MIC-64) */
+#define TEST_MIC_LEN        (8U)
+#define TEST_LEN_ENCODING   (2U)
+/* nonce: source address, frame counter, security level */
+#define TEST_ADDR_LEN       (8U)
+#define TEST_NONCE_LEN      (TEST_ADDR_LEN + 4U + 1U)
+/* MAC header and auxiliary security header are authenticated */
+#define TEST_HDR_LEN        (23U)
+#define TEST_PAYLOAD_MAX    (102U)
+
+static const uint8_t _key[AES_KEY_SIZE] = {
+    0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7,
+    0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF,
+};
+static const uint8_t _addr[TEST_ADDR_LEN] = {
+    0xAC, 0xDE, 0x48, 0x00, 0x00, 0x00, 0x00, 0x01,
+};
+
+static cipher_t _cipher;
+static ccm_ctx_t _ctx;
+static uint8_t _hdr[TEST_HDR_LEN];
+static uint8_t _plain[TEST_PAYLOAD_MAX];
+static uint8_t _frame[TEST_PAYLOAD_MAX + TEST_MIC_LEN];
+static uint8_t _decrypted[TEST_PAYLOAD_MAX];
+
+typedef struct {
+    const char *name;
+    int (*encrypt)(uint32_t counter, size_t len);
+    int (*decrypt)(uint32_t counter, size_t len);
+} bench_api_t;
+
+/* frame counter and security level, the part of the nonce that changes */
+static void _nonce_tail(uint8_t *tail, uint32_t counter)
+{
+    network_uint32_t ctr = byteorder_htonl(counter);
+
+    memcpy(tail, &ctr, sizeof(ctr));
+    tail[sizeof(ctr)] = 6;
+}
+
+static int _oneshot_enc(uint32_t counter, size_t len)
+{
+    uint8_t nonce[TEST_NONCE_LEN];
+
+    memcpy(nonce, _addr, TEST_ADDR_LEN);
+    _nonce_tail(&nonce[TEST_ADDR_LEN], counter);
+    return cipher_encrypt_ccm(&_cipher, _hdr, sizeof(_hdr), TEST_MIC_LEN,
+                              TEST_LEN_ENCODING, nonce, sizeof(nonce),
+                              _plain, len, _frame);
+}
+
+static int _oneshot_dec(uint32_t counter, size_t len)
+{
+    uint8_t nonce[TEST_NONCE_LEN];
+
+    memcpy(nonce, _addr, TEST_ADDR_LEN);
+    _nonce_tail(&nonce[TEST_ADDR_LEN], counter);
+    return cipher_decrypt_ccm(&_cipher, _hdr, sizeof(_hdr), TEST_MIC_LEN,
+                              TEST_LEN_ENCODING, nonce, sizeof(nonce),
+                              _frame, len + TEST_MIC_LEN, _decrypted);
+}
+
+static int _ctx_enc(uint32_t counter, size_t len)
+{
+    uint8_t tail[TEST_NONCE_LEN - TEST_ADDR_LEN];
+
+    _nonce_tail(tail, counter);
+    return ccm_ctx_encrypt(&_ctx, tail, sizeof(tail), _hdr, sizeof(_hdr),
+                           _plain, len, _frame);
+}
+
+static int _ctx_dec(uint32_t counter, size_t len)
+{
+    uint8_t tail[TEST_NONCE_LEN - TEST_ADDR_LEN];
+
+    _nonce_tail(tail, counter);
+    return ccm_ctx_decrypt(&_ctx, tail, sizeof(tail), _hdr, sizeof(_hdr),
+                           _frame, len + TEST_MIC_LEN, _decrypted);
+}
+
+static const bench_api_t _apis[] = {
+    { "oneshot", _oneshot_enc, _oneshot_dec },
+    { "ctx", _ctx_enc, _ctx_dec },
+};
+
+static uint32_t _frames_per_sec(uint32_t usec)
+{
+    if (usec == 0) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)TEST_FRAMES * US_PER_SEC) / usec);
+}
+
+/* every frame is encrypted and decrypted again with a fresh frame counter,
+ * returns the number of frames that did not make it through */
+static unsigned _bench(const bench_api_t *api, size_t len)
+{
+    uint32_t enc = 0, dec = 0;
+    unsigned errors = 0;
+
+    for (uint32_t i = 0; i < TEST_FRAMES; i++) {
+        uint32_t start = xtimer_now_usec();
+        int res = api->encrypt(i, len);
+        uint32_t mid = xtimer_now_usec();
+        res += api->decrypt(i, len);
+        uint32_t end = xtimer_now_usec();
+
+        enc += mid - start;
+        dec += end - mid;
+        if ((res != (int)(2 * len + TEST_MIC_LEN)) ||
+            memcmp(_plain, _decrypted, len)) {
+            errors++;
+        }
+    }
+
+    printf("len: %3u, %-7s enc: %6" PRIu32 " frames/s, "
+           "dec: %6" PRIu32 " frames/s\n", (unsigned)len, api->name,
+           _frames_per_sec(enc), _frames_per_sec(dec));
+
+    return errors;
+}
+
+int main(void)
+{
+    static const size_t lens[] = { 16, 64, TEST_PAYLOAD_MAX };
+    unsigned errors = 0;
+
+    printf("AES-128-CCM frame benchmark, %u frames per run\n", TEST_FRAMES);
+
+    for (unsigned i = 0; i < sizeof(_hdr); i++) {
+        _hdr[i] = (uint8_t)(0x40 + i);
+    }
+    for (unsigned i = 0; i < sizeof(_plain); i++) {
+        _plain[i] = (uint8_t)i;
+    }
+    if ((cipher_init(&_cipher, CIPHER_AES_128, _key, sizeof(_key)) !=
+         CIPHER_INIT_SUCCESS) ||
+        (ccm_ctx_init(&_ctx, &_cipher, TEST_MIC_LEN, TEST_LEN_ENCODING,
+                      _addr, sizeof(_addr)) < 0)) {
+        puts("initialization failed");
+        puts("[FAILED]");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        for (unsigned j = 0; j < ARRAY_SIZE(_apis); j++) {
+            errors += _bench(&_apis[j], lens[i]);
+        }
+    }
+
+    if (errors) {
+        printf("%u frames failed\n", errors);
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
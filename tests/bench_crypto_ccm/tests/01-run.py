@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for length in (16, 64, 102):
+        for api in ("oneshot", "ctx"):
+            child.expect(r"len:\s+{}, {}\s+enc:\s+\d+ frames/s, "
+                         r"dec:\s+\d+ frames/s".format(length, api))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
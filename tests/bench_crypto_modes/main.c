@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the AES-128 throughput of the block cipher modes
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "kernel_defines.h"
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ecb.h"
+#include "crypto/modes/ocb.h"
+#include "xtimer.h"
+
+#ifndef TEST_DATA_LEN
+#define TEST_DATA_LEN       (192U)
+#endif
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (200U)
+#endif
+
+#define TEST_TAG_LEN        (16U)
+#define TEST_NONCE_LEN      (12U)
+#define TEST_LEN_ENCODING   (2U)
+
+static const uint8_t _key[AES_KEY_SIZE] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const uint8_t _nonce[AES_BLOCK_SIZE] = {
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+    0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+static uint8_t _auth_data[] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+
+static cipher_t _cipher;
+static uint8_t _plain[TEST_DATA_LEN];
+static uint8_t _encrypted[TEST_DATA_LEN + TEST_TAG_LEN];
+static uint8_t _decrypted[TEST_DATA_LEN];
+/* modes that modify the IV or counter get a fresh copy each run */
+static uint8_t _iv[AES_BLOCK_SIZE];
+
+typedef struct {
+    const char *name;
+    int (*encrypt)(void);
+    int (*decrypt)(void);
+} bench_mode_t;
+
+static int _ecb_enc(void)
+{
+    return cipher_encrypt_ecb(&_cipher, _plain, TEST_DATA_LEN, _encrypted);
+}
+
+static int _ecb_dec(void)
+{
+    return cipher_decrypt_ecb(&_cipher, _encrypted, TEST_DATA_LEN, _decrypted);
+}
+
+static int _cbc_enc(void)
+{
+    memcpy(_iv, _nonce, sizeof(_iv));
+    return cipher_encrypt_cbc(&_cipher, _iv, _plain, TEST_DATA_LEN,
+                              _encrypted);
+}
+
+static int _cbc_dec(void)
+{
+    memcpy(_iv, _nonce, sizeof(_iv));
+    return cipher_decrypt_cbc(&_cipher, _iv, _encrypted, TEST_DATA_LEN,
+                              _decrypted);
+}
+
+static int _ctr_enc(void)
+{
+    memcpy(_iv, _nonce, sizeof(_iv));
+    return cipher_encrypt_ctr(&_cipher, _iv, TEST_NONCE_LEN, _plain,
+                              TEST_DATA_LEN, _encrypted);
+}
+
+static int _ctr_dec(void)
+{
+    memcpy(_iv, _nonce, sizeof(_iv));
+    return cipher_decrypt_ctr(&_cipher, _iv, TEST_NONCE_LEN, _encrypted,
+                              TEST_DATA_LEN, _decrypted);
+}
+
+static int _ccm_enc(void)
+{
+    int res = cipher_encrypt_ccm(&_cipher, _auth_data, sizeof(_auth_data),
+                                 TEST_TAG_LEN, TEST_LEN_ENCODING,
+                                 _nonce, 15 - TEST_LEN_ENCODING,
+                                 _plain, TEST_DATA_LEN, _encrypted);
+    return (res < 0) ? res : res - (int)TEST_TAG_LEN;
+}
+
+static int _ccm_dec(void)
+{
+    return cipher_decrypt_ccm(&_cipher, _auth_data, sizeof(_auth_data),
+                              TEST_TAG_LEN, TEST_LEN_ENCODING,
+                              _nonce, 15 - TEST_LEN_ENCODING,
+                              _encrypted, TEST_DATA_LEN + TEST_TAG_LEN,
+                              _decrypted);
+}
+
+static int _ocb_enc(void)
+{
+    int32_t res = cipher_encrypt_ocb(&_cipher, _auth_data, sizeof(_auth_data),
+                                     TEST_TAG_LEN, (uint8_t *)_nonce,
+                                     TEST_NONCE_LEN, _plain, TEST_DATA_LEN,
+                                     _encrypted);
+    return (res < 0) ? (int)res : (int)(res - TEST_TAG_LEN);
+}
+
+static int _ocb_dec(void)
+{
+    return cipher_decrypt_ocb(&_cipher, _auth_data, sizeof(_auth_data),
+                              TEST_TAG_LEN, (uint8_t *)_nonce, TEST_NONCE_LEN,
+                              _encrypted, TEST_DATA_LEN + TEST_TAG_LEN,
+                              _decrypted);
+}
+
+static const bench_mode_t _modes[] = {
+    { "ecb", _ecb_enc, _ecb_dec },
+    { "cbc", _cbc_enc, _cbc_dec },
+    { "ctr", _ctr_enc, _ctr_dec },
+    { "ccm", _ccm_enc, _ccm_dec },
+    { "ocb", _ocb_enc, _ocb_dec },
+};
+
+/* stores the average time of one run in usec, returns the number of
+ * failed runs */
+static unsigned _measure(int (*func)(void), uint32_t *usec)
+{
+    unsigned errors = 0;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        if (func() != (int)TEST_DATA_LEN) {
+            errors++;
+        }
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+    *usec = (duration + (TEST_ROUNDS / 2)) / TEST_ROUNDS;
+    return errors;
+}
+
+static uint32_t _kibps(uint32_t usec)
+{
+    if (usec == 0) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)TEST_DATA_LEN * US_PER_SEC) / 1024 / usec);
+}
+
+static unsigned _bench(const bench_mode_t *mode)
+{
+    uint32_t enc, dec;
+    unsigned errors;
+
+    memset(_decrypted, 0, sizeof(_decrypted));
+    errors = _measure(mode->encrypt, &enc);
+    errors += _measure(mode->decrypt, &dec);
+
+    printf("%s enc: %5" PRIu32 " us (%5" PRIu32 " KiB/s), "
+           "dec: %5" PRIu32 " us (%5" PRIu32 " KiB/s)\n",
+           mode->name, enc, _kibps(enc), dec, _kibps(dec));
+
+    if (errors || memcmp(_plain, _decrypted, TEST_DATA_LEN)) {
+        printf("%s failed\n", mode->name);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    unsigned errors = 0;
+
+    printf("AES-128 mode benchmark, %u bytes per run, %u runs\n",
+           TEST_DATA_LEN, TEST_ROUNDS);
+
+    for (unsigned i = 0; i < TEST_DATA_LEN; i++) {
+        _plain[i] = (uint8_t)i;
+    }
+    if (cipher_init(&_cipher, CIPHER_AES_128, _key, sizeof(_key)) !=
+        CIPHER_INIT_SUCCESS) {
+        puts("cipher_init failed");
+        puts("[FAILED]");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_modes); i++) {
+        errors += _bench(&_modes[i]);
+    }
+
+    if (errors) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
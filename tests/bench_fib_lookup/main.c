@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures FIB lookup cost for different table sizes
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/fib.h"
+#include "net/ipv6/addr.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define TEST_ROUTES_MIN     (16U)
+#define TEST_ROUTES_MAX     (1024U)
+/* universal_address_container_t::use_count wraps after 255 routes */
+#define TEST_NEXT_HOPS      (8U)
+
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (10000U)
+#endif
+
+/* lookups compared against a linear longest prefix match, not timed */
+#ifndef TEST_CHECKS
+#define TEST_CHECKS         (1000U)
+#endif
+
+static fib_entry_t _entries[TEST_ROUTES_MAX];
+static fib_table_t _table = {
+    .data.entries = _entries,
+    .table_type = FIB_TABLE_TYPE_SH,
+    .size = TEST_ROUTES_MAX,
+    .mtx_access = MUTEX_INIT,
+};
+static ipv6_addr_t _prefixes[TEST_ROUTES_MAX];
+static uint8_t _prefix_lens[TEST_ROUTES_MAX];
+
+static void _random_addr(ipv6_addr_t *addr, const ipv6_addr_t *prefix,
+                         unsigned prefix_len)
+{
+    random_bytes(addr->u8, sizeof(addr->u8));
+    ipv6_addr_init_prefix(addr, prefix, prefix_len);
+}
+
+static bool _is_duplicate(unsigned idx)
+{
+    for (unsigned i = 0; i < idx; i++) {
+        if (ipv6_addr_equal(&_prefixes[i], &_prefixes[idx])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _fill(unsigned routes)
+{
+    static const ipv6_addr_t doc_prefix = { .u8 = { 0x20, 0x01, 0x0d, 0xb8 } };
+
+    fib_init(&_table);
+    for (unsigned i = 0; i < routes; i++) {
+        unsigned prefix_len = random_uint32_range(40, 65);
+        ipv6_addr_t next_hop = { .u8 = { 0xfe, 0x80 } };
+        ipv6_addr_t tmp;
+
+        _random_addr(&tmp, &doc_prefix, 32);
+        /* keep the host part zero to get a clean prefix */
+        memset(&_prefixes[i], 0, sizeof(_prefixes[i]));
+        ipv6_addr_init_prefix(&_prefixes[i], &tmp, prefix_len);
+        _prefix_lens[i] = prefix_len;
+        /* the FIB would update the route of an equal address instead */
+        if (_is_duplicate(i)) {
+            i--;
+            continue;
+        }
+        next_hop.u8[15] = (i % TEST_NEXT_HOPS) + 1;
+
+        fib_add_entry(&_table, 1, _prefixes[i].u8, sizeof(ipv6_addr_t),
+                      prefix_len << FIB_FLAG_NET_PREFIX_SHIFT,
+                      next_hop.u8, sizeof(ipv6_addr_t), 0,
+                      (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+    }
+}
+
+/* checks @p next_hop against the longest of the routes covering @p dst */
+static bool _is_longest_match(unsigned routes, const ipv6_addr_t *dst,
+                              const ipv6_addr_t *next_hop)
+{
+    unsigned best = routes;
+
+    for (unsigned i = 0; i < routes; i++) {
+        if ((ipv6_addr_match_prefix(&_prefixes[i], dst) >= _prefix_lens[i]) &&
+            ((best == routes) || (_prefix_lens[i] > _prefix_lens[best]))) {
+            best = i;
+        }
+    }
+    return (best < routes) &&
+           (next_hop->u8[15] == ((best % TEST_NEXT_HOPS) + 1));
+}
+
+static unsigned _check(unsigned routes)
+{
+    unsigned errors = 0;
+
+    for (unsigned i = 0; i < TEST_CHECKS; i++) {
+        ipv6_addr_t dst;
+        ipv6_addr_t next_hop;
+        size_t next_hop_size = sizeof(next_hop);
+        uint32_t next_hop_flags;
+        kernel_pid_t iface;
+
+        _random_addr(&dst, &_prefixes[i % routes], 64);
+        if ((fib_get_next_hop(&_table, &iface, next_hop.u8, &next_hop_size,
+                              &next_hop_flags, dst.u8, sizeof(dst), 0) != 0) ||
+            !_is_longest_match(routes, &dst, &next_hop)) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+static bool _bench(unsigned routes)
+{
+    unsigned found = 0;
+    unsigned errors;
+    uint32_t start;
+
+    _fill(routes);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        ipv6_addr_t dst;
+        ipv6_addr_t next_hop;
+        size_t next_hop_size = sizeof(next_hop);
+        uint32_t next_hop_flags;
+        kernel_pid_t iface;
+
+        _random_addr(&dst, &_prefixes[i % routes], 64);
+        if (fib_get_next_hop(&_table, &iface, next_hop.u8, &next_hop_size,
+                             &next_hop_flags, dst.u8, sizeof(dst), 0) == 0) {
+            found++;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("routes: %4u, lookups: %u, found: %u, time: %" PRIu32
+           " us, per lookup: %" PRIu32 " ns\n", routes, TEST_LOOKUPS, found,
+           duration, (uint32_t)(((uint64_t)duration * 1000) / TEST_LOOKUPS));
+
+    /* every destination lies within one of the routes */
+    errors = _check(routes) + (TEST_LOOKUPS - found);
+    if (errors) {
+        printf("routes: %4u, wrong lookups: %u\n", routes, errors);
+    }
+
+    fib_deinit(&_table);
+    return (errors == 0);
+}
+
+int main(void)
+{
+    bool success = true;
+
+#ifdef MODULE_FIB_TRIE
+    puts("FIB lookup benchmark (prefix trie)");
+#else
+    puts("FIB lookup benchmark (linear scan)");
+#endif
+
+    for (unsigned routes = TEST_ROUTES_MIN; routes <= TEST_ROUTES_MAX;
+         routes <<= 1) {
+        success &= _bench(routes);
+    }
+
+    if (!success) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
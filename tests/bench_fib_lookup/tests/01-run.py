@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    routes = 16
+    while routes <= 1024:
+        child.expect(r"routes:\s+{}, lookups: (\d+), found: (\d+), "
+                     r"time: \d+ us, per lookup: \d+ ns".format(routes))
+        # all destinations lie within one of the routes
+        assert child.match.group(1) == child.match.group(2)
+        routes *= 2
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures RAM and latency of gcoap and a UDP echo sock served
+ *              by one shared event thread or by a thread each
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+/* GCOAP_STACK_SIZE depends on the debug configuration */
+#define ENABLE_DEBUG        (0)
+#include "debug.h"
+
+#ifdef MODULE_GCOAP_EVENT
+#include "event.h"
+#include "net/sock/async/event.h"
+#endif
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (100U)
+#endif
+
+#define TEST_ECHO_PORT      (7300U)
+#define TEST_LEN            (32U)
+
+static ssize_t _bench_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/bench", COAP_GET, _bench_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    &_resources[0],
+    ARRAY_SIZE(_resources),
+    NULL,
+    NULL
+};
+
+static sock_udp_t _echo_sock;
+static mutex_t _resp_lock = MUTEX_INIT_LOCKED;
+static unsigned _resp_ok;
+
+#ifdef MODULE_GCOAP_EVENT
+/* serves gcoap and the echo sock */
+static char _stack[GCOAP_STACK_SIZE];
+static event_queue_t _queue;
+static sock_event_t _echo_event;
+static mutex_t _ready = MUTEX_INIT_LOCKED;
+#else
+/* serves the echo sock, gcoap has a thread of its own */
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+#endif
+
+static ssize_t _bench_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    (void)ctx;
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    memcpy(pdu->payload, "bench", 5);
+    return gcoap_finish(pdu, 5, COAP_FORMAT_TEXT);
+}
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote)
+{
+    (void)remote;
+    if ((req_state == GCOAP_MEMO_RESP) &&
+        (coap_get_code_class(pdu) == COAP_CLASS_SUCCESS)) {
+        _resp_ok++;
+    }
+    mutex_unlock(&_resp_lock);
+}
+
+static int _echo_sock_create(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = TEST_ECHO_PORT };
+
+    return sock_udp_create(&_echo_sock, &local, NULL, 0);
+}
+
+static bool _echo(sock_udp_t *sock, uint32_t timeout)
+{
+    uint8_t buf[TEST_LEN];
+    sock_udp_ep_t remote;
+    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf), timeout, &remote);
+
+    if (res < 0) {
+        return false;
+    }
+    sock_udp_send(sock, buf, res, &remote);
+    return true;
+}
+
+#ifdef MODULE_GCOAP_EVENT
+static void _echo_handler(sock_udp_t *sock, sock_async_flags_t type,
+                          void *arg)
+{
+    (void)arg;
+    if (type & SOCK_ASYNC_MSG_RECV) {
+        /* events are merged while queued, so take all waiting messages */
+        while (_echo(sock, 0)) {}
+    }
+}
+
+static void *_server(void *arg)
+{
+    (void)arg;
+    event_queue_init(&_queue);
+    if ((gcoap_init_event(&_queue) < 0) || (_echo_sock_create() < 0)) {
+        puts("[FAILED] unable to create socks");
+        return NULL;
+    }
+    sock_udp_event_init(&_echo_sock, &_echo_event, &_queue, _echo_handler,
+                        NULL);
+    mutex_unlock(&_ready);
+    event_loop(&_queue);
+    return NULL;
+}
+#else
+static void *_server(void *arg)
+{
+    (void)arg;
+    if (_echo_sock_create() < 0) {
+        puts("[FAILED] unable to create sock");
+        return NULL;
+    }
+    while (1) {
+        _echo(&_echo_sock, SOCK_NO_TIMEOUT);
+    }
+    return NULL;
+}
+#endif
+
+static uint32_t _bench_coap(unsigned *failed)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = GCOAP_PORT };
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET, "/bench");
+        ssize_t len = gcoap_finish(&pdu, 0, COAP_FORMAT_NONE);
+
+        if ((len <= 0) ||
+            (gcoap_req_send(buf, len, &remote, _resp_handler) == 0)) {
+            continue;
+        }
+        /* unlocked by _resp_handler() on response or timeout */
+        mutex_lock(&_resp_lock);
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    *failed = TEST_ROUNDS - _resp_ok;
+    return duration / TEST_ROUNDS;
+}
+
+static uint32_t _bench_echo(unsigned *errors)
+{
+    sock_udp_ep_t local = { .family = AF_INET6 };
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = TEST_ECHO_PORT };
+    uint8_t req[TEST_LEN], reply[TEST_LEN];
+    sock_udp_t sock;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+    sock_udp_create(&sock, &local, NULL, 0);
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        memset(req, i, sizeof(req));
+        if ((sock_udp_send(&sock, req, sizeof(req), &remote) != sizeof(req)) ||
+            (sock_udp_recv(&sock, reply, sizeof(reply), US_PER_SEC,
+                           NULL) != sizeof(reply)) ||
+            (memcmp(req, reply, sizeof(reply)) != 0)) {
+            (*errors)++;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    sock_udp_close(&sock);
+    return duration / TEST_ROUNDS;
+}
+
+int main(void)
+{
+    unsigned failed = 0, errors = 0;
+#ifdef MODULE_GCOAP_EVENT
+    const char *mode = "event";
+    unsigned threads = 1, stacks = sizeof(_stack);
+#else
+    const char *mode = "threads";
+    unsigned threads = 2, stacks = sizeof(_stack) + GCOAP_STACK_SIZE;
+#endif
+
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "server");
+#ifdef MODULE_GCOAP_EVENT
+    /* gcoap must be initialized before registering a listener */
+    mutex_lock(&_ready);
+#endif
+    gcoap_register_listener(&_listener);
+
+    uint32_t time_req = _bench_coap(&failed);
+    uint32_t time_echo = _bench_echo(&errors);
+
+    printf("mode: %s, threads: %u, stacks: %u B, requests: %u, failed: %u, "
+           "time/request: %" PRIu32 " us, echos: %u, errors: %u, "
+           "time/echo: %" PRIu32 " us\n", mode, threads, stacks, TEST_ROUNDS,
+           failed, time_req, TEST_ROUNDS, errors, time_echo);
+    if (failed || errors) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"mode: (event|threads), threads: \d+, stacks: \d+ B, "
+                 r"requests: \d+, failed: 0, time/request: \d+ us, "
+                 r"echos: \d+, errors: 0, time/echo: \d+ us")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures next hop lookup cost of the NIB for different
+ *              neighbor cache sizes
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/ethernet.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/netdev_test.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (10000U)
+#endif
+
+/* destinations forwarded to via routes in each round */
+#define TEST_FLOWS          (4U)
+
+static const unsigned _neighbors[] = { 16, 60, 240 };
+
+static netdev_test_t _netdev;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static gnrc_netif_t *_netif;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    static const uint8_t addr[] = { 0x02, 0x00, 0x00, 0xff, 0xff, 0xff };
+
+    (void)dev;
+    assert(max_len >= sizeof(addr));
+    memcpy(value, addr, sizeof(addr));
+    return sizeof(addr);
+}
+
+static void _neighbor(ipv6_addr_t *addr, uint8_t *l2addr, unsigned i)
+{
+    /* fe80::ff:fe00:<i> derived from 02:00:00:00:<i> */
+    memset(addr, 0, sizeof(*addr));
+    memset(l2addr, 0, ETHERNET_ADDR_LEN);
+    l2addr[0] = 0x02;
+    l2addr[4] = i >> 8;
+    l2addr[5] = i & 0xff;
+    addr->u8[0] = 0xfe;
+    addr->u8[1] = 0x80;
+    addr->u8[11] = 0xff;
+    addr->u8[12] = 0xfe;
+    addr->u8[14] = l2addr[4];
+    addr->u8[15] = l2addr[5];
+}
+
+static void _route(ipv6_addr_t *addr, unsigned i)
+{
+    /* 2001:db8:<i>::/48 */
+    memset(addr, 0, sizeof(*addr));
+    addr->u16[0] = byteorder_htons(0x2001);
+    addr->u16[1] = byteorder_htons(0x0db8);
+    addr->u16[2] = byteorder_htons(i);
+}
+
+static void _fill(unsigned first, unsigned neighbors)
+{
+    for (unsigned i = first; i < neighbors; i++) {
+        ipv6_addr_t addr;
+        uint8_t l2addr[ETHERNET_ADDR_LEN];
+
+        _neighbor(&addr, l2addr, i);
+        gnrc_ipv6_nib_nc_set(&addr, _netif->pid, l2addr, sizeof(l2addr));
+        if ((i % 4) == 0) {
+            ipv6_addr_t dst;
+
+            _route(&dst, i / 4);
+            gnrc_ipv6_nib_ft_add(&dst, 48, &addr, _netif->pid, 0);
+        }
+    }
+}
+
+static uint32_t _bench_neighbors(unsigned neighbors, unsigned *found)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        gnrc_ipv6_nib_nc_t nce;
+        ipv6_addr_t dst;
+        uint8_t l2addr[ETHERNET_ADDR_LEN];
+
+        /* 7 is coprime to all neighbor counts, so all neighbors are visited */
+        _neighbor(&dst, l2addr, (i * 7) % neighbors);
+        if (gnrc_ipv6_nib_get_next_hop_l2addr(&dst, _netif, NULL, &nce) == 0) {
+            (*found)++;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _bench_routes(unsigned routes, unsigned *found)
+{
+    ipv6_addr_t flows[TEST_FLOWS];
+
+    for (unsigned i = 0; i < TEST_FLOWS; i++) {
+        _route(&flows[i], (i * routes) / TEST_FLOWS);
+        flows[i].u8[15] = 1;
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        gnrc_ipv6_nib_nc_t nce;
+
+        if (gnrc_ipv6_nib_get_next_hop_l2addr(&flows[i % TEST_FLOWS], _netif,
+                                              NULL, &nce) == 0) {
+            (*found)++;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    unsigned filled = 0;
+    bool success = true;
+
+    netdev_test_setup(&_netdev, 0);
+    netdev_test_set_get_cb(&_netdev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_netdev, NETOPT_MAX_PDU_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_netdev, NETOPT_ADDRESS, _get_address);
+    _netif = gnrc_netif_ethernet_create(_netif_stack, sizeof(_netif_stack),
+                                        GNRC_NETIF_PRIO, "bench_eth",
+                                        &_netdev.netdev);
+    assert(_netif != NULL);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_neighbors); i++) {
+        unsigned neighbors = _neighbors[i], routes = (neighbors + 3) / 4;
+        unsigned found = 0;
+        uint32_t nbr_time, route_time;
+
+        _fill(filled, neighbors);
+        filled = neighbors;
+        nbr_time = _bench_neighbors(neighbors, &found);
+        route_time = _bench_routes(routes, &found);
+        printf("neighbors: %3u, routes: %2u, lookups: %u, found: %u, "
+               "neighbor: %" PRIu32 " ns, route: %" PRIu32 " ns\n",
+               neighbors, routes, 2 * TEST_LOOKUPS, found,
+               (uint32_t)(((uint64_t)nbr_time * 1000) / TEST_LOOKUPS),
+               (uint32_t)(((uint64_t)route_time * 1000) / TEST_LOOKUPS));
+        /* every neighbor and every route exists */
+        if (found != (2 * TEST_LOOKUPS)) {
+            success = false;
+        }
+    }
+
+    if (!success) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for neighbors in (16, 60, 240):
+        child.expect(r"neighbors:\s+{}, routes:\s+\d+, lookups: (\d+), "
+                     r"found: (\d+), neighbor: \d+ ns, route: \d+ ns"
+                     .format(neighbors))
+        # every neighbor and route looked up exists
+        assert child.match.group(1) == child.match.group(2)
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
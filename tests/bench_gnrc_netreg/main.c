@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures gnrc_netreg_lookup() cost for different numbers of
+ *              registered demultiplexing contexts
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+#include "thread.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000U)
+#endif
+
+#define TEST_DEMUX_CTX      (0x1000U)
+#define TEST_ENTRIES_NUMOF  (24U)
+#define TEST_MSG_QUEUE_SIZE (4U)
+
+static gnrc_netreg_entry_t _entries[TEST_ENTRIES_NUMOF];
+/* gnrc_netreg_register() expects the registered thread to have a queue */
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+
+int main(void)
+{
+    char name[sizeof("lookup with 00 entries")];
+    unsigned failed = 0;
+
+#ifdef MODULE_GNRC_NETREG_HASH
+    puts("netreg lookup benchmark (hash)");
+#else
+    puts("netreg lookup benchmark (linear list)");
+#endif
+
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    gnrc_netreg_init();
+    for (unsigned i = 0; i < TEST_ENTRIES_NUMOF; i++) {
+        gnrc_netreg_entry_init_pid(&_entries[i], TEST_DEMUX_CTX + i,
+                                   thread_getpid());
+        if (gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &_entries[i]) < 0) {
+            puts("[FAILED] unable to register entry");
+            return 1;
+        }
+        if (((i + 1) == 1) || ((i + 1) == 8) || ((i + 1) == 24)) {
+            /* the first registered entry is the last one in a linear list */
+            snprintf(name, sizeof(name), "lookup with %02u entries", i + 1);
+            BENCHMARK_FUNC(name, BENCH_RUNS,
+                           gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF,
+                                              TEST_DEMUX_CTX));
+        }
+    }
+    for (unsigned i = 0; i < TEST_ENTRIES_NUMOF; i++) {
+        if (gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF,
+                               TEST_DEMUX_CTX + i) != &_entries[i]) {
+            failed++;
+        }
+    }
+    if (failed) {
+        printf("[FAILED] %u wrong lookups\n", failed);
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Packet buffer churn benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#ifndef TEST_OPS
+#define TEST_OPS            (100000U)
+#endif
+
+#ifndef TEST_SLOTS
+#define TEST_SLOTS          (8U)
+#endif
+
+#define TEST_NETIF_HDR_LEN  (16U)
+#define TEST_IPV6_HDR_LEN   (40U)
+#define TEST_UDP_HDR_LEN    (8U)
+
+#if defined(MODULE_GNRC_PKTBUF_SLAB)
+#define TEST_BACKEND        "slab"
+#elif defined(MODULE_GNRC_PKTBUF_MALLOC)
+#define TEST_BACKEND        "malloc"
+#else
+#define TEST_BACKEND        "static"
+#endif
+
+static gnrc_pktsnip_t *_slots[TEST_SLOTS];
+static uint32_t _rand_state = 0x2545F491;
+
+/* xorshift32, so every backend sees the same operations */
+static uint32_t _rand(void)
+{
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static size_t _payload_len(void)
+{
+    uint32_t r = _rand();
+    unsigned kind = r % 20;
+
+    r >>= 8;
+    if (kind < 4) {
+        /* e.g. empty CoAP ACKs */
+        return TEST_IPV6_HDR_LEN + TEST_UDP_HDR_LEN + 4 + (r % 12);
+    }
+    if (kind < 19) {
+        /* anything that fits into an IEEE 802.15.4 frame */
+        return TEST_IPV6_HDR_LEN + TEST_UDP_HDR_LEN + 16 + (r % 64);
+    }
+    /* reassembled datagrams up to the IPv6 minimum MTU */
+    return TEST_IPV6_HDR_LEN + TEST_UDP_HDR_LEN + 128 + (r % 1104);
+}
+
+static gnrc_pktsnip_t *_receive(void)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, _payload_len(), GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    if ((gnrc_pktbuf_mark(pkt, TEST_IPV6_HDR_LEN, GNRC_NETTYPE_UNDEF) == NULL) ||
+        (gnrc_pktbuf_mark(pkt, TEST_UDP_HDR_LEN, GNRC_NETTYPE_UNDEF) == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    netif = gnrc_pktbuf_add(pkt, NULL, TEST_NETIF_HDR_LEN, GNRC_NETTYPE_NETIF);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return netif;
+}
+
+int main(void)
+{
+    uint32_t failed = 0;
+
+    gnrc_pktbuf_init();
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_OPS; i++) {
+        unsigned slot = _rand() % TEST_SLOTS;
+
+        if (_slots[slot] != NULL) {
+            gnrc_pktbuf_release(_slots[slot]);
+            _slots[slot] = NULL;
+        }
+        else if ((_slots[slot] = _receive()) == NULL) {
+            failed++;
+        }
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("backend: %s, ops: %u, failed: %" PRIu32 ", time: %" PRIu32 " us\n",
+           TEST_BACKEND, TEST_OPS, failed, time);
+#ifdef DEVELHELP
+    gnrc_pktbuf_stats();
+#endif
+
+    if (!gnrc_pktbuf_is_sane()) {
+        puts("[FAILED] packet buffer corrupted");
+        return 1;
+    }
+    for (unsigned i = 0; i < TEST_SLOTS; i++) {
+        gnrc_pktbuf_release(_slots[i]);
+        _slots[i] = NULL;
+    }
+    if (!gnrc_pktbuf_is_empty()) {
+        puts("[FAILED] packet buffer not empty");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
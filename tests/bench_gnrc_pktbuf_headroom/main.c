@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Counts packet buffer allocations and copies on the UDP send
+ *              path with and without headroom
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/gnrc/pktbuf.h"
+
+#ifndef TEST_PKTS
+#define TEST_PKTS           (1000U)
+#endif
+
+#define TEST_NETIF_HDR_LEN  (16U)
+#define TEST_IPV6_HDR_LEN   (40U)
+#define TEST_UDP_HDR_LEN    (8U)
+/* IPHC with link-local addresses derived from the link-layer addresses and
+ * NHC for UDP */
+#define TEST_IPHC_LEN       (7U)
+
+static uint8_t _payload[64];
+
+/* mirrors gnrc_sixlowpan_iphc_send() */
+static int _iphc(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *dispatch, *udp = pkt->next->next;
+    uint8_t iphc_hdr[TEST_IPV6_HDR_LEN + TEST_UDP_HDR_LEN];
+
+    memset(iphc_hdr, 0, TEST_IPHC_LEN);
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    gnrc_pktbuf_remove_snip(pkt, udp);
+    dispatch = gnrc_pktbuf_add_header(pkt->next, iphc_hdr, TEST_IPHC_LEN,
+                                      GNRC_NETTYPE_UNDEF);
+    if (dispatch == NULL) {
+        return -1;
+    }
+    dispatch->next = pkt->next;
+    pkt->next = dispatch;
+    return 0;
+}
+
+static gnrc_pktsnip_t *_send(size_t len, size_t headroom)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    /* sock */
+    pkt = gnrc_pktbuf_add_headroom(NULL, _payload, len, headroom,
+                                   GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    /* UDP, IPv6 and network interface header */
+    if ((hdr = gnrc_pktbuf_add_header(pkt, NULL, TEST_UDP_HDR_LEN,
+                                      GNRC_NETTYPE_UNDEF)) == NULL) {
+        goto error;
+    }
+    pkt = hdr;
+    if ((hdr = gnrc_pktbuf_add_header(pkt, NULL, TEST_IPV6_HDR_LEN,
+                                      GNRC_NETTYPE_UNDEF)) == NULL) {
+        goto error;
+    }
+    pkt = hdr;
+    if ((hdr = gnrc_pktbuf_add(NULL, NULL, TEST_NETIF_HDR_LEN,
+                               GNRC_NETTYPE_NETIF)) == NULL) {
+        goto error;
+    }
+    hdr->next = pkt;
+    pkt = hdr;
+    /* 6LoWPAN */
+    if (_iphc(pkt) < 0) {
+        goto error;
+    }
+    return pkt;
+
+error:
+    gnrc_pktbuf_release(pkt);
+    return NULL;
+}
+
+static void _run(size_t headroom)
+{
+    unsigned failed = 0, contiguous = 0;
+
+    memset(&gnrc_pktbuf_counters, 0, sizeof(gnrc_pktbuf_counters));
+    for (unsigned i = 0; i < TEST_PKTS; i++) {
+        gnrc_pktsnip_t *pkt = _send(16 + (i % (sizeof(_payload) - 16)),
+                                    headroom);
+
+        if (pkt == NULL) {
+            failed++;
+            continue;
+        }
+        gnrc_pktsnip_t *dispatch = pkt->next;
+        if (((uint8_t *)dispatch->data + dispatch->size) ==
+            dispatch->next->data) {
+            contiguous++;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    printf("headroom: %u, packets: %u, failed: %u, allocs/pkt: %" PRIu32
+           ", headroom/pkt: %" PRIu32 ", copied/pkt: %" PRIu32
+           ", contiguous: %u\n", (unsigned)headroom, TEST_PKTS, failed,
+           gnrc_pktbuf_counters.allocs / TEST_PKTS,
+           gnrc_pktbuf_counters.headroom / TEST_PKTS,
+           gnrc_pktbuf_counters.copied / TEST_PKTS, contiguous);
+}
+
+int main(void)
+{
+    gnrc_pktbuf_init();
+    _run(0);
+    _run(GNRC_PKTBUF_TX_HEADROOM);
+    puts("[SUCCESS]");
+
+    return 0;
+}
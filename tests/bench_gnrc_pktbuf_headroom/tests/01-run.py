@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for headroom in (0, r"\d+"):
+        child.expect(r"headroom: {}, packets: \d+, failed: 0, "
+                     r"allocs/pkt: \d+, headroom/pkt: \d+, copied/pkt: \d+, "
+                     r"contiguous: \d+".format(headroom))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
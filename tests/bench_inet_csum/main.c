@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of the Internet checksum
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "kernel_defines.h"
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#ifndef TEST_DATA_LEN
+#define TEST_DATA_LEN       (1280U)
+#endif
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (1000U)
+#endif
+
+/* one spare byte to measure unaligned buffers */
+static uint8_t _data[TEST_DATA_LEN + 1];
+
+/* byte-wise checksum, as inet_csum_slice() was implemented before */
+static uint16_t _csum_bytewise(uint16_t sum, const uint8_t *buf, uint16_t len,
+                               size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    for (uint16_t i = 0; i < len; i++, accum_len++) {
+        csum += (accum_len & 1) ? buf[i] : (uint16_t)(buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+/* returns the average time of one run in nsec */
+static uint32_t _measure(uint16_t (*csum)(uint16_t, const uint8_t *, uint16_t, size_t),
+                         const uint8_t *buf, uint16_t len, uint16_t *res)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        *res = csum(0, buf, len, 0);
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+    return (uint32_t)(((uint64_t)duration * 1000) / TEST_ROUNDS);
+}
+
+static uint32_t _kibps(uint16_t len, uint32_t nsec)
+{
+    if (nsec == 0) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)len * US_PER_SEC * 1000) / 1024 / nsec);
+}
+
+static unsigned _bench(uint16_t len, unsigned offset)
+{
+    uint16_t expected, res;
+    uint32_t bytewise = _measure(_csum_bytewise, _data + offset, len, &expected);
+    uint32_t words = _measure(inet_csum_slice, _data + offset, len, &res);
+
+    printf("len: %4u, offset: %u, bytewise: %6" PRIu32 " ns (%6" PRIu32 " KiB/s), "
+           "inet_csum: %6" PRIu32 " ns (%6" PRIu32 " KiB/s)\n",
+           len, offset, bytewise, _kibps(len, bytewise), words, _kibps(len, words));
+
+    if (res != expected) {
+        printf("checksum mismatch: 0x%04x != 0x%04x\n", res, expected);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const uint16_t lens[] = { 8, 40, 64, 256, TEST_DATA_LEN };
+    unsigned errors = 0;
+
+    printf("Internet checksum benchmark, %u runs\n", TEST_ROUNDS);
+
+    for (unsigned i = 0; i < sizeof(_data); i++) {
+        _data[i] = (uint8_t)(i * 31);
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        errors += _bench(lens[i], 0);
+        errors += _bench(lens[i], 1);
+    }
+
+    if (errors) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
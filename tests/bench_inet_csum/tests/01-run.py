@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for length in (8, 40, 64, 256, 1280):
+        for offset in (0, 1):
+            child.expect(r"len:\s+{}, offset: {}, bytewise:\s+\d+ ns \(\s*\d+ KiB/s\), "
+                         r"inet_csum:\s+\d+ ns \(\s*\d+ KiB/s\)".format(length, offset))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares handing records to a waiting thread via mbox,
+ *              isrpipe, spscq and mpscq
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "isrpipe.h"
+#include "kernel_defines.h"
+#include "mbox.h"
+#include "mpscq.h"
+#include "spscq.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_RECORDS
+#define TEST_RECORDS        (10000U)
+#endif
+
+#define TEST_REC_LEN        (16U)
+#define TEST_QUEUE_SIZE     (8U)
+#define TEST_FLAG           (0x1)
+
+typedef struct {
+    mpscq_node_t node;
+    uint32_t seq;
+    uint8_t data[TEST_REC_LEN - sizeof(uint32_t)];
+} record_t;
+
+typedef struct {
+    const char *name;
+    void (*init)(void);
+    void (*put)(uint32_t seq);
+    uint32_t (*get)(void);
+} bench_t;
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static volatile unsigned _errors;
+static record_t _records[TEST_QUEUE_SIZE];
+
+/* mbox: a message pointing to the record */
+static msg_t _mb_queue[TEST_QUEUE_SIZE];
+static mbox_t _mbox;
+
+static void _mb_init(void)
+{
+    mbox_init(&_mbox, _mb_queue, ARRAY_SIZE(_mb_queue));
+}
+
+static void _mb_put(uint32_t seq)
+{
+    msg_t msg;
+    record_t *rec = &_records[seq % TEST_QUEUE_SIZE];
+
+    rec->seq = seq;
+    msg.content.ptr = rec;
+    mbox_put(&_mbox, &msg);
+}
+
+static uint32_t _mb_get(void)
+{
+    msg_t msg;
+
+    mbox_get(&_mbox, &msg);
+    return ((record_t *)msg.content.ptr)->seq;
+}
+
+/* isrpipe: the record is copied in byte by byte, as from an UART ISR */
+static uint8_t _pipe_buf[TEST_QUEUE_SIZE * TEST_REC_LEN];
+static isrpipe_t _pipe;
+
+static void _pipe_init(void)
+{
+    isrpipe_init(&_pipe, _pipe_buf, sizeof(_pipe_buf));
+}
+
+static void _pipe_put(uint32_t seq)
+{
+    record_t rec = { .seq = seq };
+    const uint8_t *bytes = (const uint8_t *)&rec.seq;
+
+    for (unsigned i = 0; i < TEST_REC_LEN; i++) {
+        isrpipe_write_one(&_pipe, bytes[i]);
+    }
+}
+
+static uint32_t _pipe_get(void)
+{
+    record_t rec;
+    uint8_t *bytes = (uint8_t *)&rec.seq;
+
+    for (unsigned got = 0; got < TEST_REC_LEN;) {
+        got += isrpipe_read(&_pipe, &bytes[got], TEST_REC_LEN - got);
+    }
+    return rec.seq;
+}
+
+/* spscq: the record is copied in and out */
+static uint32_t _spsc_buf[TEST_QUEUE_SIZE * SPSCQ_RECORD_SIZE(TEST_REC_LEN) /
+                          sizeof(uint32_t)];
+static spscq_t _spsc;
+
+static void _spsc_init(void)
+{
+    spscq_init(&_spsc, _spsc_buf, sizeof(_spsc_buf), TEST_FLAG);
+}
+
+static void _spsc_put(uint32_t seq)
+{
+    record_t rec = { .seq = seq };
+
+    spscq_put(&_spsc, &rec.seq, TEST_REC_LEN);
+}
+
+static uint32_t _spsc_get(void)
+{
+    record_t rec;
+
+    spscq_get_blocking(&_spsc, &rec.seq, TEST_REC_LEN);
+    return rec.seq;
+}
+
+/* mpscq: the record itself is linked into the queue */
+static mpscq_t _mpsc;
+
+static void _mpsc_init(void)
+{
+    mpscq_init(&_mpsc, TEST_FLAG);
+}
+
+static void _mpsc_put(uint32_t seq)
+{
+    record_t *rec = &_records[seq % TEST_QUEUE_SIZE];
+
+    rec->seq = seq;
+    mpscq_put(&_mpsc, &rec->node);
+}
+
+static uint32_t _mpsc_get(void)
+{
+    return container_of(mpscq_get_blocking(&_mpsc), record_t, node)->seq;
+}
+
+static const bench_t _benches[] = {
+    { "mbox", _mb_init, _mb_put, _mb_get },
+    { "isrpipe", _pipe_init, _pipe_put, _pipe_get },
+    { "spscq", _spsc_init, _spsc_put, _spsc_get },
+    { "mpscq", _mpsc_init, _mpsc_put, _mpsc_get },
+};
+
+static void *_consumer(void *arg)
+{
+    const bench_t *bench = arg;
+
+    for (uint32_t seq = 0; seq < TEST_RECORDS; seq++) {
+        if (bench->get() != seq) {
+            _errors++;
+        }
+    }
+    return NULL;
+}
+
+static void _bench(const bench_t *bench)
+{
+    bench->init();
+    /* the consumer has the higher priority, so it takes every record right
+     * away, as a thread woken by an ISR would */
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _consumer, (void *)bench,
+                  "consumer");
+
+    uint32_t start = xtimer_now_usec();
+    for (uint32_t seq = 0; seq < TEST_RECORDS; seq++) {
+        bench->put(seq);
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("%-7s %6" PRIu32 " ns per record, %7" PRIu32 " records/s\n",
+           bench->name, (uint32_t)(((uint64_t)duration * 1000) / TEST_RECORDS),
+           (uint32_t)(((uint64_t)TEST_RECORDS * US_PER_SEC) / duration));
+}
+
+int main(void)
+{
+    printf("handoff benchmark, %u records of %u bytes\n",
+           TEST_RECORDS, TEST_REC_LEN);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_benches); i++) {
+        _bench(&_benches[i]);
+    }
+
+    if (_errors) {
+        printf("%u records lost or reordered\n", _errors);
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
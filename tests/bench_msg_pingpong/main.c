@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include "thread.h"
 
+#include "kernel_defines.h"
 #include "msg.h"
 #include "xtimer.h"
 
@@ -28,8 +29,14 @@
 #define TEST_DURATION       (1000000U)
 #endif
 
+#ifndef TEST_BULK_SIZE
+#define TEST_BULK_SIZE      (8U)
+#endif
+
 volatile unsigned _flag = 0;
 static char _stack[THREAD_STACKSIZE_MAIN];
+static char _bulk_stack[THREAD_STACKSIZE_MAIN];
+static volatile uint32_t _bulk_received = 0;
 
 static void _timer_callback(void*arg)
 {
@@ -50,6 +57,20 @@ static void *_second_thread(void *arg)
     return NULL;
 }
 
+static void *_bulk_thread(void *arg)
+{
+    (void)arg;
+    msg_t queue[2 * TEST_BULK_SIZE];
+    msg_t test[TEST_BULK_SIZE];
+
+    msg_init_queue(queue, ARRAY_SIZE(queue));
+    while(1) {
+        _bulk_received += msg_receive_bulk(test, ARRAY_SIZE(test));
+    }
+
+    return NULL;
+}
+
 int main(void)
 {
     printf("main starting\n");
@@ -77,5 +98,31 @@ int main(void)
 
     printf("{ \"result\" : %"PRIu32" }\n", n);
 
+    /* throughput variant: messages are sent and received in batches */
+    kernel_pid_t bulk = thread_create(_bulk_stack,
+                                      sizeof(_bulk_stack),
+                                      (THREAD_PRIORITY_MAIN - 1),
+                                      THREAD_CREATE_STACKTEST,
+                                      _bulk_thread,
+                                      NULL,
+                                      "bulk_thread");
+
+    msg_t batch[TEST_BULK_SIZE];
+
+    n = 0;
+    _flag = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while(!_flag) {
+        n += msg_try_send_bulk(batch, ARRAY_SIZE(batch), bulk);
+    }
+
+    printf("{ \"bulk_result\" : %"PRIu32", \"bulk_size\" : %u }\n", n,
+           TEST_BULK_SIZE);
+    if (n != _bulk_received) {
+        printf("[FAILED] %"PRIu32" bulk messages lost\n", n - _bulk_received);
+        return 1;
+    }
+    puts("[SUCCESS]");
+
     return 0;
 }
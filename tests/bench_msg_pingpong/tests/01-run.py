@@ -13,6 +13,8 @@ from testrunner import run
 
 def testfunc(child):
     child.expect(r"{ \"result\" : \d+ }")
+    child.expect(r"{ \"bulk_result\" : \d+, \"bulk_size\" : \d+ }")
+    child.expect_exact("[SUCCESS]")
 
 
 if __name__ == "__main__":
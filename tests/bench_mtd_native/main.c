@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare throughput of the native MTD backends
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "mtd.h"
+#include "mtd_native.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define TEST_PAGE_SIZE      (256U)
+#define TEST_SECTOR_SIZE    (4096U)
+#define TEST_SECTOR_NUM     (64U)
+#define TEST_PAGE_NUM       ((TEST_SECTOR_SIZE * TEST_SECTOR_NUM) / TEST_PAGE_SIZE)
+
+#ifndef TEST_RANDOM_OPS
+#define TEST_RANDOM_OPS     (4096U)
+#endif
+
+#define MTD_NATIVE_DEV(drv, file)                                     \
+    {                                                                 \
+        .dev = {                                                      \
+            .driver = drv,                                            \
+            .sector_count = TEST_SECTOR_NUM,                          \
+            .pages_per_sector = TEST_SECTOR_SIZE / TEST_PAGE_SIZE,    \
+            .page_size = TEST_PAGE_SIZE,                              \
+        },                                                            \
+        .fname = file,                                                \
+    }
+
+static mtd_native_dev_t _devs[] = {
+    MTD_NATIVE_DEV(&native_flash_driver, "bench_mtd_file.bin"),
+    MTD_NATIVE_DEV(&native_flash_mmap_driver, "bench_mtd_mmap.bin"),
+};
+
+static const char *_names[] = { "file", "mmap" };
+
+static uint8_t _buf[TEST_PAGE_SIZE];
+
+static void _print_result(const char *name, const char *test, uint32_t bytes,
+                          uint32_t usec)
+{
+    /* bytes per microsecond equals MB/s */
+    uint64_t rate = ((uint64_t)bytes * 100) / (usec ? usec : 1);
+
+    printf("%s: %-10s %6" PRIu32 " kB in %8" PRIu32 " us: %4" PRIu32
+           ".%02" PRIu32 " MB/s\n", name, test, bytes / 1000, usec,
+           (uint32_t)(rate / 100), (uint32_t)(rate % 100));
+}
+
+static void _bench(mtd_dev_t *dev, const char *name)
+{
+    uint32_t start, bytes;
+
+    if (mtd_init(dev) < 0) {
+        printf("%s: init failed\n", name);
+        return;
+    }
+    mtd_erase(dev, 0, TEST_SECTOR_SIZE * TEST_SECTOR_NUM);
+
+    bytes = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_PAGE_NUM; i++) {
+        mtd_write(dev, _buf, i * TEST_PAGE_SIZE, TEST_PAGE_SIZE);
+        bytes += TEST_PAGE_SIZE;
+    }
+    _print_result(name, "seq write", bytes, xtimer_now_usec() - start);
+
+    bytes = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_PAGE_NUM; i++) {
+        mtd_read(dev, _buf, i * TEST_PAGE_SIZE, TEST_PAGE_SIZE);
+        bytes += TEST_PAGE_SIZE;
+    }
+    _print_result(name, "seq read", bytes, xtimer_now_usec() - start);
+
+    bytes = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RANDOM_OPS; i++) {
+        uint32_t page = random_uint32_range(0, TEST_PAGE_NUM);
+        mtd_write(dev, _buf, page * TEST_PAGE_SIZE, TEST_PAGE_SIZE);
+        bytes += TEST_PAGE_SIZE;
+    }
+    _print_result(name, "rand write", bytes, xtimer_now_usec() - start);
+
+    bytes = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RANDOM_OPS; i++) {
+        uint32_t page = random_uint32_range(0, TEST_PAGE_NUM);
+        mtd_read(dev, _buf, page * TEST_PAGE_SIZE, TEST_PAGE_SIZE);
+        bytes += TEST_PAGE_SIZE;
+    }
+    _print_result(name, "rand read", bytes, xtimer_now_usec() - start);
+
+    mtd_power(dev, MTD_POWER_DOWN);
+}
+
+int main(void)
+{
+    puts("native MTD backend benchmark");
+
+    for (unsigned i = 0; i < TEST_PAGE_SIZE; i++) {
+        _buf[i] = (uint8_t)i;
+    }
+
+    for (unsigned i = 0; i < sizeof(_devs) / sizeof(_devs[0]); i++) {
+        _bench(&_devs[i].dev, _names[i]);
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
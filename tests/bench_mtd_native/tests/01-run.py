@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for backend in ("file", "mmap"):
+        for test in ("seq write", "seq read", "rand write", "rand read"):
+            child.expect(r"{}: {}\s+\d+ kB in\s+\d+ us:\s+\d+\.\d+ MB/s"
+                         .format(backend, test))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -30,7 +30,9 @@
 
 volatile unsigned _flag = 0;
 static char _stack[THREAD_STACKSIZE_MAIN];
+static char _contender_stack[THREAD_STACKSIZE_DEFAULT];
 static mutex_t _mutex = MUTEX_INIT;
+static mutex_t _contended_mutex = MUTEX_INIT;
 
 static void _timer_callback(void*arg)
 {
@@ -51,6 +53,60 @@ static void *_second_thread(void *arg)
     return NULL;
 }
 
+static void *_contender_thread(void *arg)
+{
+    (void)arg;
+
+    while(1) {
+        /* yield while holding the mutex, so main blocks on it */
+        mutex_lock(&_contended_mutex);
+        thread_yield();
+        mutex_unlock(&_contended_mutex);
+    }
+
+    return NULL;
+}
+
+static uint32_t _uncontended(xtimer_t *timer)
+{
+    mutex_t mutex = MUTEX_INIT;
+    uint32_t n = 0;
+
+    _flag = 0;
+    xtimer_set(timer, TEST_DURATION);
+    while(!_flag) {
+        mutex_lock(&mutex);
+        mutex_unlock(&mutex);
+        n++;
+    }
+
+    return n;
+}
+
+static uint32_t _contended(xtimer_t *timer)
+{
+    uint32_t n = 0;
+
+    thread_create(_contender_stack,
+                  sizeof(_contender_stack),
+                  THREAD_PRIORITY_MAIN,
+                  THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                  _contender_thread,
+                  NULL,
+                  "contender");
+
+    _flag = 0;
+    xtimer_set(timer, TEST_DURATION);
+    while(!_flag) {
+        mutex_lock(&_contended_mutex);
+        thread_yield();
+        mutex_unlock(&_contended_mutex);
+        n++;
+    }
+
+    return n;
+}
+
 int main(void)
 {
     printf("main starting\n");
@@ -80,5 +136,11 @@ int main(void)
 
     printf("{ \"result\" : %"PRIu32" }\n", n);
 
+    n = _uncontended(&timer);
+    printf("{ \"uncontended\" : %"PRIu32" }\n", n);
+
+    n = _contended(&timer);
+    printf("{ \"contended\" : %"PRIu32" }\n", n);
+
     return 0;
 }
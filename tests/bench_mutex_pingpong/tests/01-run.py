@@ -13,6 +13,8 @@ from testrunner import run
 
 def testfunc(child):
     child.expect(r"{ \"result\" : \d+ }")
+    child.expect(r"{ \"uncontended\" : \d+ }")
+    child.expect(r"{ \"contended\" : \d+ }")
 
 
 if __name__ == "__main__":
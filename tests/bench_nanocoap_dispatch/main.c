@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures CoAP request dispatch cost for different numbers of
+ *              resources
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/nanocoap.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define TEST_RESOURCES_MAX  (500U)
+#define TEST_PKTS           (32U)
+#define TEST_BUF_SIZE       (64U)
+
+#ifndef TEST_REQUESTS
+#define TEST_REQUESTS       (10000U)
+#endif
+
+/* nanocoap wants an application resource list */
+const coap_resource_t coap_resources[] = {
+    { "/", COAP_GET, NULL, NULL },
+};
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static char _paths[TEST_RESOURCES_MAX][sizeof("/dev/000/val")];
+static coap_resource_t _resources[TEST_RESOURCES_MAX];
+static coap_resource_index_t _index;
+
+static uint8_t _bufs[TEST_PKTS][TEST_BUF_SIZE];
+static coap_pkt_t _pkts[TEST_PKTS];
+/* resource each request is for, NULL if none */
+static const coap_resource_t *_expected[TEST_PKTS];
+
+static void _fill(void)
+{
+    /* zero padded numbers keep the resources in alphabetical order */
+    for (unsigned i = 0; i < TEST_RESOURCES_MAX; i++) {
+        snprintf(_paths[i], sizeof(_paths[i]), "/dev/%03u/val", i);
+        _resources[i].path = _paths[i];
+        _resources[i].methods = COAP_GET;
+    }
+}
+
+static void _build_requests(unsigned numof)
+{
+    for (unsigned i = 0; i < TEST_PKTS; i++) {
+        char path[sizeof(_paths[0])];
+        unsigned n = random_uint32_range(0, numof + numof / 8 + 1);
+
+        /* some requests are for resources that don't exist */
+        snprintf(path, sizeof(path), "/dev/%03u/val", n);
+        _expected[i] = (n < numof) ? &_resources[n] : NULL;
+
+        size_t len = coap_build_hdr((coap_hdr_t *)_bufs[i], COAP_TYPE_NON,
+                                    NULL, 0, COAP_METHOD_GET, i);
+        coap_pkt_init(&_pkts[i], _bufs[i], TEST_BUF_SIZE, len);
+        coap_opt_add_string(&_pkts[i], COAP_OPT_URI_PATH, path, '/');
+        len = coap_opt_finish(&_pkts[i], COAP_OPT_FINISH_NONE);
+        coap_parse(&_pkts[i], _bufs[i], len);
+    }
+}
+
+/* linear search on a copy of the URI path, as without resource index */
+static const coap_resource_t *_find_linear(coap_pkt_t *pkt, unsigned numof)
+{
+    uint8_t uri[NANOCOAP_URI_MAX];
+
+    if (coap_get_uri_path(pkt, uri) <= 0) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        int res = coap_match_path(&_resources[i], uri);
+        if (res > 0) {
+            continue;
+        }
+        return (res < 0) ? NULL : &_resources[i];
+    }
+    return NULL;
+}
+
+static const coap_resource_t *_find_index(coap_pkt_t *pkt, unsigned numof)
+{
+    const coap_resource_index_entry_t *entry;
+
+    (void)numof;
+    if (coap_resource_index_find(&_index, pkt, COAP_GET, &entry) < 0) {
+        return NULL;
+    }
+    return entry->resource;
+}
+
+static uint32_t _measure(const coap_resource_t *(*find)(coap_pkt_t *, unsigned),
+                         unsigned numof, unsigned *errors)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_REQUESTS; i++) {
+        unsigned k = i % TEST_PKTS;
+        if (find(&_pkts[k], numof) != _expected[k]) {
+            (*errors)++;
+        }
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+    return (uint32_t)(((uint64_t)duration * 1000) / TEST_REQUESTS);
+}
+
+static unsigned _bench(unsigned numof)
+{
+    unsigned errors = 0;
+
+    coap_resource_index_init(&_index);
+    coap_resource_index_add(&_index, _resources, numof, NULL);
+    _build_requests(numof);
+
+    uint32_t linear = _measure(_find_linear, numof, &errors);
+    uint32_t index = _measure(_find_index, numof, &errors);
+
+    printf("resources: %3u, requests: %u, linear: %" PRIu32 " ns, "
+           "index: %" PRIu32 " ns\n", numof, TEST_REQUESTS, linear, index);
+
+    return errors;
+}
+
+int main(void)
+{
+    static const unsigned sizes[] = { 10, 50, 100, 250, 500 };
+    unsigned errors = 0;
+
+    puts("CoAP request dispatch benchmark");
+
+    _fill();
+    for (unsigned i = 0; i < ARRAY_SIZE(sizes); i++) {
+        errors += _bench(sizes[i]);
+    }
+
+    if (errors) {
+        printf("%u requests dispatched to the wrong resource\n", errors);
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares UDP echo servers for many POSIX sockets using a
+ *              thread per socket and a single thread with poll()
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_SOCKETS
+#define TEST_SOCKETS        (16U)
+#endif
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (100U)
+#endif
+
+#define TEST_PORT_THREADS   (7100U)
+#define TEST_PORT_POLL      (7200U)
+#define TEST_LEN            (64U)
+
+static char _thread_stacks[TEST_SOCKETS][THREAD_STACKSIZE_DEFAULT];
+static char _poll_stack[THREAD_STACKSIZE_DEFAULT];
+static int _poll_fds[TEST_SOCKETS];
+
+static uint8_t _client_buf[TEST_LEN];
+static uint8_t _reply_buf[TEST_LEN];
+
+static int _server_socket(uint16_t port)
+{
+    struct sockaddr_in6 addr = { .sin6_family = AF_INET6,
+                                 .sin6_port = htons(port) };
+    int fd = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+
+    if ((fd >= 0) &&
+        (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)) {
+        return -1;
+    }
+    return fd;
+}
+
+static void _echo(int fd)
+{
+    uint8_t buf[TEST_LEN];
+    struct sockaddr_in6 remote;
+    socklen_t remote_len = sizeof(remote);
+    ssize_t res = recvfrom(fd, buf, sizeof(buf), 0,
+                           (struct sockaddr *)&remote, &remote_len);
+
+    if (res >= 0) {
+        sendto(fd, buf, res, 0, (struct sockaddr *)&remote, remote_len);
+    }
+}
+
+/* blocks on its socket only */
+static void *_thread_server(void *arg)
+{
+    int fd = (intptr_t)arg;
+
+    while (1) {
+        _echo(fd);
+    }
+    return NULL;
+}
+
+/* waits on all sockets at once */
+static void *_poll_server(void *arg)
+{
+    struct pollfd fds[TEST_SOCKETS];
+
+    (void)arg;
+    for (unsigned i = 0; i < TEST_SOCKETS; i++) {
+        fds[i].fd = _poll_fds[i];
+        fds[i].events = POLLIN;
+    }
+    while (1) {
+        if (poll(fds, TEST_SOCKETS, -1) <= 0) {
+            continue;
+        }
+        for (unsigned i = 0; i < TEST_SOCKETS; i++) {
+            if (fds[i].revents & POLLIN) {
+                _echo(fds[i].fd);
+            }
+        }
+    }
+    return NULL;
+}
+
+static unsigned _stack_used(char *stack)
+{
+#ifdef DEVELHELP
+    return THREAD_STACKSIZE_DEFAULT - thread_measure_stack_free(stack);
+#else
+    (void)stack;
+    return 0;
+#endif
+}
+
+/* sends one request to every server socket in turn and waits for each
+ * reply */
+static unsigned _bench(const char *mode, uint16_t port, char *stacks,
+                       unsigned stacks_numof)
+{
+    sock_udp_ep_t local = { .family = AF_INET6 };
+    sock_udp_ep_t remote = { .family = AF_INET6 };
+    sock_udp_t sock;
+    unsigned errors = 0, stack_used = 0;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+    sock_udp_create(&sock, &local, NULL, 0);
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < (TEST_ROUNDS * TEST_SOCKETS); i++) {
+        _client_buf[0] = (uint8_t)i;
+        remote.port = port + (i % TEST_SOCKETS);
+        if ((sock_udp_send(&sock, _client_buf, sizeof(_client_buf),
+                           &remote) != sizeof(_client_buf)) ||
+            (sock_udp_recv(&sock, _reply_buf, sizeof(_reply_buf),
+                           US_PER_SEC, NULL) != sizeof(_reply_buf)) ||
+            (memcmp(_client_buf, _reply_buf, sizeof(_reply_buf)) != 0)) {
+            errors++;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    sock_udp_close(&sock);
+    for (unsigned i = 0; i < stacks_numof; i++) {
+        stack_used += _stack_used(&stacks[i * THREAD_STACKSIZE_DEFAULT]);
+    }
+    printf("mode: %s, sockets: %u, echos: %u, errors: %u, "
+           "time/echo: %" PRIu32 " us, stacks: %u B, stack used: %u B\n",
+           mode, TEST_SOCKETS, TEST_ROUNDS * TEST_SOCKETS, errors,
+           duration / (TEST_ROUNDS * TEST_SOCKETS),
+           stacks_numof * THREAD_STACKSIZE_DEFAULT, stack_used);
+    return errors;
+}
+
+int main(void)
+{
+    unsigned errors = 0;
+
+    for (unsigned i = 0; i < sizeof(_client_buf); i++) {
+        _client_buf[i] = (uint8_t)i;
+    }
+
+    for (unsigned i = 0; i < TEST_SOCKETS; i++) {
+        int fd = _server_socket(TEST_PORT_THREADS + i);
+
+        if (fd < 0) {
+            puts("[FAILED] unable to create socket");
+            return 1;
+        }
+        thread_create(_thread_stacks[i], sizeof(_thread_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                      _thread_server, (void *)(intptr_t)fd, "echo");
+    }
+    errors += _bench("threads", TEST_PORT_THREADS, &_thread_stacks[0][0],
+                     TEST_SOCKETS);
+
+    for (unsigned i = 0; i < TEST_SOCKETS; i++) {
+        if ((_poll_fds[i] = _server_socket(TEST_PORT_POLL + i)) < 0) {
+            puts("[FAILED] unable to create socket");
+            return 1;
+        }
+    }
+    thread_create(_poll_stack, sizeof(_poll_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _poll_server, NULL, "echo_poll");
+    errors += _bench("poll", TEST_PORT_POLL, _poll_stack, 1);
+
+    if (errors) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
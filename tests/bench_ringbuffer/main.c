@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of tsrb and ringbuffer when moving
+ *              bytes one by one and in bulk
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "ringbuffer.h"
+#include "tsrb.h"
+#include "xtimer.h"
+
+#define TEST_BUF_SIZE       (256U)
+#define TEST_CHUNK_MAX      (200U)
+
+#ifndef TEST_BYTES
+#define TEST_BYTES          (64U * 1024U)
+#endif
+
+static uint8_t _buf[TEST_BUF_SIZE];
+static uint8_t _src[TEST_CHUNK_MAX];
+static uint8_t _dst[TEST_CHUNK_MAX];
+
+static tsrb_t _tsrb;
+static ringbuffer_t _rb;
+
+/* what tsrb_add() and tsrb_get() did before they copied in bulk */
+static void _tsrb_byte(unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        tsrb_add_one(&_tsrb, _src[i]);
+    }
+    for (unsigned i = 0; i < n; i++) {
+        _dst[i] = tsrb_get_one(&_tsrb);
+    }
+}
+
+static void _tsrb_bulk(unsigned n)
+{
+    tsrb_add(&_tsrb, _src, n);
+    tsrb_get(&_tsrb, _dst, n);
+}
+
+/* what ringbuffer_add() did before it copied in bulk */
+static void _rb_byte(unsigned n)
+{
+    for (unsigned i = 0; (i < n) && !ringbuffer_full(&_rb); i++) {
+        ringbuffer_add_one(&_rb, _src[i]);
+    }
+    for (unsigned i = 0; i < n; i++) {
+        _dst[i] = ringbuffer_get_one(&_rb);
+    }
+}
+
+static void _rb_bulk(unsigned n)
+{
+    ringbuffer_add(&_rb, (char *)_src, n);
+    ringbuffer_get(&_rb, (char *)_dst, n);
+}
+
+static uint32_t _measure(void (*xfer)(unsigned), unsigned chunk,
+                         unsigned *errors)
+{
+    tsrb_init(&_tsrb, _buf, sizeof(_buf));
+    ringbuffer_init(&_rb, (char *)_buf, sizeof(_buf));
+    memset(_dst, 0, sizeof(_dst));
+
+    uint32_t start = xtimer_now_usec();
+
+    /* the chunks wander through the buffer, so some wrap around its end */
+    for (unsigned i = 0; i < (TEST_BYTES / chunk); i++) {
+        xfer(chunk);
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+
+    if (memcmp(_dst, _src, chunk) != 0) {
+        (*errors)++;
+    }
+    return duration;
+}
+
+int main(void)
+{
+    static const unsigned chunks[] = { 1, 8, 64, TEST_CHUNK_MAX };
+    unsigned errors = 0;
+
+    for (unsigned i = 0; i < sizeof(_src); i++) {
+        _src[i] = i;
+    }
+
+    printf("ringbuffer throughput benchmark, %u bytes per run\n", TEST_BYTES);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(chunks); i++) {
+        uint32_t byte = _measure(_tsrb_byte, chunks[i], &errors);
+        uint32_t bulk = _measure(_tsrb_bulk, chunks[i], &errors);
+
+        printf("tsrb       chunk: %3u, byte: %8" PRIu32 " us, "
+               "bulk: %8" PRIu32 " us\n", chunks[i], byte, bulk);
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(chunks); i++) {
+        uint32_t byte = _measure(_rb_byte, chunks[i], &errors);
+        uint32_t bulk = _measure(_rb_bulk, chunks[i], &errors);
+
+        printf("ringbuffer chunk: %3u, byte: %8" PRIu32 " us, "
+               "bulk: %8" PRIu32 " us\n", chunks[i], byte, bulk);
+    }
+
+    if (errors) {
+        printf("%u runs returned wrong data\n", errors);
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for name in ("tsrb", "ringbuffer"):
+        for chunk in (1, 8, 64, 200):
+            child.expect(r"{}\s+chunk:\s+{}, byte:\s+\d+ us, "
+                         r"bulk:\s+\d+ us".format(name, chunk))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of the schedstatistics scheduler hook and
+ *              checks the switch accounting
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "irq.h"
+#include "schedstatistics.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#ifndef TEST_HOOK_CALLS
+#define TEST_HOOK_CALLS     (10000U)
+#endif
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+static volatile unsigned _flag = 0;
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static void *_second_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_wait_any(0x1);
+    }
+
+    return NULL;
+}
+
+/* average cost of one call of the hook in ns */
+static uint32_t _hook_cost(void)
+{
+    kernel_pid_t pid = thread_getpid();
+    unsigned state = irq_disable();
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_HOOK_CALLS; i++) {
+        sched_statistics_cb(pid, pid);
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+    irq_restore(state);
+
+    return (uint32_t)(((uint64_t)duration * 1000) / TEST_HOOK_CALLS);
+}
+
+int main(void)
+{
+    schedstat_t main_stat, second_stat;
+
+    printf("schedstatistics benchmark, %" PRIu32 " ticks per second\n",
+           schedstat_ticks_per_sec());
+    printf("{ \"hook_ns\" : %" PRIu32 " }\n", _hook_cost());
+
+    kernel_pid_t other = thread_create(_stack, sizeof(_stack),
+                                       (THREAD_PRIORITY_MAIN - 1),
+                                       THREAD_CREATE_STACKTEST,
+                                       _second_thread, NULL, "second_thread");
+    thread_t *tcb = (thread_t *)sched_threads[other];
+
+    xtimer_t timer = { .callback = _timer_callback };
+    uint32_t n = 0;
+
+    /* every flag wakes the higher priority thread, which blocks again */
+    schedstat_reset();
+    xtimer_set(&timer, TEST_DURATION);
+    while (!_flag) {
+        thread_flags_set(tcb, 0x1);
+        n++;
+    }
+    schedstat_get(thread_getpid(), &main_stat);
+    schedstat_get(other, &second_stat);
+
+    uint32_t latency = (uint32_t)(((uint64_t)second_stat.max_latency *
+                                   US_PER_SEC) / schedstat_ticks_per_sec());
+    printf("{ \"result\" : %" PRIu32 ", \"voluntary\" : %u, "
+           "\"involuntary\" : %u, \"max_latency_us\" : %" PRIu32 " }\n",
+           n, second_stat.voluntary, main_stat.involuntary, latency);
+
+    /* the second thread blocks after every flag, main is preempted by it;
+     * the timer interrupt may add a preemption */
+    if ((second_stat.voluntary < n) || (main_stat.involuntary < n)) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures UDP echo round trips over the loopback address with
+ *              copying and zero-copy sock_udp receive and send
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "kernel_defines.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_ECHOS
+#define TEST_ECHOS          (1000U)
+#endif
+
+#define TEST_PORT_COPY      (7001U)
+#define TEST_PORT_ZEROCOPY  (7002U)
+#define TEST_BUF_SIZE       (1024U)
+
+static char _copy_stack[THREAD_STACKSIZE_DEFAULT];
+static char _zerocopy_stack[THREAD_STACKSIZE_DEFAULT];
+
+static uint8_t _server_buf[TEST_BUF_SIZE];
+static uint8_t _client_buf[TEST_BUF_SIZE];
+static uint8_t _reply_buf[TEST_BUF_SIZE];
+
+/* echo server, that copies each request into its own buffer */
+static void *_copy_server(void *arg)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = TEST_PORT_COPY };
+    sock_udp_t sock;
+
+    (void)arg;
+    sock_udp_create(&sock, &local, NULL, 0);
+    while (1) {
+        sock_udp_ep_t remote;
+        ssize_t res = sock_udp_recv(&sock, _server_buf, sizeof(_server_buf),
+                                    SOCK_NO_TIMEOUT, &remote);
+        if (res >= 0) {
+            sock_udp_send(&sock, _server_buf, res, &remote);
+        }
+    }
+    return NULL;
+}
+
+/* echo server, that sends the request back out of the packet buffer */
+static void *_zerocopy_server(void *arg)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = TEST_PORT_ZEROCOPY };
+    sock_udp_t sock;
+
+    (void)arg;
+    sock_udp_create(&sock, &local, NULL, 0);
+    while (1) {
+        sock_udp_ep_t remote;
+        void *data = NULL, *ctx = NULL;
+        ssize_t res = sock_udp_recv_buf(&sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                        &remote);
+        if (res >= 0) {
+            iolist_t payload = { NULL, data, res };
+            sock_udp_sendv(&sock, &payload, &remote);
+            /* release the received packet */
+            sock_udp_recv_buf(&sock, &data, &ctx, 0, NULL);
+        }
+    }
+    return NULL;
+}
+
+/* returns the average round trip time in usec, 0 on error */
+static uint32_t _measure(sock_udp_t *sock, size_t len)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_ECHOS; i++) {
+        _client_buf[0] = (uint8_t)i;
+        if ((sock_udp_send(sock, _client_buf, len, NULL) != (ssize_t)len) ||
+            (sock_udp_recv(sock, _reply_buf, sizeof(_reply_buf),
+                           US_PER_SEC, NULL) != (ssize_t)len) ||
+            (memcmp(_client_buf, _reply_buf, len) != 0)) {
+            return 0;
+        }
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+    return (duration + (TEST_ECHOS / 2)) / TEST_ECHOS;
+}
+
+static unsigned _bench(size_t len)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6 };
+    sock_udp_t sock;
+    uint32_t copy, zerocopy;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+    remote.port = TEST_PORT_COPY;
+    sock_udp_create(&sock, NULL, &remote, 0);
+    copy = _measure(&sock, len);
+    sock_udp_close(&sock);
+
+    remote.port = TEST_PORT_ZEROCOPY;
+    sock_udp_create(&sock, NULL, &remote, 0);
+    zerocopy = _measure(&sock, len);
+    sock_udp_close(&sock);
+
+    printf("len: %4u, copy: %5" PRIu32 " us, zero-copy: %5" PRIu32 " us\n",
+           (unsigned)len, copy, zerocopy);
+
+    return (copy == 0) || (zerocopy == 0);
+}
+
+int main(void)
+{
+    static const size_t lens[] = { 16, 64, 256, TEST_BUF_SIZE };
+    unsigned errors = 0;
+
+    printf("UDP echo benchmark, %u echos per run\n", TEST_ECHOS);
+
+    for (unsigned i = 0; i < sizeof(_client_buf); i++) {
+        _client_buf[i] = (uint8_t)i;
+    }
+
+    thread_create(_copy_stack, sizeof(_copy_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _copy_server, NULL, "copy");
+    thread_create(_zerocopy_stack, sizeof(_zerocopy_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _zerocopy_server, NULL, "zerocopy");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        errors += _bench(lens[i]);
+    }
+
+    if (errors) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
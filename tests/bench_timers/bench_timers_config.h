@@ -238,6 +238,21 @@ extern "C" {
 #define SPIN_MAX_TARGET 16
 #endif
 
+/* Largest number of pending timers in the xtimer load test, the test is
+ * disabled by default as the pending timers need a lot of RAM */
+#ifndef TEST_LOAD_MAX
+#define TEST_LOAD_MAX 0
+#endif
+/* Number of set/remove calls averaged per pending timer count */
+#ifndef TEST_LOAD_PROBES
+#define TEST_LOAD_PROBES 256
+#endif
+/* Load test timers are spread over [TEST_LOAD_WINDOW, 2 * TEST_LOAD_WINDOW]
+ * TUT ticks into the future */
+#ifndef TEST_LOAD_WINDOW
+#define TEST_LOAD_WINDOW (TIM_TEST_FREQ)
+#endif
+
 /* estimate_cpu_overhead will loop for this many iterations to get a proper estimate */
 #define ESTIMATE_CPU_ITERATIONS 2048
 
@@ -42,6 +42,7 @@
 
 #include "print_results.h"
 #include "spin_random.h"
+#include "xtimer_load.h"
 #include "bench_timers_config.h"
 
 #ifndef TEST_TRACE
@@ -737,6 +738,9 @@ int main(void)
     print_u32_dec(spin_max);
     print("\n", 1);
     estimate_cpu_overhead();
+#if TEST_XTIMER
+    xtimer_load_run();
+#endif
 #ifdef MODULE_PERIPH_RTT
     rtt_begin = rtt_get_counter();
 #endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer cost measurements with many pending timers
+ *
+ * Measures how the cost of setting and removing a timer, and the latency of
+ * firing timers, scales with the number of timers pending in xtimer.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "fmt.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "random.h"
+#include "periph/timer.h"
+
+#include "bench_timers_config.h"
+#include "xtimer_load.h"
+
+#if TEST_XTIMER && TEST_LOAD_MAX
+
+static xtimer_t load_timers[TEST_LOAD_MAX];
+static uint32_t load_targets[TEST_LOAD_MAX];
+
+static mutex_t load_mtx = MUTEX_INIT_LOCKED;
+static volatile unsigned load_fired;
+static unsigned load_num;
+static uint64_t late_sum;
+static uint32_t late_max;
+
+static void cb_nop(void *arg)
+{
+    (void)arg;
+}
+
+static void cb_load(void *arg)
+{
+    uint32_t late = READ_TUT() - *((uint32_t *)arg);
+
+    late_sum += late;
+    if (late > late_max) {
+        late_max = late;
+    }
+    if (++load_fired == load_num) {
+        mutex_unlock(&load_mtx);
+    }
+}
+
+/* random offset inside the load window */
+static uint32_t load_offset(void)
+{
+    return random_uint32_range(TEST_LOAD_WINDOW, 2 * TEST_LOAD_WINDOW);
+}
+
+static void load_set_remove(unsigned num)
+{
+    xtimer_t probe = { .callback = cb_nop };
+    uint32_t set_sum = 0;
+    uint32_t remove_sum = 0;
+
+    for (unsigned k = 0; k < num; ++k) {
+        load_timers[k].callback = cb_nop;
+        load_timers[k].arg = NULL;
+        _xtimer_set(&load_timers[k], load_offset());
+    }
+
+    for (unsigned k = 0; k < TEST_LOAD_PROBES; ++k) {
+        uint32_t offset = load_offset();
+        uint32_t begin = timer_read(TIM_REF_DEV);
+        _xtimer_set(&probe, offset);
+        uint32_t mid = timer_read(TIM_REF_DEV);
+        xtimer_remove(&probe);
+        uint32_t end = timer_read(TIM_REF_DEV);
+        set_sum += mid - begin;
+        remove_sum += end - mid;
+    }
+
+    for (unsigned k = 0; k < num; ++k) {
+        xtimer_remove(&load_timers[k]);
+    }
+
+    print_str("set = ");
+    print_u32_dec(set_sum / TEST_LOAD_PROBES);
+    print_str(", remove = ");
+    print_u32_dec(remove_sum / TEST_LOAD_PROBES);
+}
+
+static void load_fire(unsigned num)
+{
+    load_fired = 0;
+    load_num = num;
+    late_sum = 0;
+    late_max = 0;
+
+    for (unsigned k = 0; k < num; ++k) {
+        load_targets[k] = READ_TUT() + load_offset();
+        load_timers[k].callback = cb_load;
+        load_timers[k].arg = &load_targets[k];
+        _xtimer_set_absolute(&load_timers[k], load_targets[k]);
+    }
+
+    /* unlocked by the last callback */
+    mutex_lock(&load_mtx);
+
+    print_str(", fire latency mean = ");
+    print_u32_dec(late_sum / num);
+    print_str(", max = ");
+    print_u32_dec(late_max);
+}
+
+void xtimer_load_run(void)
+{
+    static const unsigned counts[] = { 10, 100, 1000 };
+
+    print_str("xtimer load test, TEST_LOAD_PROBES = ");
+    print_u32_dec(TEST_LOAD_PROBES);
+    print_str(", set/remove cost in reference ticks, latency in TUT ticks\n");
+
+    for (unsigned k = 0; k < ARRAY_SIZE(counts); ++k) {
+        if (counts[k] > TEST_LOAD_MAX) {
+            break;
+        }
+        print_str("pending timers = ");
+        print_u32_dec(counts[k]);
+        print_str(": ");
+        load_set_remove(counts[k]);
+        load_fire(counts[k]);
+        print("\n", 1);
+    }
+}
+
+#else /* TEST_XTIMER && TEST_LOAD_MAX */
+
+void xtimer_load_run(void)
+{
+}
+
+#endif /* TEST_XTIMER && TEST_LOAD_MAX */
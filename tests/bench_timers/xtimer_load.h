@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer cost measurements with many pending timers
+ *
+ * @}
+ */
+
+#ifndef XTIMER_LOAD_H
+#define XTIMER_LOAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Measure xtimer set/remove/fire cost with 10, 100 and 1000 pending
+ *          timers and print the results
+ *
+ * Only counts up to TEST_LOAD_MAX are measured, nothing is done if
+ * TEST_LOAD_MAX is 0 (the default).
+ *
+ * @pre The reference timer must be initialized
+ */
+void xtimer_load_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XTIMER_LOAD_H */
+/** @} */
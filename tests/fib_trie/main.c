@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the lookups of the FIB prefix trie with a linear
+ *              longest prefix match over the same routes
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/fib.h"
+
+#define TEST_ROUTES_NUMOF   (128U)
+#define TEST_LOOKUPS        (2000U)
+#define TEST_ADDR_SIZE      (16U)
+#define TEST_IFACE          (5)
+
+/* a route of the reference table */
+typedef struct {
+    uint8_t addr[TEST_ADDR_SIZE];
+    unsigned prefix_len;    /* TEST_ADDR_SIZE * 8 for host routes */
+    bool prefix;            /* added with a prefix length */
+    bool used;
+} test_route_t;
+
+static fib_entry_t _entries[TEST_ROUTES_NUMOF];
+static fib_table_t _table = {
+    .data.entries = _entries,
+    .table_type = FIB_TABLE_TYPE_SH,
+    .size = TEST_ROUTES_NUMOF,
+    .mtx_access = MUTEX_INIT,
+};
+
+/* in the order the routes were added, so ties go to the lower index */
+static test_route_t _routes[TEST_ROUTES_NUMOF];
+static unsigned _routes_numof;
+static uint32_t _seed;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, the sequence must not depend on the random module */
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+static void _rand_bytes(uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)_rand();
+    }
+}
+
+static void _mask(uint8_t *addr, unsigned prefix_len)
+{
+    for (unsigned i = 0; i < TEST_ADDR_SIZE; i++) {
+        if (prefix_len >= ((i + 1) * 8)) {
+            continue;
+        }
+        addr[i] &= (prefix_len > (i * 8)) ? (0xff << (8 - (prefix_len - (i * 8))))
+                                          : 0;
+    }
+}
+
+static bool _covers(const test_route_t *route, const uint8_t *dst)
+{
+    uint8_t tmp[TEST_ADDR_SIZE];
+    uint8_t key[TEST_ADDR_SIZE];
+
+    memcpy(tmp, dst, sizeof(tmp));
+    memcpy(key, route->addr, sizeof(key));
+    _mask(tmp, route->prefix_len);
+    _mask(key, route->prefix_len);
+    return memcmp(tmp, key, sizeof(tmp)) == 0;
+}
+
+/* the linear search the trie must agree with: an exact address wins,
+ * otherwise the longest covering prefix, the first route added on ties */
+static int _linear_lookup(const uint8_t *dst)
+{
+    int best = -1;
+
+    for (unsigned i = 0; i < _routes_numof; i++) {
+        if (_routes[i].used &&
+            (memcmp(_routes[i].addr, dst, TEST_ADDR_SIZE) == 0)) {
+            return i;
+        }
+    }
+    for (unsigned i = 0; i < _routes_numof; i++) {
+        const test_route_t *route = &_routes[i];
+
+        if (!route->used || !route->prefix || !_covers(route, dst)) {
+            continue;
+        }
+        if ((best < 0) || (route->prefix_len > _routes[best].prefix_len)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+static bool _is_unspecified(const uint8_t *addr)
+{
+    for (unsigned i = 0; i < TEST_ADDR_SIZE; i++) {
+        if (addr[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _next_hop(unsigned idx, uint8_t *next_hop)
+{
+    memset(next_hop, 0, TEST_ADDR_SIZE);
+    next_hop[0] = 0xfe;
+    next_hop[1] = 0x80;
+    next_hop[14] = (uint8_t)((idx + 1) >> 8);
+    next_hop[15] = (uint8_t)(idx + 1);
+}
+
+/* returns -EEXIST if a route with the same address exists, the FIB would
+ * update that route instead of adding one */
+static int _add(const uint8_t *addr, unsigned prefix_len, bool prefix)
+{
+    test_route_t *route = &_routes[_routes_numof];
+    uint8_t next_hop[TEST_ADDR_SIZE];
+
+    for (unsigned i = 0; i < _routes_numof; i++) {
+        if (_routes[i].used &&
+            (memcmp(_routes[i].addr, addr, TEST_ADDR_SIZE) == 0)) {
+            return -EEXIST;
+        }
+    }
+    memcpy(route->addr, addr, TEST_ADDR_SIZE);
+    /* the unspecified address is the default route either way */
+    route->prefix = prefix || _is_unspecified(addr);
+    route->prefix_len = route->prefix ? prefix_len : (TEST_ADDR_SIZE * 8);
+    route->used = true;
+    _next_hop(_routes_numof, next_hop);
+    _routes_numof++;
+    return fib_add_entry(&_table, TEST_IFACE, route->addr, TEST_ADDR_SIZE,
+                         prefix ? (prefix_len << FIB_FLAG_NET_PREFIX_SHIFT) : 0,
+                         next_hop, TEST_ADDR_SIZE, 0,
+                         (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+}
+
+static void _remove(unsigned idx)
+{
+    fib_remove_entry(&_table, _routes[idx].addr, TEST_ADDR_SIZE);
+    _routes[idx].used = false;
+}
+
+static void _check(const uint8_t *dst)
+{
+    uint8_t dst_cpy[TEST_ADDR_SIZE];
+    uint8_t next_hop[TEST_ADDR_SIZE];
+    uint8_t exp_next_hop[TEST_ADDR_SIZE];
+    size_t next_hop_size = sizeof(next_hop);
+    uint32_t next_hop_flags;
+    kernel_pid_t iface = KERNEL_PID_UNDEF;
+    int exp = _linear_lookup(dst);
+
+    memcpy(dst_cpy, dst, sizeof(dst_cpy));
+    int res = fib_get_next_hop(&_table, &iface, next_hop, &next_hop_size,
+                               &next_hop_flags, dst_cpy, sizeof(dst_cpy), 0);
+    if (exp < 0) {
+        TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, res);
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(TEST_IFACE, iface);
+    TEST_ASSERT_EQUAL_INT(TEST_ADDR_SIZE, next_hop_size);
+    _next_hop(exp, exp_next_hop);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp_next_hop, next_hop, TEST_ADDR_SIZE));
+}
+
+/* a destination covered by a random route, at its address or random */
+static void _rand_dst(uint8_t *dst)
+{
+    unsigned idx = _rand() % _routes_numof;
+
+    _rand_bytes(dst, TEST_ADDR_SIZE);
+    switch (_rand() % 4) {
+    case 0:
+        /* somewhere, most likely only covered by the default route */
+        break;
+    case 1:
+        memcpy(dst, _routes[idx].addr, TEST_ADDR_SIZE);
+        break;
+    default:
+        for (unsigned i = 0; i < TEST_ADDR_SIZE; i++) {
+            unsigned bits = _routes[idx].prefix_len;
+            if (bits >= ((i + 1) * 8)) {
+                dst[i] = _routes[idx].addr[i];
+            }
+            else if (bits > (i * 8)) {
+                uint8_t mask = 0xff << (8 - (bits - (i * 8)));
+                dst[i] = (_routes[idx].addr[i] & mask) | (dst[i] & ~mask);
+            }
+        }
+        break;
+    }
+}
+
+/* nested prefixes below 2001:db8::/32, some host routes */
+static void _add_random_routes(unsigned num)
+{
+    static const uint8_t base[] = { 0x20, 0x01, 0x0d, 0xb8 };
+
+    while (num > 0) {
+        uint8_t addr[TEST_ADDR_SIZE];
+        unsigned prefix_len = 32 + (_rand() % 97);
+        bool prefix = (_rand() % 8) != 0;
+
+        _rand_bytes(addr, sizeof(addr));
+        /* few distinct bits, so that many prefixes are nested */
+        for (unsigned i = 4; i < TEST_ADDR_SIZE; i++) {
+            addr[i] &= 0x81;
+        }
+        memcpy(addr, base, sizeof(base));
+        if (prefix) {
+            _mask(addr, prefix_len);
+        }
+        int res = _add(addr, prefix_len, prefix);
+        if (res != -EEXIST) {
+            TEST_ASSERT_EQUAL_INT(0, res);
+            num--;
+        }
+    }
+}
+
+static void set_up(void)
+{
+    fib_init(&_table);
+    memset(_routes, 0, sizeof(_routes));
+    _routes_numof = 0;
+    _seed = 0x20190815;
+}
+
+static void tear_down(void)
+{
+    fib_deinit(&_table);
+}
+
+static void test_fib_trie__empty(void)
+{
+    const uint8_t dst[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 1 };
+
+    _check(dst);
+}
+
+static void test_fib_trie__default_and_host_route(void)
+{
+    const uint8_t def[TEST_ADDR_SIZE] = { 0 };
+    const uint8_t host[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, [15] = 1 };
+    uint8_t dst[TEST_ADDR_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, _add(def, 0, false));
+    TEST_ASSERT_EQUAL_INT(0, _add(host, 0, false));
+    _check(host);
+    _check(def);
+    /* the host route does not match as a prefix */
+    memcpy(dst, host, sizeof(dst));
+    dst[15] = 2;
+    _check(dst);
+    TEST_ASSERT_EQUAL_INT(0, _linear_lookup(dst));
+}
+
+static void test_fib_trie__nested(void)
+{
+    const uint8_t p32[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8 };
+    const uint8_t p48[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0, 1 };
+    const uint8_t p47[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0, 2 };
+    uint8_t dst[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0, 1, [15] = 9 };
+
+    TEST_ASSERT_EQUAL_INT(0, _add(p32, 32, true));
+    TEST_ASSERT_EQUAL_INT(0, _add(p48, 48, true));
+    TEST_ASSERT_EQUAL_INT(0, _add(p47, 47, true));
+    _check(dst);
+    TEST_ASSERT_EQUAL_INT(1, _linear_lookup(dst));
+    dst[5] = 3;     /* within 2001:db8:2::/47 */
+    _check(dst);
+    TEST_ASSERT_EQUAL_INT(2, _linear_lookup(dst));
+    dst[5] = 4;
+    _check(dst);
+    TEST_ASSERT_EQUAL_INT(0, _linear_lookup(dst));
+    _remove(0);
+    _check(dst);
+    TEST_ASSERT_EQUAL_INT(-1, _linear_lookup(dst));
+}
+
+/* two /48 routes whose addresses differ only beyond the prefix */
+static void test_fib_trie__longest_prefix_tie(void)
+{
+    const uint8_t a[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0, 1 };
+    const uint8_t b[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0, 1, 0, 0xff };
+    const uint8_t p32[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8 };
+    const uint8_t dst[TEST_ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0, 1,
+                                          [15] = 0x42 };
+
+    TEST_ASSERT_EQUAL_INT(0, _add(p32, 32, true));
+    TEST_ASSERT_EQUAL_INT(0, _add(a, 48, true));
+    TEST_ASSERT_EQUAL_INT(0, _add(b, 48, true));
+    _check(dst);
+    TEST_ASSERT_EQUAL_INT(1, _linear_lookup(dst));
+    /* the exact address still wins over its tie */
+    _check(b);
+    TEST_ASSERT_EQUAL_INT(2, _linear_lookup(b));
+    _remove(1);
+    _check(dst);
+    TEST_ASSERT_EQUAL_INT(2, _linear_lookup(dst));
+    _remove(2);
+    _check(dst);
+    TEST_ASSERT_EQUAL_INT(0, _linear_lookup(dst));
+}
+
+static void test_fib_trie__random(void)
+{
+    const uint8_t def[TEST_ADDR_SIZE] = { 0 };
+    uint8_t dst[TEST_ADDR_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, _add(def, 0, true));
+    _add_random_routes(TEST_ROUTES_NUMOF - 1);
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        _rand_dst(dst);
+        _check(dst);
+    }
+}
+
+static void test_fib_trie__random_remove(void)
+{
+    uint8_t dst[TEST_ADDR_SIZE];
+
+    _add_random_routes(TEST_ROUTES_NUMOF);
+    for (unsigned i = 0; i < TEST_ROUTES_NUMOF; i += 2) {
+        _remove(i);
+    }
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        _rand_dst(dst);
+        _check(dst);
+    }
+    for (unsigned i = 1; i < TEST_ROUTES_NUMOF; i += 2) {
+        _remove(i);
+    }
+    for (unsigned i = 0; i < (TEST_LOOKUPS / 10); i++) {
+        _rand_dst(dst);
+        _check(dst);
+    }
+}
+
+static Test *tests_fib_trie(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_fib_trie__empty),
+        new_TestFixture(test_fib_trie__default_and_host_route),
+        new_TestFixture(test_fib_trie__nested),
+        new_TestFixture(test_fib_trie__longest_prefix_tie),
+        new_TestFixture(test_fib_trie__random),
+        new_TestFixture(test_fib_trie__random_remove),
+    };
+
+    EMB_UNIT_TESTCALLER(fib_trie_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&fib_trie_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_fib_trie());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for the block pools of the `gnrc_pktbuf_slab` module
+ *
+ * The generic packet buffer behavior is tested by the `tests-pktbuf`
+ * unittests, these tests cover what differs from `gnrc_pktbuf_static`.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
+
+#define TEST_STRING4    "J&(d"
+#define TEST_STRING8    "Y3gf,h7w"
+#define TEST_STRING16   "2*F?6@!Od\"g$(%#"
+
+static void test_pktbuf_slab_add__success(void)
+{
+    gnrc_pktsnip_t *pkts[GNRC_PKTBUF_SLAB_MEDIUM_NUMOF];
+
+    /* snips and data come from separate pools, so all medium blocks can be
+     * used */
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        pkts[i] = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_MEDIUM_SIZE,
+                                  GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+        TEST_ASSERT_NULL(pkts[i]->next);
+        TEST_ASSERT_NOT_NULL(pkts[i]->data);
+        TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SLAB_MEDIUM_SIZE, pkts[i]->size);
+        TEST_ASSERT_EQUAL_INT(1, pkts[i]->users);
+        memset(pkts[i]->data, i, pkts[i]->size);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        uint8_t *data = pkts[i]->data;
+
+        TEST_ASSERT_EQUAL_INT(i, data[0]);
+        TEST_ASSERT_EQUAL_INT(i, data[GNRC_PKTBUF_SLAB_MEDIUM_SIZE - 1]);
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__larger_block(void)
+{
+    gnrc_pktsnip_t *pkts[GNRC_PKTBUF_SLAB_SMALL_NUMOF];
+    gnrc_pktsnip_t *pkt;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        pkts[i] = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                                  GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    /* all small blocks are used, so a medium one is taken */
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, pkt->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__memfull(void)
+{
+    gnrc_pktsnip_t *pkts[GNRC_PKTBUF_SLAB_LARGE_NUMOF];
+
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL,
+                                     GNRC_PKTBUF_SLAB_LARGE_SIZE + 1,
+                                     GNRC_NETTYPE_TEST));
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        pkts[i] = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_LARGE_SIZE,
+                                  GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL,
+                                     GNRC_PKTBUF_SLAB_MEDIUM_SIZE + 1,
+                                     GNRC_NETTYPE_TEST));
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_merge_data__memfull(void)
+{
+    /* the merged data does not fit into the largest block */
+    const size_t size = GNRC_PKTBUF_SLAB_LARGE_SIZE / 2;
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    pkt = gnrc_pktbuf_add(pkt, NULL, size + 1, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(ENOMEM, gnrc_pktbuf_merge(pkt));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_reverse_snips__too_full(void)
+{
+    gnrc_pktsnip_t *pkt, *pkt_next, *pkt_full, *tmp;
+
+    pkt_next = gnrc_pktbuf_add(NULL, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt_next);
+    /* hold to enforce duplication */
+    gnrc_pktbuf_hold(pkt_next, 1);
+    pkt = gnrc_pktbuf_add(pkt_next, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* duplicating pkt_next needs a snip, so use all of them up */
+    pkt_full = gnrc_pktbuf_add(NULL, NULL, 0, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt_full);
+    while ((tmp = gnrc_pktbuf_add(pkt_full, NULL, 0, GNRC_NETTYPE_UNDEF))) {
+        pkt_full = tmp;
+    }
+    TEST_ASSERT_NULL(gnrc_pktbuf_reverse_snips(pkt));
+    gnrc_pktbuf_release(pkt_full);
+    /* release because of hold above */
+    gnrc_pktbuf_release(pkt_next);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add_header__headroom(void)
+{
+    gnrc_pktsnip_t *hdr1, *hdr2;
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16,
+                                                   sizeof(TEST_STRING16), 12,
+                                                   GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+    TEST_ASSERT_EQUAL_INT(12, gnrc_pktbuf_headroom(pkt));
+    hdr1 = gnrc_pktbuf_add_header(pkt, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr1);
+    hdr2 = gnrc_pktbuf_add_header(hdr1, TEST_STRING4, 4, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr2);
+    TEST_ASSERT(hdr1->next == pkt);
+    TEST_ASSERT(hdr2->next == hdr1);
+    /* headers were put directly in front of the payload */
+    TEST_ASSERT(((uint8_t *)hdr1->data + 8) == pkt->data);
+    TEST_ASSERT(((uint8_t *)hdr2->data + 4) == hdr1->data);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_headroom(hdr2));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING8, hdr1->data, 8));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING4, hdr2->data, 4));
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    /* releasing the headers gives their space back */
+    hdr2->next = NULL;
+    gnrc_pktbuf_release(hdr2);
+    hdr1->next = NULL;
+    gnrc_pktbuf_release(hdr1);
+    TEST_ASSERT_EQUAL_INT(12, gnrc_pktbuf_headroom(pkt));
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__no_headroom(void)
+{
+    gnrc_pktsnip_t *hdr;
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16,
+                                                   sizeof(TEST_STRING16), 12,
+                                                   GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* only headers added with gnrc_pktbuf_add_header() use the headroom */
+    hdr = gnrc_pktbuf_add(pkt, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT(((uint8_t *)hdr->data + 8) != pkt->data);
+    TEST_ASSERT_EQUAL_INT(12, gnrc_pktbuf_headroom(pkt));
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add_headroom__capped(void)
+{
+    gnrc_pktsnip_t *pkts[GNRC_PKTBUF_SLAB_LARGE_NUMOF + 1];
+    const size_t size = GNRC_PKTBUF_SLAB_MEDIUM_SIZE - 8;
+
+    /* more payloads than there are large blocks, the headroom must not push
+     * them out of the medium blocks */
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        pkts[i] = gnrc_pktbuf_add_headroom(NULL, NULL, size,
+                                           GNRC_PKTBUF_TX_HEADROOM,
+                                           GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+        TEST_ASSERT_EQUAL_INT(8, gnrc_pktbuf_headroom(pkts[i]));
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < ARRAY_SIZE(pkts); i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_pktbuf_slab(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_slab_add__success),
+        new_TestFixture(test_pktbuf_slab_add__larger_block),
+        new_TestFixture(test_pktbuf_slab_add__memfull),
+        new_TestFixture(test_pktbuf_slab_merge_data__memfull),
+        new_TestFixture(test_pktbuf_slab_reverse_snips__too_full),
+        new_TestFixture(test_pktbuf_slab_add_header__headroom),
+        new_TestFixture(test_pktbuf_slab_add__no_headroom),
+        new_TestFixture(test_pktbuf_slab_add_headroom__capped),
+    };
+
+    EMB_UNIT_TESTCALLER(pktbuf_slab_tests, gnrc_pktbuf_init, NULL, fixtures);
+
+    return (Test *)&pktbuf_slab_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_pktbuf_slab());
+    TESTS_END();
+
+    return 0;
+}
@@ -236,10 +236,17 @@ static void _test_entry(const gnrc_sixlowpan_rbuf_t *entry,
                         "entry->super.dst != TEST_NETIF_HDR_DST");
     TEST_ASSERT_EQUAL_INT(TEST_TAG, entry->super.tag);
     TEST_ASSERT_EQUAL_INT(exp_current_size, entry->super.current_size);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+    /* received fragments are tracked in the hash index, not in intervals */
+    (void)exp_int_start;
+    (void)exp_int_end;
+    TEST_ASSERT_NULL(entry->super.ints);
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
     TEST_ASSERT_NOT_NULL(entry->super.ints);
     TEST_ASSERT_NULL(entry->super.ints->next);
     TEST_ASSERT_EQUAL_INT(exp_int_start, entry->super.ints->start);
     TEST_ASSERT_EQUAL_INT(exp_int_end, entry->super.ints->end);
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 }
 
 static void _check_pktbuf(const gnrc_sixlowpan_rbuf_t *entry)
@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the reassembly buffer tests of tests/gnrc_sixlowpan_frag
+ *              with the `gnrc_sixlowpan_frag_rbuf_hash` module
+ *
+ * @}
+ */
+
+#include "../gnrc_sixlowpan_frag/main.c"
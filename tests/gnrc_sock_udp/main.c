@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "net/gnrc/netreg.h"
 #include "net/sock/udp.h"
 #include "xtimer.h"
 
@@ -199,6 +200,32 @@ static void test_sock_udp_create__full(void)
     assert(_TEST_PORT_REMOTE == ep.port);
 }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+static void test_sock_udp_create__ENOMEM(void)
+{
+    static sock_udp_t socks[GNRC_NETREG_HASH_SIZE];
+    sock_udp_ep_t local = { .family = AF_INET6 };
+    unsigned i;
+    int res = 0;
+
+    /* each port takes a registry slot of its own, until none is left */
+    for (i = 0; i < GNRC_NETREG_HASH_SIZE; i++) {
+        local.port = _TEST_PORT_LOCAL + i;
+        if ((res = sock_udp_create(&socks[i], &local, NULL, 0)) < 0) {
+            break;
+        }
+    }
+    assert(-ENOMEM == res);
+    /* the failed sock was not kept, so its port can be used once a slot
+     * is free again */
+    sock_udp_close(&socks[0]);
+    assert(0 == sock_udp_create(&_sock, &local, NULL, 0));
+    while (--i > 0) {
+        sock_udp_close(&socks[i]);
+    }
+}
+#endif
+
 static void test_sock_udp_recv__EADDRNOTAVAIL(void)
 {
     assert(0 == sock_udp_create(&_sock, NULL, NULL, SOCK_FLAGS_REUSE_EP));
@@ -421,6 +448,56 @@ static void test_sock_udp_recv__non_blocking(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_buf(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &result));
+    assert(data != NULL);
+    assert(ctx != NULL);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(memcmp(&result.addr, &src_addr, sizeof(result.addr)) == 0);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(_TEST_NETIF == result.netif);
+    /* packet is lent to the application until the final call */
+    assert(!_check_net());
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                  NULL));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_buf__empty(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "", 0, _TEST_NETIF));
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                  NULL));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    /* nothing is lent to the application, so the packet must be released */
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -557,6 +634,29 @@ static void test_sock_udp_send__socketed(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_sendv(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t tail = { NULL, "CD", sizeof("CD") };
+    iolist_t head = { &tail, "AB", sizeof("AB") - 1 };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    assert(sizeof("ABCD") == sock_udp_sendv(&_sock, &head, NULL));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__socketed_other_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
@@ -709,6 +809,9 @@ int main(void)
     CALL(test_sock_udp_create__only_local_reuse_ep());
     CALL(test_sock_udp_create__only_remote());
     CALL(test_sock_udp_create__full());
+#ifdef MODULE_GNRC_NETREG_HASH
+    CALL(test_sock_udp_create__ENOMEM());
+#endif
     /* sock_udp_close() is tested in tear_down() */
     /* sock_udp_get_local() is tested in sock_udp_create() tests */
     /* sock_udp_get_remote() is tested in sock_udp_create() tests */
@@ -724,6 +827,8 @@ int main(void)
     CALL(test_sock_udp_recv__unsocketed_with_remote());
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
+    CALL(test_sock_udp_recv_buf());
+    CALL(test_sock_udp_recv_buf__empty());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -734,6 +839,7 @@ int main(void)
     CALL(test_sock_udp_send__socketed_no_netif());
     CALL(test_sock_udp_send__socketed_no_local());
     CALL(test_sock_udp_send__socketed());
+    CALL(test_sock_udp_sendv());
     CALL(test_sock_udp_send__socketed_other_remote());
     CALL(test_sock_udp_send__unsocketed_no_local_no_netif());
     CALL(test_sock_udp_send__unsocketed_no_netif());
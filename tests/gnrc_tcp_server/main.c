@@ -13,6 +13,7 @@
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/netif.h"
 #include "net/gnrc/tcp.h"
+#include "xtimer.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -43,6 +44,15 @@ uint8_t stacks[CONNS][THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF];
 /* Server thread */
 void *srv_thread(void *arg);
 
+/* Print throughput of a finished transfer of NBYTE bytes */
+static void print_throughput(int tid, const char *dir, uint32_t usec)
+{
+    uint32_t bps = (usec > 0) ? (uint32_t) (((uint64_t) NBYTE * US_PER_SEC) / usec) : 0;
+
+    printf("TID=%d : %s %d Bytes in %"PRIu32" us, %"PRIu32" Bytes/s\n", tid, dir, NBYTE, usec,
+           bps);
+}
+
 int main(void)
 {
     /* Set pre-configured IP address */
@@ -121,6 +131,7 @@ void *srv_thread(void *arg)
         }
 
         /* Receive data, stop if errors were found */
+        uint32_t recv_start = xtimer_now_usec();
         for (size_t rcvd = 0; rcvd < sizeof(bufs[tid]) && ret >= 0; rcvd += ret) {
             ret = gnrc_tcp_recv(&tcb, (void *) (bufs[tid] + rcvd), sizeof(bufs[tid]) - rcvd,
                                 GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
@@ -157,6 +168,7 @@ void *srv_thread(void *arg)
                     }
               }
         }
+        uint32_t recv_usec = xtimer_now_usec() - recv_start;
 
         /* Check received pattern */
        for (size_t i = 0; i < sizeof(bufs[tid]); ++i) {
@@ -173,6 +185,7 @@ void *srv_thread(void *arg)
         }
 
         /* Send data, stop if errors were found */
+        uint32_t send_start = xtimer_now_usec();
         for (size_t sent = 0; sent < sizeof(bufs[tid]) && ret >= 0; sent += ret) {
             ret = gnrc_tcp_send(&tcb, bufs[tid] + sent, sizeof(bufs[tid]) - sent, 0);
             switch (ret) {
@@ -202,6 +215,7 @@ void *srv_thread(void *arg)
                     }
               }
         }
+        uint32_t send_usec = xtimer_now_usec() - send_start;
 
         /* Close connection */
         gnrc_tcp_close(&tcb);
@@ -214,6 +228,10 @@ void *srv_thread(void *arg)
         printf("TID=%d : %"PRIi32" test cycles completed. %"PRIi32" ok, %"PRIi32" faulty",
                tid, cycles, cycles_ok, cycles - cycles_ok);
         printf(", %"PRIi32" failed payload verifications\n", failed_payload_verifications);
+        if (ret >= 0) {
+            print_throughput(tid, "sent", send_usec);
+            print_throughput(tid, "received", recv_usec);
+        }
     }
     printf("server thread terminating: TID=%d\n", tid);
     return 0;
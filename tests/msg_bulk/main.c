@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for msg_try_send_bulk() and msg_receive_bulk()
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "msg.h"
+#include "thread.h"
+
+#define MSG_QUEUE_LENGTH    (4U)
+#define TEST_MSG_NUMOF      (10U)
+
+static msg_t _main_queue[MSG_QUEUE_LENGTH];
+static msg_t _rcv_queue[MSG_QUEUE_LENGTH];
+static char _stack[THREAD_STACKSIZE_MAIN];
+
+static msg_t _received[TEST_MSG_NUMOF];
+static unsigned _received_numof;
+static unsigned _calls;
+
+/* receives messages in bulk until TEST_MSG_NUMOF were received */
+static void _receive_all(void)
+{
+    _received_numof = 0;
+    _calls = 0;
+    while (_received_numof < TEST_MSG_NUMOF) {
+        _received_numof += msg_receive_bulk(&_received[_received_numof],
+                                            TEST_MSG_NUMOF - _received_numof);
+        _calls++;
+    }
+}
+
+static bool _check_received(kernel_pid_t sender)
+{
+    for (unsigned i = 0; i < _received_numof; i++) {
+        if ((_received[i].type != i) || (_received[i].sender_pid != sender)) {
+            printf("message %u: type %u from %d\n", i,
+                   (unsigned)_received[i].type, (int)_received[i].sender_pid);
+            return false;
+        }
+    }
+    return (_received_numof == TEST_MSG_NUMOF);
+}
+
+static void *_receiver(void *arg)
+{
+    (void)arg;
+    msg_init_queue(_rcv_queue, ARRAY_SIZE(_rcv_queue));
+    _receive_all();
+    return NULL;
+}
+
+static void *_sender(void *arg)
+{
+    kernel_pid_t target = (kernel_pid_t)(intptr_t)arg;
+
+    for (unsigned i = 0; i < TEST_MSG_NUMOF; i++) {
+        msg_t msg = { .type = i };
+
+        msg_send(&msg, target);
+    }
+    return NULL;
+}
+
+static void _init_msgs(msg_t *msgs, unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        msgs[i].type = i;
+        msgs[i].content.value = 0;
+    }
+}
+
+/* messages beyond the queue size are not sent */
+static bool test_send_bulk__queue(void)
+{
+    msg_t msgs[TEST_MSG_NUMOF];
+    msg_t rcvd[TEST_MSG_NUMOF];
+    int res;
+
+    _init_msgs(msgs, ARRAY_SIZE(msgs));
+    res = msg_try_send_bulk(msgs, ARRAY_SIZE(msgs), thread_getpid());
+    if ((res != MSG_QUEUE_LENGTH) || (msg_avail() != MSG_QUEUE_LENGTH)) {
+        printf("sent %d, queued %d\n", res, msg_avail());
+        return false;
+    }
+    res = msg_receive_bulk(rcvd, ARRAY_SIZE(rcvd));
+    if ((res != MSG_QUEUE_LENGTH) || (msg_avail() != 0)) {
+        printf("received %d, left %d\n", res, msg_avail());
+        return false;
+    }
+    for (unsigned i = 0; i < MSG_QUEUE_LENGTH; i++) {
+        if ((rcvd[i].type != i) || (rcvd[i].sender_pid != thread_getpid())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* a waiting receiver gets the first message directly, the rest queued */
+static bool test_send_bulk__waiting_receiver(void)
+{
+    msg_t msgs[MSG_QUEUE_LENGTH + 1];
+    kernel_pid_t pid;
+    int res;
+
+    pid = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                        THREAD_CREATE_STACKTEST, _receiver, NULL, "receiver");
+    /* the receiver runs first and waits for messages */
+    _init_msgs(msgs, ARRAY_SIZE(msgs));
+    res = msg_try_send_bulk(msgs, ARRAY_SIZE(msgs), pid);
+    if (res != (int)ARRAY_SIZE(msgs)) {
+        printf("sent %d\n", res);
+        return false;
+    }
+    /* one call took all of them */
+    if ((_received_numof != ARRAY_SIZE(msgs)) || (_calls != 1)) {
+        printf("received %u in %u calls\n", _received_numof, _calls);
+        return false;
+    }
+    _init_msgs(msgs, ARRAY_SIZE(msgs));
+    for (unsigned i = 0; i < ARRAY_SIZE(msgs); i++) {
+        msgs[i].type += ARRAY_SIZE(msgs);
+    }
+    /* the rest for the receiver to finish */
+    res = msg_try_send_bulk(msgs, TEST_MSG_NUMOF - ARRAY_SIZE(msgs), pid);
+    if (res != (int)(TEST_MSG_NUMOF - ARRAY_SIZE(msgs))) {
+        printf("sent %d\n", res);
+        return false;
+    }
+    return _check_received(thread_getpid());
+}
+
+/* messages of blocked senders follow the queued ones in order */
+static bool test_receive_bulk__blocked_sender(void)
+{
+    kernel_pid_t pid;
+
+    /* the sender runs first, fills the queue and blocks */
+    pid = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                        THREAD_CREATE_STACKTEST, _sender,
+                        (void *)(intptr_t)thread_getpid(), "sender");
+    if (msg_avail() != MSG_QUEUE_LENGTH) {
+        printf("queued %d\n", msg_avail());
+        return false;
+    }
+    _receive_all();
+    if (msg_avail() != 0) {
+        printf("left %d\n", msg_avail());
+        return false;
+    }
+    return _check_received(pid);
+}
+
+int main(void)
+{
+    bool res = true;
+
+    msg_init_queue(_main_queue, ARRAY_SIZE(_main_queue));
+    puts("msg_bulk test application.");
+
+    if (!test_send_bulk__queue()) {
+        puts("test_send_bulk__queue failed");
+        res = false;
+    }
+    if (!test_send_bulk__waiting_receiver()) {
+        puts("test_send_bulk__waiting_receiver failed");
+        res = false;
+    }
+    if (!test_receive_bulk__blocked_sender()) {
+        puts("test_receive_bulk__blocked_sender failed");
+        res = false;
+    }
+    puts(res ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
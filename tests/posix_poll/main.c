@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for poll() and select() on a VFS file
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <poll.h>
+#include <sys/select.h>
+
+#include "thread.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define TEST_TIMEOUT_MS     (100U)
+#define TEST_DELAY_US       (50U * US_PER_MS)
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+static int _actor_fd;
+static bool _actor_close;
+
+/* readiness reported by the test file */
+static volatile int _events;
+
+static int _test_poll(vfs_file_t *filp)
+{
+    (void)filp;
+    return _events;
+}
+
+static const vfs_file_ops_t _test_ops = {
+    .poll = _test_poll,
+};
+
+static int _open(void)
+{
+    _events = 0;
+    return vfs_bind(VFS_ANY_FD, O_RDWR, &_test_ops, NULL);
+}
+
+/* runs while the main thread is blocked in poll() or select() */
+static void *_actor(void *arg)
+{
+    (void)arg;
+    xtimer_usleep(TEST_DELAY_US);
+    if (_actor_close) {
+        vfs_close(_actor_fd);
+    }
+    else {
+        _events = VFS_POLLIN;
+        vfs_poll_notify(_actor_fd);
+    }
+    return NULL;
+}
+
+/* makes @p fd ready or closes it after TEST_DELAY_US */
+static void _act_later(int fd, bool do_close)
+{
+    _actor_fd = fd;
+    _actor_close = do_close;
+    /* the actor runs first, so it is sleeping when the main thread blocks */
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _actor, NULL, "actor");
+}
+
+/* returns 0 after the timeout if the file is not ready */
+static bool test_poll__timeout(void)
+{
+    struct pollfd pfd = { .fd = _open(), .events = POLLIN };
+    uint32_t start = xtimer_now_usec();
+    int res = poll(&pfd, 1, TEST_TIMEOUT_MS);
+    uint32_t elapsed = xtimer_now_usec() - start;
+
+    vfs_close(pfd.fd);
+    if ((res != 0) || (pfd.revents != 0) ||
+        (elapsed < TEST_TIMEOUT_MS * US_PER_MS)) {
+        printf("res %d, revents 0x%x after %lu us\n", res, pfd.revents,
+               (unsigned long)elapsed);
+        return false;
+    }
+    return true;
+}
+
+/* returns 0 after the timeout and clears the fd if the file is not ready */
+static bool test_select__timeout(void)
+{
+    int fd = _open();
+    struct timeval tv = { .tv_usec = TEST_TIMEOUT_MS * US_PER_MS };
+    fd_set readfds;
+    uint32_t start, elapsed;
+    int res;
+
+    FD_ZERO(&readfds);
+    FD_SET(fd, &readfds);
+    start = xtimer_now_usec();
+    res = select(fd + 1, &readfds, NULL, NULL, &tv);
+    elapsed = xtimer_now_usec() - start;
+    vfs_close(fd);
+    if ((res != 0) || FD_ISSET(fd, &readfds) ||
+        (elapsed < TEST_TIMEOUT_MS * US_PER_MS)) {
+        printf("res %d after %lu us\n", res, (unsigned long)elapsed);
+        return false;
+    }
+    return true;
+}
+
+/* wakes up when the file becomes ready */
+static bool test_poll__notify(void)
+{
+    struct pollfd pfd = { .fd = _open(), .events = POLLIN };
+    int res;
+
+    _act_later(pfd.fd, false);
+    res = poll(&pfd, 1, -1);
+    vfs_close(pfd.fd);
+    if ((res != 1) || (pfd.revents != POLLIN)) {
+        printf("res %d, revents 0x%x\n", res, pfd.revents);
+        return false;
+    }
+    return true;
+}
+
+/* wakes up with POLLNVAL when the file is closed by another thread */
+static bool test_poll__close(void)
+{
+    struct pollfd pfd = { .fd = _open(), .events = POLLIN };
+    int res;
+
+    _act_later(pfd.fd, true);
+    res = poll(&pfd, 1, -1);
+    if ((res != 1) || (pfd.revents != POLLNVAL)) {
+        printf("res %d, revents 0x%x\n", res, pfd.revents);
+        return false;
+    }
+    return true;
+}
+
+/* fails with EBADF when the file is closed by another thread */
+static bool test_select__close(void)
+{
+    int fd = _open();
+    fd_set readfds;
+    int res;
+
+    FD_ZERO(&readfds);
+    FD_SET(fd, &readfds);
+    _act_later(fd, true);
+    res = select(fd + 1, &readfds, NULL, NULL, NULL);
+    if ((res != -1) || (errno != EBADF)) {
+        printf("res %d, errno %d\n", res, errno);
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    bool res = true;
+
+    puts("posix_poll test application.");
+
+    if (!test_poll__timeout()) {
+        puts("test_poll__timeout failed");
+        res = false;
+    }
+    if (!test_select__timeout()) {
+        puts("test_select__timeout failed");
+        res = false;
+    }
+    if (!test_poll__notify()) {
+        puts("test_poll__notify failed");
+        res = false;
+    }
+    if (!test_poll__close()) {
+        puts("test_poll__close failed");
+        res = false;
+    }
+    if (!test_select__close()) {
+        puts("test_select__close failed");
+        res = false;
+    }
+    puts(res ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
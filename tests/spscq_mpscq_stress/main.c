@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stress test for the lock-free spscq and mpscq queues
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "kernel_defines.h"
+#include "mpscq.h"
+#include "spscq.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_RECORDS
+#define TEST_RECORDS        (20000U)
+#endif
+
+/* interval of the producing timer, short enough to fill the queues */
+#ifndef TEST_ISR_INTERVAL
+#define TEST_ISR_INTERVAL   (20U)
+#endif
+
+#define TEST_FLAG           (0x1)
+#define TEST_REC_MAX        (32U)
+#define TEST_PRODUCERS      (3U)
+#define TEST_NODES          (8U)
+
+/* ---- spscq: an ISR produces records of varying size ---- */
+
+static uint32_t _spsc_buf[256 / sizeof(uint32_t)];
+static spscq_t _spsc;
+static xtimer_t _timer;
+static uint32_t _spsc_seq;
+static unsigned _spsc_dropped;
+
+/* record i is i % TEST_REC_MAX + 4 bytes long, starts with i and is
+ * filled with its lowest byte */
+static size_t _fill(uint8_t *rec, uint32_t seq)
+{
+    size_t len = (seq % TEST_REC_MAX) + sizeof(seq);
+
+    memset(rec, seq, len);
+    memcpy(rec, &seq, sizeof(seq));
+    return len;
+}
+
+static int _check(const uint8_t *rec, size_t len, uint32_t seq)
+{
+    uint8_t expected[TEST_REC_MAX + sizeof(seq)];
+
+    return (len == _fill(expected, seq)) && !memcmp(rec, expected, len);
+}
+
+static void _spsc_isr(void *arg)
+{
+    (void)arg;
+
+    if (_spsc_seq < TEST_RECORDS) {
+        uint8_t *rec = spscq_reserve(&_spsc, TEST_REC_MAX + sizeof(uint32_t));
+        if (rec) {
+            /* reserve the maximum and commit what was actually used, as a
+             * driver would do */
+            spscq_commit(&_spsc, _fill(rec, _spsc_seq++));
+        }
+        else {
+            _spsc_dropped++;
+        }
+        xtimer_set(&_timer, TEST_ISR_INTERVAL);
+    }
+}
+
+static unsigned _test_spscq(void)
+{
+    uint8_t rec[TEST_REC_MAX + sizeof(uint32_t)];
+    unsigned errors = 0;
+
+    spscq_init(&_spsc, _spsc_buf, sizeof(_spsc_buf), TEST_FLAG);
+    _timer.callback = _spsc_isr;
+    xtimer_set(&_timer, TEST_ISR_INTERVAL);
+
+    for (uint32_t seq = 0; seq < TEST_RECORDS; seq++) {
+        ssize_t len = spscq_get_blocking(&_spsc, rec, sizeof(rec));
+        if ((len < 0) || !_check(rec, len, seq)) {
+            errors++;
+        }
+        /* let the queue run full now and then */
+        if ((seq % 1000) == 0) {
+            xtimer_usleep(20 * TEST_ISR_INTERVAL);
+        }
+    }
+
+    printf("spscq: %u records, %u dropped when full, %u errors\n",
+           TEST_RECORDS, _spsc_dropped, errors);
+    return errors;
+}
+
+/* ---- mpscq: threads of higher and lower priority and an ISR produce ---- */
+
+typedef struct {
+    mpscq_node_t node;
+    uint8_t producer;
+    uint32_t seq;
+} record_t;
+
+/* every producer has a few nodes it reuses once the consumer hands them
+ * back, the ISR is producer TEST_PRODUCERS */
+static record_t _nodes[TEST_PRODUCERS + 1][TEST_NODES];
+static mpscq_t _mpsc;
+static mpscq_t _free[TEST_PRODUCERS + 1];
+static char _stacks[TEST_PRODUCERS][THREAD_STACKSIZE_DEFAULT];
+static uint32_t _isr_seq;
+static unsigned _isr_dropped;
+
+static void _put_next(unsigned producer, uint32_t seq, record_t *rec)
+{
+    rec->producer = producer;
+    rec->seq = seq;
+    mpscq_put(&_mpsc, &rec->node);
+}
+
+static void *_producer(void *arg)
+{
+    unsigned producer = (unsigned)(uintptr_t)arg;
+
+    for (uint32_t seq = 0; seq < TEST_RECORDS; seq++) {
+        mpscq_node_t *node = mpscq_get_blocking(&_free[producer]);
+        _put_next(producer, seq, container_of(node, record_t, node));
+        if ((seq % 16) == 0) {
+            thread_yield();
+        }
+    }
+    return NULL;
+}
+
+static void _mpsc_isr(void *arg)
+{
+    (void)arg;
+
+    if (_isr_seq < TEST_RECORDS) {
+        mpscq_node_t *node = mpscq_get(&_free[TEST_PRODUCERS]);
+        if (node) {
+            _put_next(TEST_PRODUCERS, _isr_seq++,
+                      container_of(node, record_t, node));
+        }
+        else {
+            _isr_dropped++;
+        }
+        xtimer_set(&_timer, TEST_ISR_INTERVAL);
+    }
+}
+
+static unsigned _test_mpscq(void)
+{
+    uint32_t next[TEST_PRODUCERS + 1] = { 0 };
+    unsigned errors = 0;
+
+    mpscq_init(&_mpsc, TEST_FLAG);
+    for (unsigned p = 0; p <= TEST_PRODUCERS; p++) {
+        /* the free list of a producer is only read by that producer */
+        mpscq_init(&_free[p], TEST_FLAG);
+        for (unsigned i = 0; i < TEST_NODES; i++) {
+            mpscq_put(&_free[p], &_nodes[p][i].node);
+        }
+    }
+    for (unsigned p = 0; p < TEST_PRODUCERS; p++) {
+        /* one producer above the consumer, the others below */
+        thread_create(_stacks[p], sizeof(_stacks[p]),
+                      THREAD_PRIORITY_MAIN - 1 + (2 * p),
+                      THREAD_CREATE_STACKTEST, _producer,
+                      (void *)(uintptr_t)p, "producer");
+    }
+    _timer.callback = _mpsc_isr;
+    xtimer_set(&_timer, TEST_ISR_INTERVAL);
+
+    for (unsigned i = 0; i < (TEST_PRODUCERS + 1) * TEST_RECORDS; i++) {
+        record_t *rec = container_of(mpscq_get_blocking(&_mpsc), record_t,
+                                     node);
+        /* records of each producer must arrive in order */
+        if ((rec->producer > TEST_PRODUCERS) ||
+            (rec->seq != next[rec->producer]++)) {
+            errors++;
+            continue;
+        }
+        mpscq_put(&_free[rec->producer], &rec->node);
+    }
+
+    printf("mpscq: %u records from %u threads and an ISR, "
+           "%u dropped by the ISR, %u errors\n",
+           (TEST_PRODUCERS + 1) * TEST_RECORDS, TEST_PRODUCERS, _isr_dropped,
+           errors);
+    return errors;
+}
+
+int main(void)
+{
+    unsigned errors = 0;
+
+    puts("spscq/mpscq stress test");
+
+    errors += _test_spscq();
+    errors += _test_mpscq();
+
+    if (errors) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -980,6 +980,137 @@ static void test_crypto_modes_ccm_decrypt(void)
 }
 
 
+/* Encrypt and decrypt in place with a pre-keyed context, all but the last 5
+ * bytes of the nonce are the fixed prefix */
+static void test_ctx_op(const uint8_t* key, uint8_t key_len,
+                        const uint8_t* adata, size_t adata_len,
+                        const uint8_t* nonce, uint8_t nonce_len,
+                        const uint8_t* plain, size_t plain_len,
+                        const uint8_t* output_expected,
+                        size_t output_expected_len,
+                        uint8_t mac_length)
+{
+    cipher_t cipher;
+    ccm_ctx_t ctx;
+    int len, err, cmp;
+    size_t len_encoding = nonce_and_len_encoding_size - nonce_len;
+    size_t prefix_len = nonce_len - 5;
+
+    TEST_ASSERT_MESSAGE(sizeof(data) >= output_expected_len,
+                        "Output buffer too small");
+
+    err = cipher_init(&cipher, CIPHER_AES_128, key, key_len);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    err = ccm_ctx_init(&ctx, &cipher, mac_length, len_encoding,
+                       nonce, prefix_len);
+    TEST_ASSERT_EQUAL_INT(0, err);
+
+    memcpy(data, plain, plain_len);
+    len = ccm_ctx_encrypt(&ctx, nonce + prefix_len, nonce_len - prefix_len,
+                          adata, adata_len, data, plain_len, data);
+    TEST_ASSERT_EQUAL_INT(output_expected_len, len);
+    cmp = compare(output_expected, data, len);
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong ciphertext");
+
+    len = ccm_ctx_decrypt(&ctx, nonce + prefix_len, nonce_len - prefix_len,
+                          adata, adata_len, data, output_expected_len, data);
+    TEST_ASSERT_EQUAL_INT(plain_len, len);
+    cmp = compare(plain, data, len);
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong plaintext");
+}
+
+#define do_test_ctx_op(name) do { \
+    test_ctx_op(TEST_##name##_KEY, TEST_##name##_KEY_LEN, \
+                TEST_##name##_INPUT, TEST_##name##_ADATA_LEN, \
+                TEST_##name##_NONCE, TEST_##name##_NONCE_LEN, \
+                \
+                TEST_##name##_INPUT + TEST_##name##_ADATA_LEN, \
+                TEST_##name##_INPUT_LEN, \
+                \
+                TEST_##name##_EXPECTED + TEST_##name##_ADATA_LEN, \
+                TEST_##name##_EXPECTED_LEN - TEST_##name##_ADATA_LEN, \
+                \
+                TEST_##name##_MAC_LEN \
+                ); \
+} while (0)
+
+static void test_crypto_modes_ccm_ctx(void)
+{
+    do_test_ctx_op(RFC_1);
+    do_test_ctx_op(RFC_2);
+    do_test_ctx_op(RFC_3);
+    do_test_ctx_op(RFC_4);
+    do_test_ctx_op(RFC_5);
+    do_test_ctx_op(RFC_6);
+    do_test_ctx_op(RFC_7);
+    do_test_ctx_op(RFC_8);
+    do_test_ctx_op(RFC_9);
+    do_test_ctx_op(RFC_10);
+    do_test_ctx_op(RFC_11);
+    do_test_ctx_op(RFC_12);
+    do_test_ctx_op(RFC_13);
+    do_test_ctx_op(RFC_14);
+    do_test_ctx_op(RFC_15);
+    do_test_ctx_op(RFC_16);
+    do_test_ctx_op(RFC_17);
+    do_test_ctx_op(RFC_18);
+    do_test_ctx_op(RFC_19);
+    do_test_ctx_op(RFC_20);
+    do_test_ctx_op(RFC_21);
+    do_test_ctx_op(RFC_22);
+    do_test_ctx_op(RFC_23);
+    do_test_ctx_op(RFC_24);
+
+    do_test_ctx_op(NIST_1);
+    do_test_ctx_op(NIST_2);
+    do_test_ctx_op(NIST_3);
+}
+
+/* Messages with more than 24 bytes of adata and more than 255 bytes of
+ * payload, both were not handled by previous implementations */
+static void test_crypto_modes_ccm_long(void)
+{
+    static uint8_t plain[300], adata[40], enc[sizeof(plain) + 16],
+                   dec[sizeof(plain)];
+    cipher_t cipher;
+    ccm_ctx_t ctx;
+    int len;
+
+    for (unsigned i = 0; i < sizeof(plain); i++) {
+        plain[i] = i;
+    }
+    for (unsigned i = 0; i < sizeof(adata); i++) {
+        adata[i] = 0xA0 + i;
+    }
+
+    cipher_init(&cipher, CIPHER_AES_128, TEST_RFC_1_KEY, TEST_RFC_1_KEY_LEN);
+    len = cipher_encrypt_ccm(&cipher, adata, sizeof(adata), 16, 2,
+                             TEST_RFC_1_NONCE, TEST_RFC_1_NONCE_LEN,
+                             plain, sizeof(plain), enc);
+    TEST_ASSERT_EQUAL_INT(sizeof(plain) + 16, len);
+
+    len = cipher_decrypt_ccm(&cipher, adata, sizeof(adata), 16, 2,
+                             TEST_RFC_1_NONCE, TEST_RFC_1_NONCE_LEN,
+                             enc, sizeof(enc), dec);
+    TEST_ASSERT_EQUAL_INT(sizeof(plain), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(plain, dec, sizeof(plain)));
+
+    /* the context gives the same result */
+    ccm_ctx_init(&ctx, &cipher, 16, 2, TEST_RFC_1_NONCE, 8);
+    len = ccm_ctx_decrypt(&ctx, TEST_RFC_1_NONCE + 8, TEST_RFC_1_NONCE_LEN - 8,
+                          adata, sizeof(adata), enc, sizeof(enc), dec);
+    TEST_ASSERT_EQUAL_INT(sizeof(plain), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(plain, dec, sizeof(plain)));
+
+    /* any change in the adata must be detected */
+    adata[30] ^= 1;
+    len = cipher_decrypt_ccm(&cipher, adata, sizeof(adata), 16, 2,
+                             TEST_RFC_1_NONCE, TEST_RFC_1_NONCE_LEN,
+                             enc, sizeof(enc), dec);
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_CBC_MAC, len);
+}
+
+
 typedef int (*func_ccm_t)(cipher_t*, const uint8_t*, uint32_t,
                           uint8_t, uint8_t, const uint8_t*, size_t,
                           const uint8_t*, size_t, uint8_t*);
@@ -1049,6 +1180,8 @@ Test* tests_crypto_modes_ccm_tests(void)
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_modes_ccm_encrypt),
         new_TestFixture(test_crypto_modes_ccm_decrypt),
+        new_TestFixture(test_crypto_modes_ccm_ctx),
+        new_TestFixture(test_crypto_modes_ccm_long),
         new_TestFixture(test_crypto_modes_ccm_check_len),
     };
 
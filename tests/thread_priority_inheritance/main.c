@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for mutex priority inheritance
+ *
+ * The priority inversion scenario of tests/thread_priority_inversion, but
+ * each thread runs only once: t_low holds the mutex t_high waits for while
+ * t_mid keeps the CPU busy. With priority inheritance t_low runs with the
+ * priority of t_high, so t_high finishes before t_mid.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define T_LOW_HOLD          (100U * US_PER_MS)
+#define T_HIGH_DELAY        (10U * US_PER_MS)
+#define T_MID_DELAY         (20U * US_PER_MS)
+#define T_MID_SPIN          (500U * US_PER_MS)
+
+static mutex_t _res_mtx = MUTEX_INIT;
+
+static char _stack_high[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mid[THREAD_STACKSIZE_DEFAULT];
+static char _stack_low[THREAD_STACKSIZE_DEFAULT];
+
+static void *_low_handler(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&_res_mtx);
+    puts("t_low: got resource.");
+    xtimer_usleep(T_LOW_HOLD);
+    mutex_unlock(&_res_mtx);
+    puts("t_low: freed resource.");
+    return NULL;
+}
+
+static void *_mid_handler(void *arg)
+{
+    (void)arg;
+
+    xtimer_usleep(T_MID_DELAY);
+    puts("t_mid: spinning...");
+
+    /* busy wait, lower priority threads don't get the CPU meanwhile */
+    uint32_t start = xtimer_now_usec();
+    while ((xtimer_now_usec() - start) < T_MID_SPIN) {}
+
+    puts("t_mid: done.");
+    return NULL;
+}
+
+static void *_high_handler(void *arg)
+{
+    (void)arg;
+
+    xtimer_usleep(T_HIGH_DELAY);
+    puts("t_high: allocating resource...");
+    mutex_lock(&_res_mtx);
+    puts("t_high: got resource.");
+    mutex_unlock(&_res_mtx);
+    puts("t_high: done.");
+    return NULL;
+}
+
+int main(void)
+{
+    puts("Priority inheritance test");
+
+    thread_create(_stack_low, sizeof(_stack_low), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _low_handler, NULL, "t_low");
+    thread_create(_stack_mid, sizeof(_stack_mid), THREAD_PRIORITY_MAIN - 2,
+                  THREAD_CREATE_STACKTEST, _mid_handler, NULL, "t_mid");
+    thread_create(_stack_high, sizeof(_stack_high), THREAD_PRIORITY_MAIN - 3,
+                  THREAD_CREATE_STACKTEST, _high_handler, NULL, "t_high");
+    return 0;
+}
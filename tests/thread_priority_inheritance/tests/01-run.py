@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("t_low: got resource.")
+    child.expect_exact("t_high: allocating resource...")
+    child.expect_exact("t_mid: spinning...")
+    # t_low inherits the priority of t_high, t_mid can't delay them
+    idx = child.expect_exact(["t_high: done.", "t_mid: done."])
+    assert idx == 0, "t_mid finished before t_high"
+    child.expect_exact("t_mid: done.")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <limits.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+
+#include "can/can.h"
+#include "can/common.h"
+#include "can/pkt.h"
+#include "can/raw.h"
+#include "can/router.h"
+#include "mbox.h"
+
+#include "tests-can_router.h"
+
+#define TEST_IFNUM          (0)
+#define TEST_MBOX_SIZE      (8U)
+#define TEST_PARAMS_NUMOF   (8U)
+
+static msg_t _mbox_queue[TEST_MBOX_SIZE];
+static mbox_t _mbox;
+static can_reg_entry_t _entry;
+/* the filters are told apart by the address of their param */
+static int _params[TEST_PARAMS_NUMOF];
+static unsigned _pkts_numof;
+
+/* number of packets that can be allocated */
+static unsigned _pkts_free(void)
+{
+    static can_pkt_t *pkts[CAN_PKT_BUF_SIZE + 1];
+    unsigned res = 0;
+
+    while ((res < ARRAY_SIZE(pkts)) &&
+           (pkts[res] = can_pkt_alloc_rx(TEST_IFNUM, &(struct can_frame){ 0 }))) {
+        res++;
+    }
+    for (unsigned i = 0; i < res; i++) {
+        can_pkt_free(pkts[i]);
+    }
+    return res;
+}
+
+static unsigned _waiting(void)
+{
+    return cib_avail(&_mbox.cib);
+}
+
+static void set_up(void)
+{
+    can_pkt_init();
+    can_router_init();
+    mbox_init(&_mbox, _mbox_queue, TEST_MBOX_SIZE);
+    _entry.ifnum = TEST_IFNUM;
+    _entry.type = CAN_TYPE_MBOX;
+    _entry.target.mbox = &_mbox;
+    _pkts_numof = _pkts_free();
+}
+
+static int _register(canid_t can_id, canid_t mask, unsigned param)
+{
+    return can_router_register(&_entry, can_id, mask, &_params[param]);
+}
+
+static int _unregister(canid_t can_id, canid_t mask, unsigned param)
+{
+    return can_router_unregister(&_entry, can_id, mask, &_params[param]);
+}
+
+static can_pkt_t *_pkt(canid_t can_id)
+{
+    struct can_frame frame = { .can_id = can_id, .can_dlc = 1 };
+
+    return can_pkt_alloc_rx(TEST_IFNUM, &frame);
+}
+
+static int _dispatch(canid_t can_id)
+{
+    return can_router_dispatch_rx_indic(_pkt(can_id));
+}
+
+/* returns the param of the filter the next frame was delivered for,
+ * -1 if there is none or it is not @p can_id */
+static int _receive_one(canid_t can_id)
+{
+    msg_t msg;
+    int res = -1;
+
+    if (mbox_try_get(&_mbox, &msg) != 1) {
+        return -1;
+    }
+    if (msg.type == CAN_MSG_RX_INDICATION) {
+        can_rx_data_t *rx = msg.content.ptr;
+        struct can_frame *frame = rx->data.iov_base;
+
+        if (frame->can_id == can_id) {
+            res = (int *)rx->arg - _params;
+        }
+        raw_can_free_frame(rx);
+    }
+    return res;
+}
+
+/* returns the params of the filters all waiting frames were delivered for
+ * as bit field, or UINT_MAX if one of them is not @p can_id */
+static unsigned _receive_all(canid_t can_id)
+{
+    unsigned res = 0;
+
+    while (_waiting() > 0) {
+        int param = _receive_one(can_id);
+
+        if (param < 0) {
+            return UINT_MAX;
+        }
+        res |= 1U << param;
+    }
+    return res;
+}
+
+static void test_can_router_register__used(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _register(0x123, CAN_SFF_MASK, 0));
+    TEST_ASSERT_EQUAL_INT(1, _register(0x123, CAN_SFF_MASK, 1));
+    /* different mask, different filter */
+    TEST_ASSERT_EQUAL_INT(0, _register(0x123, 0x7f0, 2));
+    TEST_ASSERT_EQUAL_INT(1, _unregister(0x123, CAN_SFF_MASK, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, _unregister(0x123, CAN_SFF_MASK, 1));
+    TEST_ASSERT_EQUAL_INT(0, _unregister(0x123, CAN_SFF_MASK, 0));
+    TEST_ASSERT_EQUAL_INT(0, _unregister(0x123, 0x7f0, 2));
+}
+
+static void test_can_router_dispatch__no_filter(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _register(0x124, CAN_SFF_MASK, 0));
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(0x123));
+    TEST_ASSERT_EQUAL_INT(0, _waiting());
+    /* nobody got the packet, so it was freed */
+    TEST_ASSERT_EQUAL_INT(_pkts_numof, _pkts_free());
+}
+
+static void test_can_router_dispatch__overlapping_masks(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _register(0x123, CAN_SFF_MASK, 0));
+    TEST_ASSERT_EQUAL_INT(0, _register(0x120, 0x7f0, 1));
+    TEST_ASSERT_EQUAL_INT(0, _register(0x100, 0x700, 2));
+    TEST_ASSERT_EQUAL_INT(0, _register(0x000, 0x000, 3));
+    /* more masks than CAN_ROUTER_MASK_GROUPS (4 by default), this one ends
+     * up in the list searched linearly */
+    TEST_ASSERT_EQUAL_INT(0, _register(0x122, 0x7fe, 4));
+    TEST_ASSERT_EQUAL_INT(1, _register(0x123, CAN_SFF_MASK, 5));
+
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(0x123));
+    TEST_ASSERT_EQUAL_INT(0x3f, _receive_all(0x123));
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(0x12f));
+    TEST_ASSERT_EQUAL_INT(0x0e, _receive_all(0x12f));
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(0x1ff));
+    TEST_ASSERT_EQUAL_INT(0x0c, _receive_all(0x1ff));
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(0x223));
+    TEST_ASSERT_EQUAL_INT(0x08, _receive_all(0x223));
+    TEST_ASSERT_EQUAL_INT(_pkts_numof, _pkts_free());
+}
+
+static void test_can_router_dispatch__extended_ids(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _register(CAN_EFF_FLAG | 0x1234567,
+                                       CAN_EFF_FLAG | CAN_EFF_MASK, 0));
+    TEST_ASSERT_EQUAL_INT(0, _register(CAN_EFF_FLAG | 0x1234500,
+                                       CAN_EFF_FLAG | (CAN_EFF_MASK & ~0xff), 1));
+    /* standard frames only */
+    TEST_ASSERT_EQUAL_INT(0, _register(0x567, CAN_EFF_FLAG | CAN_SFF_MASK, 2));
+
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(CAN_EFF_FLAG | 0x1234567));
+    TEST_ASSERT_EQUAL_INT(0x3, _receive_all(CAN_EFF_FLAG | 0x1234567));
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(CAN_EFF_FLAG | 0x12345ff));
+    TEST_ASSERT_EQUAL_INT(0x2, _receive_all(CAN_EFF_FLAG | 0x12345ff));
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(0x567));
+    TEST_ASSERT_EQUAL_INT(0x4, _receive_all(0x567));
+    /* same 11 low bits, but extended */
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(CAN_EFF_FLAG | 0x567));
+    TEST_ASSERT_EQUAL_INT(0, _waiting());
+    TEST_ASSERT_EQUAL_INT(_pkts_numof, _pkts_free());
+}
+
+static void test_can_router_unregister__during_dispatch(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _register(0x123, CAN_SFF_MASK, 0));
+    TEST_ASSERT_EQUAL_INT(0, _register(0x100, 0x700, 1));
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(0x123));
+    /* frames that are on their way stay valid */
+    TEST_ASSERT_EQUAL_INT(0, _unregister(0x123, CAN_SFF_MASK, 0));
+    TEST_ASSERT_EQUAL_INT(0, _register(0x123, CAN_SFF_MASK, 2));
+    TEST_ASSERT_EQUAL_INT(0x3, _receive_all(0x123));
+    TEST_ASSERT_EQUAL_INT(_pkts_numof, _pkts_free());
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(0x123));
+    TEST_ASSERT_EQUAL_INT(0x6, _receive_all(0x123));
+    TEST_ASSERT_EQUAL_INT(0, _unregister(0x100, 0x700, 1));
+    TEST_ASSERT_EQUAL_INT(0, _dispatch(0x123));
+    TEST_ASSERT_EQUAL_INT(0x4, _receive_all(0x123));
+    TEST_ASSERT_EQUAL_INT(_pkts_numof, _pkts_free());
+}
+
+static void test_can_router_dispatch__busy(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _register(0x123, CAN_SFF_MASK, 0));
+    for (unsigned i = 0; i < TEST_MBOX_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _dispatch(0x123));
+    }
+    TEST_ASSERT_EQUAL_INT(-EBUSY, _dispatch(0x123));
+    for (unsigned i = 0; i < TEST_MBOX_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _receive_one(0x123));
+    }
+    /* the packet nobody could take was freed, and only once */
+    TEST_ASSERT_EQUAL_INT(_pkts_numof, _pkts_free());
+}
+
+static void test_can_router_dispatch_rx_indic_batch(void)
+{
+    can_pkt_t *pkts[] = { _pkt(0x123), _pkt(0x7ff), _pkt(0x234) };
+
+    TEST_ASSERT_EQUAL_INT(0, _register(0x123, CAN_SFF_MASK, 0));
+    TEST_ASSERT_EQUAL_INT(0, _register(0x200, 0x700, 1));
+    TEST_ASSERT_EQUAL_INT(0, can_router_dispatch_rx_indic_batch(pkts,
+                                                                ARRAY_SIZE(pkts)));
+    /* dispatched packets are taken from the array */
+    TEST_ASSERT_NULL(pkts[0]);
+    TEST_ASSERT_NULL(pkts[2]);
+    TEST_ASSERT_EQUAL_INT(0, _receive_one(0x123));
+    TEST_ASSERT_EQUAL_INT(1, _receive_one(0x234));
+    TEST_ASSERT_EQUAL_INT(0, _waiting());
+    TEST_ASSERT_EQUAL_INT(_pkts_numof, _pkts_free());
+}
+
+Test *tests_can_router_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_can_router_register__used),
+        new_TestFixture(test_can_router_dispatch__no_filter),
+        new_TestFixture(test_can_router_dispatch__overlapping_masks),
+        new_TestFixture(test_can_router_dispatch__extended_ids),
+        new_TestFixture(test_can_router_unregister__during_dispatch),
+        new_TestFixture(test_can_router_dispatch__busy),
+        new_TestFixture(test_can_router_dispatch_rx_indic_batch),
+    };
+
+    EMB_UNIT_TESTCALLER(can_router_tests, set_up, NULL, fixtures);
+
+    return (Test *)&can_router_tests;
+}
+
+void tests_can_router(void)
+{
+    TESTS_RUN(tests_can_router_tests());
+}
+/** @} */
@@ -16,6 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+
 #include "thread.h"
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -131,11 +133,73 @@ static void tests_core_ringbuffer_remove(void)
 
 }
 
+static void tests_core_ringbuffer_remove_to_end(void)
+{
+    char mem[3];
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    ringbuffer_add(&buf, "\x00\x01\x02", 3);
+    ringbuffer_remove(&buf, 1);
+    ringbuffer_add_one(&buf, 3);
+    ringbuffer_remove(&buf, 2);
+
+    /* start must wrap around to the beginning of the buffer */
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_get_one(&buf));
+    TEST_ASSERT_EQUAL_INT(-1, ringbuffer_get_one(&buf));
+}
+
+static void tests_core_ringbuffer_add_get_wrap_around(void)
+{
+    char mem[5];
+    char out[8];
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_add(&buf, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_remove(&buf, 3));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_add(&buf, "defghij", 7));
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_full(&buf));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_get(&buf, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "defgh", 5));
+}
+
+static void tests_core_ringbuffer_contig(void)
+{
+    char mem[5];
+    char *data;
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_get_contig(&buf, &data));
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_add(&buf, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_remove(&buf, 2));
+
+    /* free space wraps around, only the part up to the end is returned */
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_add_contig(&buf, &data));
+    TEST_ASSERT(data == &mem[3]);
+    memcpy(data, "de", 2);
+    ringbuffer_add_commit(&buf, 2);
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_add_contig(&buf, &data));
+    TEST_ASSERT(data == &mem[0]);
+    data[0] = 'f';
+    ringbuffer_add_commit(&buf, 1);
+
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_get_contig(&buf, &data));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, "cde", 3));
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_remove(&buf, 3));
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_get_contig(&buf, &data));
+    TEST_ASSERT_EQUAL_INT('f', *data);
+}
+
 Test *tests_core_ringbuffer_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(tests_core_ringbuffer),
         new_TestFixture(tests_core_ringbuffer_remove),
+        new_TestFixture(tests_core_ringbuffer_remove_to_end),
+        new_TestFixture(tests_core_ringbuffer_add_get_wrap_around),
+        new_TestFixture(tests_core_ringbuffer_contig),
     };
 
     EMB_UNIT_TESTCALLER(ringbuffer_tests, NULL, NULL, fixtures);
@@ -360,6 +360,43 @@ static void test_nib_get__empty(void)
     TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
 }
 
+/*
+ * Creates a NIB entry without an address and tries to get it by the
+ * unspecified address.
+ * Expected result: _nib_onl_get() returns the entry
+ */
+static void test_nib_get__success_unspecified(void)
+{
+    _nib_onl_entry_t *nib_alloced;
+
+    TEST_ASSERT_NOT_NULL((nib_alloced = _nib_onl_alloc(NULL, IFACE)));
+    nib_alloced->mode = _NC;
+    TEST_ASSERT(nib_alloced == _nib_onl_get(&ipv6_addr_unspecified, IFACE));
+    TEST_ASSERT(nib_alloced == _nib_onl_get(&ipv6_addr_unspecified, 0));
+}
+
+/*
+ * Creates two NIB entries with the same link-local address on different
+ * interfaces and tries to get them with and without interface.
+ * Expected result: _nib_onl_get() returns the entry of the interface, without
+ * interface the one created first
+ */
+static void test_nib_get__success_link_local_no_iface(void)
+{
+    _nib_onl_entry_t *nib_alloced1, *nib_alloced2;
+    static const ipv6_addr_t addr = { .u64 = { { .u8 = { 0xfe, 0x80 } },
+                                               { .u64 = TEST_UINT64 } } };
+
+    TEST_ASSERT_NOT_NULL((nib_alloced1 = _nib_onl_alloc(&addr, IFACE)));
+    nib_alloced1->mode = _NC;
+    TEST_ASSERT_NOT_NULL((nib_alloced2 = _nib_onl_alloc(&addr, IFACE + 1)));
+    nib_alloced2->mode = _NC;
+    TEST_ASSERT(nib_alloced1 != nib_alloced2);
+    TEST_ASSERT(nib_alloced1 == _nib_onl_get(&addr, 0));
+    TEST_ASSERT(nib_alloced1 == _nib_onl_get(&addr, IFACE));
+    TEST_ASSERT(nib_alloced2 == _nib_onl_get(&addr, IFACE + 1));
+}
+
 /*
  * Creates GNRC_IPV6_NIB_NUMOF neighbor cache entries with different IP
  * addresses and a non-garbage-collectible AR state and then tries to add
@@ -584,6 +621,30 @@ static void test_nib_nc_remove__cleared(void)
     TEST_ASSERT_NULL(_nib_onl_iter(NULL));
 }
 
+/*
+ * Creates a neighbor cache entry, removes it, and creates another one with a
+ * different address.
+ * Expected result: Only the second entry can be found
+ */
+static void test_nib_nc_remove__readd(void)
+{
+    _nib_onl_entry_t *node;
+    static const ipv6_addr_t addr1 = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                                { .u64 = TEST_UINT64 } } };
+    static const ipv6_addr_t addr2 = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                                { .u64 = TEST_UINT64 + 1 } } };
+
+    TEST_ASSERT_NOT_NULL((node = _nib_nc_add(&addr1, IFACE,
+                                             GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE)));
+    TEST_ASSERT(node == _nib_onl_get(&addr1, IFACE));
+    _nib_nc_remove(node);
+    TEST_ASSERT_NULL(_nib_onl_get(&addr1, IFACE));
+    TEST_ASSERT_NOT_NULL((node = _nib_nc_add(&addr2, IFACE,
+                                             GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE)));
+    TEST_ASSERT_NULL(_nib_onl_get(&addr1, IFACE));
+    TEST_ASSERT(node == _nib_onl_get(&addr2, IFACE));
+}
+
 /*
  * Creates GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF default router list entries with
  * different IP addresses and then tries to add another.
@@ -2018,6 +2079,8 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_iter__three_elem),
         new_TestFixture(test_nib_iter__three_elem_middle_removed),
         new_TestFixture(test_nib_get__empty),
+        new_TestFixture(test_nib_get__success_unspecified),
+        new_TestFixture(test_nib_get__success_link_local_no_iface),
         new_TestFixture(test_nib_get__not_in_nib),
         new_TestFixture(test_nib_get__success),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_addr),
@@ -2029,6 +2092,7 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_nc_add__cache_out_crash),
         new_TestFixture(test_nib_nc_remove__uncleared),
         new_TestFixture(test_nib_nc_remove__cleared),
+        new_TestFixture(test_nib_nc_remove__readd),
         new_TestFixture(test_nib_nc_set_reachable__success),
         new_TestFixture(test_nib_drl_add__no_space_left_diff_addr),
         new_TestFixture(test_nib_drl_add__no_space_left_diff_iface),
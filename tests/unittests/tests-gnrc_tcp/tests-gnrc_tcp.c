@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "byteorder.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/tcp.h"
+
+#include "internal/common.h"
+#include "internal/cc.h"
+#include "internal/rcvbuf.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define TEST_RCV_NXT    (0x1000U)
+#define TEST_SND_UNA    (1000U)
+#define TEST_DATA       "0123456789abcdef"
+
+static gnrc_tcp_tcb_t _tcb;
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_tcp_tcb_init(&_tcb);
+    _rcvbuf_init();
+    _rcvbuf_get_buffer(&_tcb);
+    _tcb.rcv_nxt = TEST_RCV_NXT;
+    _tcb.snd_una = TEST_SND_UNA;
+    _tcb.snd_nxt = TEST_SND_UNA;
+}
+
+static void tear_down(void)
+{
+    _rcvbuf_ooo_clear(&_tcb);
+    _rcvbuf_release_buffer(&_tcb);
+}
+
+/* builds a received segment carrying TEST_DATA[off, off + len) */
+static gnrc_pktsnip_t *_segment(size_t off, size_t len)
+{
+    tcp_hdr_t hdr;
+    gnrc_pktsnip_t *tcp, *pkt;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.seq_num = byteorder_htonl(TEST_RCV_NXT + off);
+    tcp = gnrc_pktbuf_add(NULL, &hdr, sizeof(hdr), GNRC_NETTYPE_TCP);
+    TEST_ASSERT_NOT_NULL(tcp);
+    pkt = gnrc_pktbuf_add(tcp, &TEST_DATA[off], len, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    return pkt;
+}
+
+/* as the receive path: in order segments are copied, others queued */
+static void _receive(size_t off, size_t len)
+{
+    gnrc_pktsnip_t *pkt = _segment(off, len);
+    uint32_t seg_seq = TEST_RCV_NXT + off;
+
+    if (LEQ_32_BIT(seg_seq, _tcb.rcv_nxt)) {
+        _rcvbuf_add_payload(&_tcb, pkt, seg_seq);
+        _rcvbuf_ooo_drain(&_tcb);
+    }
+    else {
+        _rcvbuf_ooo_add(&_tcb, pkt, seg_seq);
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+static unsigned _ooo_len(void)
+{
+    unsigned res = 0;
+
+    for (unsigned i = 0; i < GNRC_TCP_RCV_OOO_QUEUE_SIZE; i++) {
+        if (_tcb.rcv_ooo[i] != NULL) {
+            res++;
+        }
+    }
+    return res;
+}
+
+static void _check_received(size_t len)
+{
+    char buf[sizeof(TEST_DATA)];
+
+    TEST_ASSERT_EQUAL_INT(TEST_RCV_NXT + len, _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(len, ringbuffer_get(&_tcb.rcv_buf, buf, sizeof(buf)));
+    TEST_ASSERT(memcmp(TEST_DATA, buf, len) == 0);
+}
+
+static void test_cc_init(void)
+{
+    uint32_t smss = _cc_smss(&_tcb);
+
+    /* no MSS option received */
+    TEST_ASSERT_EQUAL_INT(536, smss);
+    _cc_init(&_tcb);
+    TEST_ASSERT_EQUAL_INT(4 * smss, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.dup_acks);
+}
+
+static void test_cc_ack__slow_start(void)
+{
+    uint32_t smss, cwnd;
+
+    _cc_init(&_tcb);
+    smss = _cc_smss(&_tcb);
+    cwnd = _tcb.cwnd;
+    _cc_ack(&_tcb, smss);
+    TEST_ASSERT_EQUAL_INT(cwnd + smss, _tcb.cwnd);
+    /* at most one SMSS per ACK */
+    _cc_ack(&_tcb, 3 * smss);
+    TEST_ASSERT_EQUAL_INT(cwnd + 2 * smss, _tcb.cwnd);
+    _cc_ack(&_tcb, 10);
+    TEST_ASSERT_EQUAL_INT(cwnd + 2 * smss + 10, _tcb.cwnd);
+}
+
+static void test_cc_ack__congestion_avoidance(void)
+{
+    uint32_t smss;
+
+    _cc_init(&_tcb);
+    smss = _cc_smss(&_tcb);
+    _tcb.ssthresh = _tcb.cwnd;
+    /* one SMSS per window of ACKs */
+    for (unsigned i = 0; i < 4; i++) {
+        _cc_ack(&_tcb, smss);
+    }
+    TEST_ASSERT(_tcb.cwnd > 4 * smss);
+    TEST_ASSERT(_tcb.cwnd <= 5 * smss);
+}
+
+static void test_cc_ack__limit(void)
+{
+    _cc_init(&_tcb);
+    _tcb.cwnd = UINT16_MAX - 1;
+    _cc_ack(&_tcb, _cc_smss(&_tcb));
+    TEST_ASSERT_EQUAL_INT(UINT16_MAX, _tcb.cwnd);
+}
+
+static void test_cc_dup_ack__fast_recovery(void)
+{
+    uint32_t smss;
+
+    _cc_init(&_tcb);
+    smss = _cc_smss(&_tcb);
+    _tcb.snd_nxt = TEST_SND_UNA + 8 * smss;
+    for (unsigned i = 1; i < GNRC_TCP_DUP_ACK_THRESHOLD; i++) {
+        TEST_ASSERT(!_cc_dup_ack(&_tcb));
+        TEST_ASSERT_EQUAL_INT(4 * smss, _tcb.cwnd);
+    }
+    /* fast retransmit */
+    TEST_ASSERT(_cc_dup_ack(&_tcb));
+    TEST_ASSERT_EQUAL_INT(4 * smss, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT((4 + GNRC_TCP_DUP_ACK_THRESHOLD) * smss, _tcb.cwnd);
+    /* inflation */
+    TEST_ASSERT(!_cc_dup_ack(&_tcb));
+    TEST_ASSERT_EQUAL_INT((5 + GNRC_TCP_DUP_ACK_THRESHOLD) * smss, _tcb.cwnd);
+    /* deflation by the first ACK for new data */
+    _cc_ack(&_tcb, smss);
+    TEST_ASSERT_EQUAL_INT(4 * smss, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.dup_acks);
+}
+
+static void test_cc_timeout(void)
+{
+    uint32_t smss;
+
+    _cc_init(&_tcb);
+    smss = _cc_smss(&_tcb);
+    _tcb.snd_nxt = TEST_SND_UNA + 8 * smss;
+    _cc_timeout(&_tcb);
+    TEST_ASSERT_EQUAL_INT(4 * smss, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(smss, _tcb.cwnd);
+    /* a further timeout of the same segment keeps the threshold */
+    _tcb.retries = 1;
+    _tcb.snd_nxt = TEST_SND_UNA + 2 * smss;
+    _cc_timeout(&_tcb);
+    TEST_ASSERT_EQUAL_INT(4 * smss, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(smss, _tcb.cwnd);
+}
+
+static void test_rcv__in_order(void)
+{
+    _receive(0, 4);
+    _receive(4, 4);
+    TEST_ASSERT_EQUAL_INT(0, _ooo_len());
+    _check_received(8);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rcv__out_of_order(void)
+{
+    _receive(8, 4);
+    _receive(4, 4);
+    TEST_ASSERT_EQUAL_INT(2, _ooo_len());
+    TEST_ASSERT_EQUAL_INT(TEST_RCV_NXT, _tcb.rcv_nxt);
+    /* closing the gap moves all of them */
+    _receive(0, 4);
+    TEST_ASSERT_EQUAL_INT(0, _ooo_len());
+    _check_received(12);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rcv__overlap(void)
+{
+    _receive(2, 8);
+    _receive(0, 4);
+    TEST_ASSERT_EQUAL_INT(0, _ooo_len());
+    _check_received(10);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rcv__gap_remains(void)
+{
+    _receive(8, 4);
+    _receive(0, 4);
+    TEST_ASSERT_EQUAL_INT(1, _ooo_len());
+    _check_received(4);
+}
+
+static void test_rcv__duplicate(void)
+{
+    _receive(4, 4);
+    _receive(4, 4);
+    TEST_ASSERT_EQUAL_INT(1, _ooo_len());
+    _rcvbuf_ooo_clear(&_tcb);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rcv__full(void)
+{
+    for (unsigned i = 0; i < GNRC_TCP_RCV_OOO_QUEUE_SIZE; i++) {
+        _receive(2 + i, 1);
+    }
+    /* a segment needed later than all queued ones is dropped */
+    _receive(GNRC_TCP_RCV_OOO_QUEUE_SIZE + 3, 1);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_OOO_QUEUE_SIZE, _ooo_len());
+    /* a segment needed earlier replaces the one needed last */
+    _receive(1, 1);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_OOO_QUEUE_SIZE, _ooo_len());
+    _receive(0, 1);
+    /* everything in front of the replaced segment arrived */
+    _check_received(GNRC_TCP_RCV_OOO_QUEUE_SIZE + 1);
+    TEST_ASSERT_EQUAL_INT(0, _ooo_len());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_tcp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_cc_init),
+        new_TestFixture(test_cc_ack__slow_start),
+        new_TestFixture(test_cc_ack__congestion_avoidance),
+        new_TestFixture(test_cc_ack__limit),
+        new_TestFixture(test_cc_dup_ack__fast_recovery),
+        new_TestFixture(test_cc_timeout),
+        new_TestFixture(test_rcv__in_order),
+        new_TestFixture(test_rcv__out_of_order),
+        new_TestFixture(test_rcv__overlap),
+        new_TestFixture(test_rcv__gap_remains),
+        new_TestFixture(test_rcv__duplicate),
+        new_TestFixture(test_rcv__full),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_tcp_tests;
+}
+
+void tests_gnrc_tcp(void)
+{
+    TESTS_RUN(tests_gnrc_tcp_tests());
+}
+/** @} */
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,56 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* byte-wise reference implementation to cross-check the optimized one */
+static uint16_t _ref_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    for (uint16_t i = 0; i < len; i++, accum_len++) {
+        csum += (accum_len & 1) ? buf[i] : (uint16_t)(buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void test_inet_csum__offsets_and_lengths(void)
+{
+    static uint8_t data[300];
+    uint32_t state = 0x1234567;
+
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        state = state * 1103515245 + 12345;
+        data[i] = state >> 16;
+    }
+
+    /* covers unaligned start addresses, odd lengths and all paths for the
+     * remaining bytes after the word (or vector) loop */
+    for (unsigned offset = 0; offset < 8; offset++) {
+        for (unsigned len = 0; len <= (sizeof(data) - offset); len++) {
+            for (unsigned accum_len = 0; accum_len < 2; accum_len++) {
+                uint16_t sum = (uint16_t)(len * 0x0101);
+                TEST_ASSERT_EQUAL_INT(_ref_csum_slice(sum, data + offset, len, accum_len),
+                                      inet_csum_slice(sum, data + offset, len, accum_len));
+            }
+        }
+    }
+}
+
+static void test_inet_csum__all_ones(void)
+{
+    static uint8_t data[1280];
+
+    /* worst case for carries: all bits set */
+    memset(data, 0xff, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(_ref_csum_slice(0xffff, data, sizeof(data), 0),
+                          inet_csum_slice(0xffff, data, sizeof(data), 0));
+    TEST_ASSERT_EQUAL_INT(_ref_csum_slice(0xfffe, data + 1, sizeof(data) - 1, 1),
+                          inet_csum_slice(0xfffe, data + 1, sizeof(data) - 1, 1));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +227,8 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__offsets_and_lengths),
+        new_TestFixture(test_inet_csum__all_ones),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stddef.h>
+
+#include "embUnit/embUnit.h"
+
+#include "kernel_defines.h"
+#include "mpscq.h"
+#include "tests-mpscq.h"
+
+#define TEST_FLAG           (0x1)
+#define TEST_NUMOF          (8U)
+
+typedef struct {
+    unsigned value;
+    mpscq_node_t node;
+} record_t;
+
+static record_t _records[TEST_NUMOF];
+static mpscq_t _q;
+
+static void set_up(void)
+{
+    mpscq_init(&_q, TEST_FLAG);
+    for (unsigned i = 0; i < TEST_NUMOF; i++) {
+        _records[i].value = i;
+    }
+}
+
+static unsigned _value(mpscq_node_t *node)
+{
+    return container_of(node, record_t, node)->value;
+}
+
+static void test_empty(void)
+{
+    TEST_ASSERT_NULL(mpscq_get(&_q));
+}
+
+static void test_fifo(void)
+{
+    for (unsigned i = 0; i < TEST_NUMOF; i++) {
+        mpscq_put(&_q, &_records[i].node);
+    }
+    for (unsigned i = 0; i < TEST_NUMOF; i++) {
+        mpscq_node_t *node = mpscq_get(&_q);
+        TEST_ASSERT_NOT_NULL(node);
+        TEST_ASSERT_EQUAL_INT(i, _value(node));
+    }
+    TEST_ASSERT_NULL(mpscq_get(&_q));
+}
+
+static void test_interleaved(void)
+{
+    /* records put while the consumer has some taken already come after
+     * those */
+    mpscq_put(&_q, &_records[0].node);
+    mpscq_put(&_q, &_records[1].node);
+    TEST_ASSERT_EQUAL_INT(0, _value(mpscq_get(&_q)));
+    mpscq_put(&_q, &_records[2].node);
+    mpscq_put(&_q, &_records[3].node);
+    TEST_ASSERT_EQUAL_INT(1, _value(mpscq_get(&_q)));
+    TEST_ASSERT_EQUAL_INT(2, _value(mpscq_get(&_q)));
+    mpscq_put(&_q, &_records[0].node);
+    TEST_ASSERT_EQUAL_INT(3, _value(mpscq_get(&_q)));
+    TEST_ASSERT_EQUAL_INT(0, _value(mpscq_get(&_q)));
+    TEST_ASSERT_NULL(mpscq_get(&_q));
+}
+
+static Test *tests_mpscq_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_empty),
+        new_TestFixture(test_fifo),
+        new_TestFixture(test_interleaved),
+    };
+
+    EMB_UNIT_TESTCALLER(mpscq_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mpscq_tests;
+}
+
+void tests_mpscq(void)
+{
+    TESTS_RUN(tests_mpscq_tests());
+}
+/** @} */
@@ -645,6 +645,128 @@ static void test_nanocoap__options_get_opaque(void)
     TEST_ASSERT_EQUAL_INT(-ENOENT, optlen);
 }
 
+/*
+ * Helper for the path matching tests below, builds a GET request for @p path.
+ */
+static void _build_path_req(coap_pkt_t *pkt, uint8_t *buf, size_t buf_len,
+                            const char *path)
+{
+    size_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, NULL, 0,
+                                COAP_METHOD_GET, 1);
+
+    coap_pkt_init(pkt, buf, buf_len, len);
+    if (strcmp(path, "/")) {
+        coap_opt_add_string(pkt, COAP_OPT_URI_PATH, path, '/');
+    }
+    coap_opt_finish(pkt, COAP_OPT_FINISH_NONE);
+}
+
+static int _sign(int val)
+{
+    return (val > 0) - (val < 0);
+}
+
+/*
+ * Matching on the Uri-Path options must give the same result as matching on
+ * the copied URI path.
+ */
+static void test_nanocoap__match_path_pkt(void)
+{
+    static const coap_resource_t resources[] = {
+        { "/", COAP_GET, NULL, NULL },
+        { "/ab", COAP_GET, NULL, NULL },
+        { "/ab/", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/abc", COAP_GET, NULL, NULL },
+        { "/b", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/riot/value", COAP_GET, NULL, NULL },
+    };
+    static const char *paths[] = {
+        "/", "/a", "/ab", "/ab/", "/ab/c", "/abc", "/abcd", "/b", "/bc/d",
+        "/riot/value", "/riot/valu", "/riot/value/",
+    };
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(paths); i++) {
+        uint8_t uri[NANOCOAP_URI_MAX];
+
+        _build_path_req(&pkt, buf, sizeof(buf), paths[i]);
+        coap_get_uri_path(&pkt, uri);
+        TEST_ASSERT_EQUAL_STRING(paths[i], (char *)uri);
+        for (unsigned j = 0; j < ARRAY_SIZE(resources); j++) {
+            TEST_ASSERT_EQUAL_INT(_sign(coap_match_path(&resources[j], uri)),
+                                  _sign(coap_match_path_pkt(&resources[j], &pkt)));
+        }
+    }
+}
+
+#ifdef MODULE_NANOCOAP_RESOURCE_INDEX
+/*
+ * The resource index must find the resource a linear search finds first.
+ */
+static void test_nanocoap__resource_index(void)
+{
+    static const coap_resource_t first[] = {
+        { "/a", COAP_GET, NULL, NULL },
+        { "/a", COAP_POST, NULL, NULL },
+        { "/b/", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+    };
+    static const coap_resource_t second[] = {
+        { "/b/c", COAP_GET | COAP_PUT, NULL, NULL },
+        { "/d", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/de", COAP_GET, NULL, NULL },
+    };
+    static coap_resource_index_t index;
+    const coap_resource_index_entry_t *entry;
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+
+    coap_resource_index_init(&index);
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_add(&index, first,
+                                                     ARRAY_SIZE(first),
+                                                     (void *)first));
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_add(&index, second,
+                                                     ARRAY_SIZE(second),
+                                                     (void *)second));
+
+    _build_path_req(&pkt, buf, sizeof(buf), "/a");
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_find(&index, &pkt,
+                                                      COAP_POST, &entry));
+    TEST_ASSERT(entry->resource == &first[1]);
+    TEST_ASSERT(entry->owner == first);
+    TEST_ASSERT_EQUAL_INT(-EPERM, coap_resource_index_find(&index, &pkt,
+                                                           COAP_PUT, &entry));
+
+    /* earlier subtree resource takes precedence */
+    _build_path_req(&pkt, buf, sizeof(buf), "/b/c");
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_find(&index, &pkt,
+                                                      COAP_GET, &entry));
+    TEST_ASSERT(entry->resource == &first[2]);
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_find(&index, &pkt,
+                                                      COAP_PUT, &entry));
+    TEST_ASSERT(entry->resource == &second[0]);
+
+    _build_path_req(&pkt, buf, sizeof(buf), "/de");
+    TEST_ASSERT_EQUAL_INT(0, coap_resource_index_find(&index, &pkt,
+                                                      COAP_GET, &entry));
+    TEST_ASSERT(entry->resource == &second[1]);
+
+    _build_path_req(&pkt, buf, sizeof(buf), "/");
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_resource_index_find(&index, &pkt,
+                                                            COAP_GET, &entry));
+    _build_path_req(&pkt, buf, sizeof(buf), "/c");
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_resource_index_find(&index, &pkt,
+                                                            COAP_GET, &entry));
+
+    /* a full index is left unchanged */
+    TEST_ASSERT_EQUAL_INT(-ENOMEM,
+                          coap_resource_index_add(&index, first,
+                                                  NANOCOAP_RESOURCE_INDEX_SIZE,
+                                                  NULL));
+    TEST_ASSERT_EQUAL_INT(ARRAY_SIZE(first) + ARRAY_SIZE(second), index.numof);
+}
+#endif
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -667,6 +789,10 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__server_reply_simple_con),
         new_TestFixture(test_nanocoap__server_option_count_overflow_check),
         new_TestFixture(test_nanocoap__server_option_count_overflow),
+        new_TestFixture(test_nanocoap__match_path_pkt),
+#ifdef MODULE_NANOCOAP_RESOURCE_INDEX
+        new_TestFixture(test_nanocoap__resource_index),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
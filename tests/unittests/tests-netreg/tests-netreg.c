@@ -21,11 +21,15 @@
 #include "unittests-constants.h"
 #include "tests-netreg.h"
 
+#define TEST_SCALING_NUMOF      (24U)
+
 static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8),
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
 
+static gnrc_netreg_entry_t scaling_entries[TEST_SCALING_NUMOF];
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +143,37 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup__scaling(void)
+{
+    for (unsigned i = 0; i < TEST_SCALING_NUMOF; i++) {
+        gnrc_netreg_entry_init_pid(&scaling_entries[i], TEST_UINT16 + i,
+                                   TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &scaling_entries[i]));
+    }
+    for (unsigned i = 0; i < TEST_SCALING_NUMOF; i++) {
+        gnrc_netreg_entry_t *res;
+
+        TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                       TEST_UINT16 + i)));
+        TEST_ASSERT(res == &scaling_entries[i]);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    }
+    for (unsigned i = 0; i < TEST_SCALING_NUMOF; i += 2) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &scaling_entries[i]);
+    }
+    for (unsigned i = 0; i < TEST_SCALING_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      TEST_UINT16 + i);
+        if (i & 1) {
+            TEST_ASSERT(res == &scaling_entries[i]);
+        }
+        else {
+            TEST_ASSERT_NULL(res);
+        }
+    }
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +190,7 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup__scaling),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "spscq.h"
+#include "tests-spscq.h"
+
+#define BUFFER_SIZE         (64U)
+#define TEST_FLAG           (0x1)
+
+static uint32_t _buf[BUFFER_SIZE / sizeof(uint32_t)];
+static uint8_t _io[BUFFER_SIZE];
+static spscq_t _q;
+
+static void set_up(void)
+{
+    memset(_buf, 0, sizeof(_buf));
+    memset(_io, 0, sizeof(_io));
+    spscq_init(&_q, _buf, BUFFER_SIZE, TEST_FLAG);
+}
+
+static void test_empty(void)
+{
+    size_t len;
+
+    TEST_ASSERT_EQUAL_INT(1, spscq_empty(&_q));
+    TEST_ASSERT_NULL(spscq_peek(&_q, &len));
+    TEST_ASSERT_EQUAL_INT(-EAGAIN, spscq_get(&_q, _io, sizeof(_io)));
+}
+
+static void test_put_get(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, "", 0));
+    TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, "defgh", 5));
+    TEST_ASSERT_EQUAL_INT(0, spscq_empty(&_q));
+
+    TEST_ASSERT_EQUAL_INT(3, spscq_get(&_q, _io, sizeof(_io)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_io, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(0, spscq_get(&_q, _io, sizeof(_io)));
+    /* a record that doesn't fit stays in the queue */
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, spscq_get(&_q, _io, 4));
+    TEST_ASSERT_EQUAL_INT(5, spscq_get(&_q, _io, sizeof(_io)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_io, "defgh", 5));
+    TEST_ASSERT_EQUAL_INT(1, spscq_empty(&_q));
+}
+
+static void test_full(void)
+{
+    unsigned num = BUFFER_SIZE / SPSCQ_RECORD_SIZE(12);
+
+    for (unsigned i = 0; i < num; i++) {
+        memset(_io, i, 12);
+        TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, _io, 12));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, spscq_put(&_q, _io, 1));
+    TEST_ASSERT_NULL(spscq_reserve(&_q, BUFFER_SIZE));
+
+    for (unsigned i = 0; i < num; i++) {
+        TEST_ASSERT_EQUAL_INT(12, spscq_get(&_q, _io, sizeof(_io)));
+        TEST_ASSERT_EQUAL_INT(i, _io[11]);
+    }
+    TEST_ASSERT_EQUAL_INT(1, spscq_empty(&_q));
+}
+
+static void test_reserve_commit(void)
+{
+    size_t len;
+    uint8_t *rec = spscq_reserve(&_q, 20);
+
+    TEST_ASSERT_NOT_NULL(rec);
+    /* not visible before the commit */
+    TEST_ASSERT_EQUAL_INT(1, spscq_empty(&_q));
+    memcpy(rec, "0123456789", 10);
+    spscq_commit(&_q, 10);
+
+    uint8_t *data = spscq_peek(&_q, &len);
+    TEST_ASSERT(data == rec);
+    TEST_ASSERT_EQUAL_INT(10, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, "0123456789", 10));
+    spscq_release(&_q);
+    TEST_ASSERT_EQUAL_INT(1, spscq_empty(&_q));
+}
+
+static void test_wrap_around(void)
+{
+    size_t len;
+
+    /* move the positions past the middle of the buffer */
+    TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, _io, 36));
+    TEST_ASSERT_EQUAL_INT(36, spscq_get(&_q, _io, sizeof(_io)));
+
+    /* 24 bytes are left before the end, so this record goes to the start */
+    memset(_io, 0xab, 28);
+    TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, _io, 28));
+    uint8_t *data = spscq_peek(&_q, &len);
+    TEST_ASSERT(data == (uint8_t *)_buf + SPSCQ_HDR_SIZE);
+    TEST_ASSERT_EQUAL_INT(28, len);
+    TEST_ASSERT_EQUAL_INT(0xab, data[27]);
+    spscq_release(&_q);
+    TEST_ASSERT_EQUAL_INT(1, spscq_empty(&_q));
+
+    /* all positions go around many times */
+    for (unsigned i = 0; i < 100; i++) {
+        memset(_io, i, i % 24);
+        TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, _io, i % 24));
+        TEST_ASSERT_EQUAL_INT(i % 24, spscq_get(&_q, _io, sizeof(_io)));
+        if (i % 24) {
+            TEST_ASSERT_EQUAL_INT(i & 0xff, _io[(i % 24) - 1]);
+        }
+    }
+}
+
+static Test *tests_spscq_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_empty),
+        new_TestFixture(test_put_get),
+        new_TestFixture(test_full),
+        new_TestFixture(test_reserve_commit),
+        new_TestFixture(test_wrap_around),
+    };
+
+    EMB_UNIT_TESTCALLER(spscq_tests, set_up, NULL, fixtures);
+
+    return (Test *)&spscq_tests;
+}
+
+void tests_spscq(void)
+{
+    TESTS_RUN(tests_spscq_tests());
+}
+/** @} */
@@ -162,6 +162,63 @@ static void test_add(void)
     }
 }
 
+static void test_add_get_wrap_around(void)
+{
+    for (int i = 0; i < (int)sizeof(_io_buffer); i++) {
+        _io_buffer[i] = TEST_INPUT + i;
+    }
+    /* move read and write position close to the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 3, tsrb_add(&_tsrb, _io_buffer,
+                                                    BUFFER_SIZE - 3));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 3, tsrb_drop(&_tsrb, BUFFER_SIZE));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_add(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_full(&_tsrb));
+    memset(_io_buffer, IO_BUFFER_CANARY, sizeof(_io_buffer));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_get(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT((uint8_t)(TEST_INPUT + i), _io_buffer[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(IO_BUFFER_CANARY, _io_buffer[BUFFER_SIZE]);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_tsrb));
+}
+
+static void test_contig(void)
+{
+    uint8_t *data;
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_get_contig(&_tsrb, &data));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_add_contig(&_tsrb, &data));
+    TEST_ASSERT(data == _tsrb_buffer);
+    for (int i = 0; i < BUFFER_SIZE - 3; i++) {
+        data[i] = TEST_INPUT + i;
+    }
+    tsrb_add_commit(&_tsrb, BUFFER_SIZE - 3);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 3, tsrb_avail(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 3, tsrb_get_contig(&_tsrb, &data));
+    TEST_ASSERT(data == _tsrb_buffer);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 3, tsrb_drop(&_tsrb, BUFFER_SIZE));
+
+    /* free space wraps around, only the part up to the end is returned */
+    TEST_ASSERT_EQUAL_INT(3, tsrb_add_contig(&_tsrb, &data));
+    TEST_ASSERT(data == &_tsrb_buffer[BUFFER_SIZE - 3]);
+    memset(data, TEST_INPUT, 3);
+    tsrb_add_commit(&_tsrb, 3);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 3, tsrb_add_contig(&_tsrb, &data));
+    TEST_ASSERT(data == _tsrb_buffer);
+    memset(data, TEST_INPUT + 1, 2);
+    tsrb_add_commit(&_tsrb, 2);
+    TEST_ASSERT_EQUAL_INT(5, tsrb_avail(&_tsrb));
+
+    TEST_ASSERT_EQUAL_INT(3, tsrb_get_contig(&_tsrb, &data));
+    TEST_ASSERT(data == &_tsrb_buffer[BUFFER_SIZE - 3]);
+    TEST_ASSERT_EQUAL_INT(3, tsrb_drop(&_tsrb, 3));
+    TEST_ASSERT_EQUAL_INT(2, tsrb_get_contig(&_tsrb, &data));
+    TEST_ASSERT(data == _tsrb_buffer);
+    TEST_ASSERT_EQUAL_INT(TEST_INPUT + 1, data[0]);
+}
+
 static Test *tests_tsrb_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -174,6 +231,8 @@ static Test *tests_tsrb_tests(void)
         new_TestFixture(test_drop),
         new_TestFixture(test_add_one),
         new_TestFixture(test_add),
+        new_TestFixture(test_add_get_wrap_around),
+        new_TestFixture(test_contig),
     };
 
     EMB_UNIT_TESTCALLER(tsrb_tests, NULL, tear_down, fixtures);
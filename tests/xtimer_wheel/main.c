@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for the xtimer timer wheel backend
+ *
+ * Sets timers into one slot, across the wrap-around of every level and
+ * beyond the span of the wheel and checks that all of them fire, in order
+ * and not early.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#define TIMERS_NUMOF    (64U)
+/* ticks to wait after the last target for all callbacks to run */
+#define SETTLE_TICKS    (10000U)
+
+typedef uint32_t (*offset_func_t)(unsigned idx);
+
+static xtimer_t _timers[TIMERS_NUMOF];
+static uint32_t _targets[TIMERS_NUMOF];
+static uint8_t _order[TIMERS_NUMOF];
+static volatile unsigned _fired;
+static volatile unsigned _early;
+
+static void _cb(void *arg)
+{
+    unsigned idx = (uintptr_t)arg;
+
+    /* xtimer runs callbacks XTIMER_OVERHEAD ticks ahead of the target */
+    if ((int32_t)(_xtimer_now() - (_targets[idx] - XTIMER_OVERHEAD)) < 0) {
+        _early++;
+    }
+    _order[_fired++] = idx;
+}
+
+static uint32_t _one_slot(unsigned idx)
+{
+    (void)idx;
+    return 3000;
+}
+
+static uint32_t _wrap_around(unsigned idx)
+{
+    /* 500 to 4343 ticks, crossing slot boundaries of all three levels */
+    return 500 + (idx * 61);
+}
+
+static uint32_t _far(unsigned idx)
+{
+    /* up to about 14 spans of the wheel */
+    return 5000 + ((idx % 32) * 1531) + (idx / 32);
+}
+
+static uint32_t _shuffled(unsigned idx)
+{
+    return 1000 + ((idx * 37) % 3000);
+}
+
+static int _run(const char *name, offset_func_t offset, unsigned remove_every)
+{
+    uint32_t base = _xtimer_now();
+    uint32_t last = 0;
+    unsigned expected = 0;
+    int res = 0;
+
+    _fired = 0;
+    _early = 0;
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        uint32_t off = offset(i);
+
+        _timers[i].callback = _cb;
+        _timers[i].arg = (void *)(uintptr_t)i;
+        _targets[i] = base + off;
+        if (off > last) {
+            last = off;
+        }
+        _xtimer_set_absolute(&_timers[i], _targets[i]);
+    }
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        if (remove_every && ((i % remove_every) == 0)) {
+            xtimer_remove(&_timers[i]);
+        }
+        else {
+            expected++;
+        }
+    }
+
+    xtimer_tsleep32(xtimer_ticks(last + SETTLE_TICKS));
+
+    if (_fired != expected) {
+        printf("%s: %u of %u timers fired\n", name, _fired, expected);
+        res = -1;
+    }
+    if (_early) {
+        printf("%s: %u timers fired early\n", name, _early);
+        res = -1;
+    }
+    for (unsigned i = 0; i < _fired; i++) {
+        unsigned idx = _order[i];
+
+        if (remove_every && ((idx % remove_every) == 0)) {
+            printf("%s: removed timer %u fired\n", name, idx);
+            res = -1;
+        }
+        if ((i > 0) &&
+            ((int32_t)(_targets[idx] - _targets[_order[i - 1]]) < 0)) {
+            printf("%s: timer %u fired before timer %u\n", name,
+                   _order[i - 1], idx);
+            res = -1;
+        }
+    }
+    printf("%s: %s\n", name, res ? "failed" : "ok");
+    return res;
+}
+
+int main(void)
+{
+    int res = 0;
+
+    puts("xtimer_wheel test application.");
+
+    res |= _run("one slot", _one_slot, 0);
+    res |= _run("wrap-around", _wrap_around, 0);
+    res |= _run("beyond the wheel", _far, 0);
+    res |= _run("remove", _shuffled, 3);
+
+    puts(res ? "[FAILED]" : "[SUCCESS]");
+
+    return 0;
+}